@@ -29,6 +29,7 @@
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <3d_rendering/raytracing/shapes2D/polygon_2d.h>
 #include <board.h>
+#include <pcb_group.h>
 #include <dialogs/dialog_color_picker.h>
 #include <3d_math.h>
 #include "3d_fastmath.h"
@@ -78,6 +79,88 @@ static bool          g_ColorsLoaded = false;
 const wxChar *BOARD_ADAPTER::m_logTrace = wxT( "KI_TRACE_EDA_CINFO3D_VISU" );
 
 
+void BOARD_3D_CHANGES::AddItem( const BOARD_ITEM* aItem )
+{
+    if( !aItem )
+        return;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_SHAPE_T:
+    case PCB_TEXT_T:
+    case PCB_TEXTBOX_T:
+    case PCB_FP_TEXT_T:
+    case PCB_FP_TEXTBOX_T:
+    case PCB_FP_SHAPE_T:
+    case PCB_DIM_ALIGNED_T:
+    case PCB_DIM_LEADER_T:
+    case PCB_DIM_CENTER_T:
+    case PCB_DIM_RADIAL_T:
+    case PCB_DIM_ORTHOGONAL_T:
+    case PCB_FP_DIM_ALIGNED_T:
+    case PCB_FP_DIM_LEADER_T:
+    case PCB_FP_DIM_CENTER_T:
+    case PCB_FP_DIM_RADIAL_T:
+    case PCB_FP_DIM_ORTHOGONAL_T:
+    case PCB_ZONE_T:
+    case PCB_FP_ZONE_T:
+        m_Items.insert( aItem );
+        m_Layers |= aItem->GetLayerSet();
+
+        // The board outline is built from these
+        if( aItem->IsOnLayer( Edge_Cuts ) )
+            m_RebuildAll = true;
+
+        break;
+
+    case PCB_GROUP_T:
+        static_cast<const PCB_GROUP*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    AddItem( aChild );
+                } );
+        break;
+
+    case PCB_FOOTPRINT_T:
+        m_FootprintsChanged = true;
+        m_RebuildAll = true;
+        break;
+
+    // Not shown in the 3D view
+    case PCB_MARKER_T:
+    case PCB_NETINFO_T:
+        break;
+
+    // Vias and pads have holes, which are drilled through all the layers
+    case PCB_VIA_T:
+    case PCB_PAD_T:
+    default:
+        m_RebuildAll = true;
+        break;
+    }
+}
+
+
+void BOARD_3D_CHANGES::Merge( const BOARD_3D_CHANGES& aOther )
+{
+    m_Items.insert( aOther.m_Items.begin(), aOther.m_Items.end() );
+    m_Layers |= aOther.m_Layers;
+    m_RebuildAll |= aOther.m_RebuildAll;
+    m_FootprintsChanged |= aOther.m_FootprintsChanged;
+}
+
+
+void BOARD_3D_CHANGES::Clear()
+{
+    m_Items.clear();
+    m_Layers.reset();
+    m_RebuildAll = false;
+    m_FootprintsChanged = false;
+}
+
+
 BOARD_ADAPTER::BOARD_ADAPTER() :
         m_Cfg( nullptr ),
         m_IsBoardView( true ),
@@ -97,6 +180,7 @@ BOARD_ADAPTER::BOARD_ADAPTER() :
 
     m_boardPos = VECTOR2I();
     m_boardSize = VECTOR2I();
+    m_haveOutline = false;
     m_boardCenter = SFVEC3F( 0.0f );
 
     m_boardBoundingBox.Reset();
@@ -313,28 +397,17 @@ void BOARD_ADAPTER::InitSettings( REPORTER* aStatusReporter, REPORTER* aWarningR
 
     wxString msg;
 
-    const bool haveOutline = createBoardPolygon( &msg );
+    m_haveOutline = createBoardPolygon( &msg );
 
     if( aWarningReporter )
     {
-        if( !haveOutline )
+        if( !m_haveOutline )
             aWarningReporter->Report( msg, RPT_SEVERITY_WARNING );
         else
             aWarningReporter->Report( wxEmptyString );
     }
 
-    BOX2I bbbox;
-
-    if( m_board )
-    {
-        bbbox = m_board->ComputeBoundingBox( !m_board->IsFootprintHolder()
-                                                 && m_Cfg->m_Render.realistic
-                                                 && haveOutline );
-    }
-
-    // Gives a non null size to avoid issues in zoom / scale calculations
-    if( ( bbbox.GetWidth() == 0 ) && ( bbbox.GetHeight() == 0 ) )
-        bbbox.Inflate( pcbIUScale.mmToIU( 10 ) );
+    BOX2I bbbox = computeBoardBBox();
 
     m_boardSize = bbbox.GetSize();
     m_boardPos  = bbbox.Centre();
@@ -651,6 +724,81 @@ extern bool BuildFootprintPolygonOutlines( BOARD* aBoard, SHAPE_POLY_SET& aOutli
                                            OUTLINE_ERROR_HANDLER* aErrorHandler = nullptr );
 
 
+bool BOARD_ADAPTER::UpdateLayers( const BOARD_3D_CHANGES& aChanges, REPORTER* aStatusReporter,
+                                  LSET& aUpdatedLayers )
+{
+    aUpdatedLayers.reset();
+
+    // The board outline of a footprint holder is built from the footprint itself
+    if( !m_board || m_board->IsFootprintHolder() || aChanges.m_RebuildAll )
+        return false;
+
+    unsigned int copperLayersCount = std::max( m_board->GetCopperLayerCount(), 2 );
+
+    if( copperLayersCount != m_copperLayersCount )
+        return false;
+
+    // All the 3D coordinates are scaled from the board size
+    BOX2I bbbox = computeBoardBBox();
+
+    if( bbbox.GetSize() != m_boardSize
+            || bbbox.Centre() != VECTOR2I( m_boardPos.x, -m_boardPos.y ) )
+    {
+        return false;
+    }
+
+    LSET layers = aChanges.m_Layers;
+
+    // Find the layers the changed items were on before the change
+    for( const std::pair<const PCB_LAYER_ID, BVH_CONTAINER_2D*>& entry : m_layerMap )
+    {
+        if( layers.Contains( entry.first ) )
+            continue;
+
+        for( const OBJECT_2D* object : entry.second->GetList() )
+        {
+            if( aChanges.m_Items.count( &object->GetBoardItem() ) )
+            {
+                layers.set( entry.first );
+                break;
+            }
+        }
+    }
+
+    if( layers.Contains( Edge_Cuts ) )
+        return false;
+
+    wxLogTrace( m_logTrace, wxT( "BOARD_ADAPTER::UpdateLayers: %d items, %d layers" ),
+                (int) aChanges.m_Items.size(), (int) layers.count() );
+
+    if( layers.any() )
+        createLayers( aStatusReporter, &layers );
+
+    aUpdatedLayers = layers;
+
+    return true;
+}
+
+
+BOX2I BOARD_ADAPTER::computeBoardBBox() const
+{
+    BOX2I bbbox;
+
+    if( m_board )
+    {
+        bbbox = m_board->ComputeBoundingBox( !m_board->IsFootprintHolder()
+                                                 && m_Cfg->m_Render.realistic
+                                                 && m_haveOutline );
+    }
+
+    // Gives a non null size to avoid issues in zoom / scale calculations
+    if( ( bbbox.GetWidth() == 0 ) && ( bbbox.GetHeight() == 0 ) )
+        bbbox.Inflate( pcbIUScale.mmToIU( 10 ) );
+
+    return bbbox;
+}
+
+
 bool BOARD_ADAPTER::createBoardPolygon( wxString* aErrorMsg )
 {
     m_board_poly.RemoveAllContours();
@@ -26,6 +26,7 @@
 #define BOARD_ADAPTER_H
 
 #include <array>
+#include <unordered_set>
 #include <vector>
 #include "../3d_rendering/raytracing/accelerators/container_2d.h"
 #include "../3d_rendering/raytracing/accelerators/container_3d.h"
@@ -62,6 +63,49 @@ typedef std::map<PCB_LAYER_ID, SHAPE_POLY_SET*> MAP_POLY;
 #define RANGE_SCALE_3D 8.0f
 
 
+/**
+ * The board items changed since the 3D scene was built.
+ *
+ * Collected from the board change notifications so the 3D view can rebuild only the layers
+ * touched by the changes instead of the whole board.
+ */
+struct BOARD_3D_CHANGES
+{
+    BOARD_3D_CHANGES() :
+            m_RebuildAll( false ),
+            m_FootprintsChanged( false )
+    {}
+
+    /**
+     * Record a changed, added or removed item.
+     *
+     * Must be called while the item is still valid: its layers are read here.
+     */
+    void AddItem( const BOARD_ITEM* aItem );
+
+    void Merge( const BOARD_3D_CHANGES& aOther );
+
+    void Clear();
+
+    bool HasChanges() const
+    {
+        return m_RebuildAll || m_FootprintsChanged || !m_Items.empty();
+    }
+
+    /// Changed items.  Removed items may be deleted, they are only compared, never dereferenced.
+    std::unordered_set<const BOARD_ITEM*> m_Items;
+
+    /// Layers the changed items are on after the change.
+    LSET m_Layers;
+
+    /// Holes, the board outline or an item not handled incrementally changed.
+    bool m_RebuildAll;
+
+    /// Footprints were added, removed or changed: their 3D models may have to be loaded.
+    bool m_FootprintsChanged;
+};
+
+
 /**
  *  Helper class to handle information needed to display 3D board.
  */
@@ -110,6 +154,21 @@ public:
      */
     void InitSettings( REPORTER* aStatusReporter, REPORTER* aWarningReporter );
 
+    /**
+     * Rebuild only the layers touched by some board changes.
+     *
+     * The layers the changed items were on before the change are found from the owners of the
+     * current 2D objects.  Holes, plated pads and the board outline are kept as they are.
+     *
+     * @param aChanges the changes since the last build.
+     * @param aStatusReporter the pointer for the status reporter.
+     * @param aUpdatedLayers will receive the layers that were rebuilt.
+     * @return false if the changes cannot be applied this way (holes or board outline changed,
+     *         board size changed...).  InitSettings() must then be called instead.
+     */
+    bool UpdateLayers( const BOARD_3D_CHANGES& aChanges, REPORTER* aStatusReporter,
+                       LSET& aUpdatedLayers );
+
     /**
      * Board integer units To 3D units.
      *
@@ -330,8 +389,21 @@ private:
      * @return false if the outline could not be created
      */
     bool createBoardPolygon( wxString* aErrorMsg );
-    void createLayers( REPORTER* aStatusReporter );
+
+    /**
+     * Build the 2D objects and polygons of the layers.
+     *
+     * @param aLayers if not null, only these layers are built, replacing their current content;
+     *                holes and plated pads are kept.  Otherwise everything is built again.
+     */
+    void createLayers( REPORTER* aStatusReporter, const LSET* aLayers = nullptr );
     void destroyLayers();
+    void destroyLayers( const LSET& aLayers );
+
+    /**
+     * @return the board bounding box used to scale the 3D coordinates.
+     */
+    BOX2I computeBoardBBox() const;
 
     // Helper functions to create the board
     void createTrack( const PCB_TRACK* aTrack, CONTAINER_2D_BASE* aDstContainer );
@@ -413,6 +485,7 @@ private:
 
     VECTOR2I          m_boardPos;           ///< Board center position in board internal units.
     VECTOR2I          m_boardSize;          ///< Board size in board internal units.
+    bool              m_haveOutline;        ///< The board outline polygon could be built.
     SFVEC3F           m_boardCenter;        ///< 3D center position of the board in 3D units.
     BBOX_3D           m_boardBoundingBox;   ///< 3D bounding box of the board in 3D units.
 
@@ -43,15 +43,37 @@
 #include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
 #include <vector>
-#include <thread>
 #include <core/arraydim.h>
 #include <algorithm>
 #include <atomic>
+#include <functional>
+#include <future>
+#include <profile.h>
+#include <thread_pool.h>
 #include <wx/log.h>
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-#include <profile.h>
-#endif
+
+void BOARD_ADAPTER::destroyLayers( const LSET& aLayers )
+{
+    for( PCB_LAYER_ID layer : aLayers.Seq() )
+    {
+        auto poly = m_layers_poly.find( layer );
+
+        if( poly != m_layers_poly.end() )
+        {
+            delete poly->second;
+            m_layers_poly.erase( poly );
+        }
+
+        auto container = m_layerMap.find( layer );
+
+        if( container != m_layerMap.end() )
+        {
+            delete container->second;
+            m_layerMap.erase( container );
+        }
+    }
+}
 
 
 void BOARD_ADAPTER::destroyLayers()
@@ -121,19 +143,80 @@ void BOARD_ADAPTER::destroyLayers()
 }
 
 
-void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
+namespace
+{
+
+/**
+ * The objects and polygons built by one task of createLayers() for a copper layer.  They are
+ * moved to the layer containers once all the tasks are done, so tasks never share a container.
+ */
+struct LAYER_BUFFER
+{
+    LAYER_BUFFER( PCB_LAYER_ID aLayer ) :
+            m_layer( aLayer )
+    {}
+
+    PCB_LAYER_ID   m_layer;
+    CONTAINER_2D   m_objects;
+    SHAPE_POLY_SET m_poly;
+};
+
+
+/**
+ * Kinds of createLayers() tasks, used for the timing breakdown.
+ */
+enum LAYER_TASK_KIND
+{
+    TASK_COPPER = 0,
+    TASK_ZONES,
+    TASK_HOLES,
+    TASK_PLATED_PADS,
+    TASK_TECH,
+    TASK_KIND_COUNT
+};
+
+} // namespace
+
+
+/**
+ * Run \a aTasks on the thread pool and wait for all of them to finish.
+ */
+static void runOnThreadPool( const std::vector<std::function<void()>>& aTasks )
 {
-    destroyLayers();
+    thread_pool&                     tp = GetKiCadThreadPool();
+    std::vector<std::future<size_t>> returns;
+
+    returns.reserve( aTasks.size() );
+
+    for( const std::function<void()>& task : aTasks )
+    {
+        returns.emplace_back( tp.submit( [&task]() -> size_t
+                                         {
+                                             task();
+                                             return 1;
+                                         } ) );
+    }
+
+    for( std::future<size_t>& ret : returns )
+        ret.wait();
+}
+
+
+void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter, const LSET* aLayers )
+{
+    // When only some layers are built, holes and plated pads are kept
+    const bool fullBuild = ( aLayers == nullptr );
+
+    if( fullBuild )
+        destroyLayers();
+    else
+        destroyLayers( *aLayers );
 
     // Build Copper layers
     // Based on:
     //    https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L692
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_startCopperLayersTime = GetRunningMicroSecs();
-
-    unsigned start_Time = stats_startCopperLayersTime;
-#endif
+    PROF_TIMER phaseTimer;
 
     PCB_LAYER_ID cu_seq[MAX_CU_LAYERS];
     LSET         cu_set = LSET::AllCuMask( m_copperLayersCount );
@@ -184,8 +267,35 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( m_viaCount )
         m_averageViaHoleDiameter /= (float)m_viaCount;
 
+    // Hole statistics of footprints
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( !pad->GetDrillSize().x )    // Not drilled pad like SMD pad
+                continue;
+
+            m_holeCount++;
+            m_averageHoleDiameter += ( ( pad->GetDrillSize().x +
+                                             pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
+        }
+    }
+
+    if( m_holeCount )
+        m_averageHoleDiameter /= (float)m_holeCount;
+
+    const bool buildCopperPolys = m_Cfg->m_Render.opengl_copper_thickness
+                                        && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL;
+
+    const bool renderPlatedPadsAsPlated = m_Cfg->m_Render.renderPlatedPadsAsPlated
+                                                && m_Cfg->m_Render.realistic;
+
+    const bool clipSilkOnViaAnnulus = m_Cfg->m_Render.clip_silk_on_via_annulus
+                                                && m_Cfg->m_Render.realistic;
+
     // Prepare copper layers index and containers
     std::vector<PCB_LAYER_ID> layer_ids;
+    LSET                      enabledCopperLayers;
     layer_ids.clear();
     layer_ids.reserve( m_copperLayersCount );
 
@@ -199,20 +309,23 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         if( !Is3dLayerEnabled( layer ) ) // Skip non enabled layers
             continue;
 
+        if( !fullBuild && !aLayers->Contains( layer ) )
+            continue;
+
         layer_ids.push_back( layer );
+        enabledCopperLayers.set( layer );
 
         BVH_CONTAINER_2D *layerContainer = new BVH_CONTAINER_2D;
         m_layerMap[layer] = layerContainer;
 
-        if( m_Cfg->m_Render.opengl_copper_thickness
-                && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL )
+        if( buildCopperPolys )
         {
             SHAPE_POLY_SET* layerPoly    = new SHAPE_POLY_SET;
             m_layers_poly[layer] = layerPoly;
         }
     }
 
-    if( m_Cfg->m_Render.renderPlatedPadsAsPlated && m_Cfg->m_Render.realistic )
+    if( renderPlatedPadsAsPlated && fullBuild )
     {
         m_frontPlatedPadPolys = new SHAPE_POLY_SET;
         m_backPlatedPadPolys = new SHAPE_POLY_SET;
@@ -222,856 +335,695 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
 
     }
 
-    if( aStatusReporter )
-        aStatusReporter->Report( _( "Create tracks and vias" ) );
-
-    // Create tracks as objects and add it to container
-    for( PCB_LAYER_ID layer : layer_ids )
+    // Holes of blind and buried vias are stored per layer, for the layers having such vias
+    if( fullBuild )
     {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
-
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
-
         for( const PCB_TRACK* track : trackList )
         {
-            // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( layer ) )
-                continue;
-
-            // Skip vias annulus when not connected on this layer (if removing is enabled)
-            const PCB_VIA *via = dyn_cast< const PCB_VIA*>( track );
-
-            if( via && IsCopperLayer( layer ) && !via->FlashLayer( layer )  )
+            if( track->Type() != PCB_VIA_T
+                    || static_cast<const PCB_VIA*>( track )->GetViaType() == VIATYPE::THROUGH )
+            {
                 continue;
+            }
 
-            // Add object item to layer container
-            createTrack( track, layerContainer );
+            for( PCB_LAYER_ID layer : layer_ids )
+            {
+                if( track->IsOnLayer( layer )
+                        && m_layerHoleMap.find( layer ) == m_layerHoleMap.end() )
+                {
+                    m_layerHoleMap[layer] = new BVH_CONTAINER_2D;
+                    m_layerHoleOdPolys[layer] = new SHAPE_POLY_SET;
+                    m_layerHoleIdPolys[layer] = new SHAPE_POLY_SET;
+                }
+            }
         }
     }
 
-    // Create VIAS and THTs objects and add it to holes containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        // ADD TRACKS
-        unsigned int nTracks = trackList.size();
-
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-        {
-            const PCB_TRACK *track = trackList[trackIdx];
-
-            if( !track->IsOnLayer( layer ) )
-                continue;
+    // Build Tech layers containers
+    // Based on:
+    //    https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L1059
 
-            // ADD VIAS and THT
-            if( track->Type() == PCB_VIA_T )
-            {
-                const PCB_VIA* via               = static_cast<const PCB_VIA*>( track );
-                const VIATYPE  viatype           = via->GetViaType();
-                const float    holediameter      = via->GetDrillValue() * BiuTo3dUnits();
+    // Vertical walls (layer thickness) around shapes is really time consumming
+    // They are built on request
+    bool buildVerticalWallsForTechLayers = m_Cfg->m_Render.opengl_copper_thickness
+                                              && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL;
 
-                // holes and layer copper extend half info cylinder wall to hide transition
-                const float    thickness         = GetHolePlatingThickness() * BiuTo3dUnits() / 2.0f;
-                const float    hole_inner_radius = holediameter / 2.0f;
-                const float    ring_radius       = via->GetWidth() * BiuTo3dUnits() / 2.0f;
+    static const PCB_LAYER_ID techLayerList[] = {
+            B_Adhes,
+            F_Adhes,
+            B_Paste,
+            F_Paste,
+            B_SilkS,
+            F_SilkS,
+            B_Mask,
+            F_Mask,
 
-                const SFVEC2F via_center( via->GetStart().x * m_biuTo3Dunits,
-                                          -via->GetStart().y * m_biuTo3Dunits );
+            // Aux Layers
+            Dwgs_User,
+            Cmts_User,
+            Eco1_User,
+            Eco2_User,
+            Edge_Cuts,
+            Margin
+        };
 
-                if( viatype != VIATYPE::THROUGH )
-                {
+    std::vector<PCB_LAYER_ID> techLayers;
 
-                    // Add hole objects
-                    BVH_CONTAINER_2D *layerHoleContainer = nullptr;
+    // User layers are not drawn here, only technical layers
+    for( LSEQ seq = LSET::AllNonCuMask().Seq( techLayerList, arrayDim( techLayerList ) );
+         seq;
+         ++seq )
+    {
+        const PCB_LAYER_ID layer = *seq;
 
-                    // Check if the layer is already created
-                    if( m_layerHoleMap.find( layer ) == m_layerHoleMap.end() )
-                    {
-                        // not found, create a new container
-                        layerHoleContainer = new BVH_CONTAINER_2D;
-                        m_layerHoleMap[layer] = layerHoleContainer;
-                    }
-                    else
-                    {
-                        // found
-                        layerHoleContainer = m_layerHoleMap[layer];
-                    }
+        if( !Is3dLayerEnabled( layer ) )
+            continue;
 
-                    // Add a hole for this layer
-                    layerHoleContainer->Add( new FILLED_CIRCLE_2D( via_center,
-                                                                   hole_inner_radius + thickness,
-                                                                   *track ) );
-                }
-                else if( layer == layer_ids[0] ) // it only adds once the THT holes
-                {
-                    // Add through hole object
-                    m_throughHoleOds.Add( new FILLED_CIRCLE_2D( via_center,
-                                                                hole_inner_radius + thickness,
-                                                                *track ) );
-                    m_throughHoleViaOds.Add( new FILLED_CIRCLE_2D( via_center,
-                                                                   hole_inner_radius + thickness,
-                                                                   *track ) );
-
-                    if( m_Cfg->m_Render.clip_silk_on_via_annulus && m_Cfg->m_Render.realistic )
-                    {
-                        m_throughHoleAnnularRings.Add( new FILLED_CIRCLE_2D( via_center,
-                                                                             ring_radius,
-                                                                             *track ) );
-                    }
+        if( !fullBuild && !aLayers->Contains( layer ) )
+            continue;
 
-                    m_throughHoleIds.Add( new FILLED_CIRCLE_2D( via_center, hole_inner_radius,
-                                                                *track ) );
-                }
-            }
-        }
+        techLayers.push_back( layer );
+        m_layerMap[layer] = new BVH_CONTAINER_2D;
+        m_layers_poly[layer] = new SHAPE_POLY_SET;
     }
 
-    // Create VIAS and THTs objects and add it to holes containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        // ADD TRACKS
-        const unsigned int nTracks = trackList.size();
+    double prepareTime = phaseTimer.msecs( true );
 
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-        {
-            const PCB_TRACK *track = trackList[trackIdx];
+    // From here, every layer is built by tasks running on the thread pool.  The layer maps are
+    // not modified anymore until all the tasks are done, and each task writes only to its own
+    // buffer or to containers no other task uses, so containers need no locking.
+    std::vector<std::function<void()>>         tasks;
+    std::vector<std::unique_ptr<LAYER_BUFFER>> buffers;
+    std::atomic<int64_t>                       taskTime[TASK_KIND_COUNT];
 
-            if( !track->IsOnLayer( layer ) )
-                continue;
+    for( std::atomic<int64_t>& time : taskTime )
+        time = 0;
 
-            // ADD VIAS and THT
-            if( track->Type() == PCB_VIA_T )
+    auto addTask =
+            [&]( LAYER_TASK_KIND aKind, std::function<void()> aTask )
             {
-                const PCB_VIA* via = static_cast<const PCB_VIA*>( track );
-                const VIATYPE  viatype = via->GetViaType();
-
-                if( viatype != VIATYPE::THROUGH )
-                {
-                    // Add PCB_VIA hole contours
-
-                    // Add outer holes of VIAs
-                    SHAPE_POLY_SET *layerOuterHolesPoly = nullptr;
-                    SHAPE_POLY_SET *layerInnerHolesPoly = nullptr;
+                tasks.emplace_back(
+                        [aKind, aTask, &taskTime]()
+                        {
+                            PROF_TIMER taskTimer;
 
-                    // Check if the layer is already created
-                    if( m_layerHoleOdPolys.find( layer ) == m_layerHoleOdPolys.end() )
-                    {
-                        // not found, create a new container
-                        layerOuterHolesPoly = new SHAPE_POLY_SET;
-                        m_layerHoleOdPolys[layer] = layerOuterHolesPoly;
+                            aTask();
+                            taskTime[aKind] += (int64_t) ( taskTimer.msecs() * 1000.0 );
+                        } );
+            };
 
-                        wxASSERT( m_layerHoleIdPolys.find( layer ) == m_layerHoleIdPolys.end() );
+    // Add graphic items of a layer to object containers
+    auto addDrawings =
+            [&]( PCB_LAYER_ID aLayer, CONTAINER_2D_BASE* aContainer, bool aTraceUnknown )
+            {
+                for( BOARD_ITEM* item : m_board->Drawings() )
+                {
+                    if( !item->IsOnLayer( aLayer ) )
+                        continue;
 
-                        layerInnerHolesPoly = new SHAPE_POLY_SET;
-                        m_layerHoleIdPolys[layer] = layerInnerHolesPoly;
-                    }
-                    else
+                    switch( item->Type() )
                     {
-                        // found
-                        layerOuterHolesPoly = m_layerHoleOdPolys[layer];
-
-                        wxASSERT( m_layerHoleIdPolys.find( layer ) != m_layerHoleIdPolys.end() );
-
-                        layerInnerHolesPoly = m_layerHoleIdPolys[layer];
-                    }
-
-                    const int holediameter = via->GetDrillValue();
-                    const int hole_outer_radius = (holediameter / 2) + GetHolePlatingThickness();
+                    case PCB_SHAPE_T:
+                        addShape( static_cast<PCB_SHAPE*>( item ), aContainer, item );
+                        break;
 
-                    TransformCircleToPolygon( *layerOuterHolesPoly, via->GetStart(),
-                                              hole_outer_radius, maxError, ERROR_INSIDE );
+                    case PCB_TEXT_T:
+                        addText( static_cast<PCB_TEXT*>( item ), aContainer, item );
+                        break;
 
-                    TransformCircleToPolygon( *layerInnerHolesPoly, via->GetStart(),
-                                              holediameter / 2, maxError, ERROR_INSIDE );
-                }
-                else if( layer == layer_ids[0] ) // it only adds once the THT holes
-                {
-                    const int holediameter = via->GetDrillValue();
-                    const int hole_outer_radius = (holediameter / 2) + GetHolePlatingThickness();
-                    const int hole_outer_ring_radius = via->GetWidth() / 2.0f;
+                    case PCB_TEXTBOX_T:
+                        addText( static_cast<PCB_TEXTBOX*>( item ), aContainer, item );
+                        addShape( static_cast<PCB_TEXTBOX*>( item ), aContainer, item );
+                        break;
 
-                    // Add through hole contours
-                    TransformCircleToPolygon( m_throughHoleOdPolys, via->GetStart(),
-                                              hole_outer_radius, maxError, ERROR_INSIDE );
+                    case PCB_DIM_ALIGNED_T:
+                    case PCB_DIM_CENTER_T:
+                    case PCB_DIM_RADIAL_T:
+                    case PCB_DIM_ORTHOGONAL_T:
+                    case PCB_DIM_LEADER_T:
+                        addShape( static_cast<PCB_DIMENSION_BASE*>( item ), aContainer, item );
+                        break;
 
-                    // Add same thing for vias only
-                    TransformCircleToPolygon( m_throughHoleViaOdPolys, via->GetStart(),
-                                              hole_outer_radius, maxError, ERROR_INSIDE );
+                    default:
+                        if( aTraceUnknown )
+                        {
+                            wxLogTrace( m_logTrace,
+                                        wxT( "createLayers: item type: %d not implemented" ),
+                                        item->Type() );
+                        }
 
-                    if( m_Cfg->m_Render.clip_silk_on_via_annulus && m_Cfg->m_Render.realistic )
-                    {
-                        TransformCircleToPolygon( m_throughHoleAnnularRingPolys, via->GetStart(),
-                                                  hole_outer_ring_radius, maxError, ERROR_INSIDE );
+                        break;
                     }
                 }
-            }
-        }
-    }
+            };
 
-    // Creates vertical outline contours of the tracks and add it to the poly of the layer
-    if( m_Cfg->m_Render.opengl_copper_thickness && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+    // Add graphic items of a layer to poly contours (vertical outlines)
+    auto addDrawingPolys =
+            [&]( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aPoly, bool aTraceUnknown )
+            {
+                for( BOARD_ITEM* item : m_board->Drawings() )
+                {
+                    if( !item->IsOnLayer( aLayer ) )
+                        continue;
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                    switch( item->Type() )
+                    {
+                    case PCB_SHAPE_T:
+                        item->TransformShapeToPolygon( aPoly, aLayer, 0, maxError, ERROR_INSIDE );
+                        break;
 
-            // ADD TRACKS
-            unsigned int nTracks = trackList.size();
+                    case PCB_TEXT_T:
+                    {
+                        PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
 
-            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-            {
-                const PCB_TRACK *track = trackList[trackIdx];
+                        text->TransformTextToPolySet( aPoly, aLayer, 0, maxError, ERROR_INSIDE );
+                        break;
+                    }
 
-                if( !track->IsOnLayer( layer ) )
-                    continue;
+                    case PCB_TEXTBOX_T:
+                    {
+                        PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
 
-                // Skip vias annulus when not connected on this layer (if removing is enabled)
-                const PCB_VIA *via = dyn_cast<const PCB_VIA*>( track );
+                        textbox->TransformTextToPolySet( aPoly, aLayer, 0, maxError, ERROR_INSIDE );
+                        break;
+                    }
 
-                if( via && !via->FlashLayer( layer ) && IsCopperLayer( layer ) )
-                    continue;
+                    default:
+                        if( aTraceUnknown )
+                        {
+                            wxLogTrace( m_logTrace,
+                                        wxT( "createLayers: item type: %d not implemented" ),
+                                        item->Type() );
+                        }
 
-                // Add the track/via contour
-                track->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-            }
-        }
-    }
+                        break;
+                    }
+                }
+            };
 
-    // Add holes of footprints
-    for( FOOTPRINT* footprint : m_board->Footprints() )
+    // Copper layers: tracks, vias, pads, footprint and board graphics
+    for( PCB_LAYER_ID layer : layer_ids )
     {
-        for( PAD* pad : footprint->Pads() )
-        {
-            const VECTOR2I padHole = pad->GetDrillSize();
+        buffers.push_back( std::make_unique<LAYER_BUFFER>( layer ) );
+        LAYER_BUFFER* buffer = buffers.back().get();
 
-            if( !padHole.x )    // Not drilled pad like SMD pad
-                continue;
+        addTask( TASK_COPPER,
+                [&, layer, buffer]()
+                {
+                    CONTAINER_2D_BASE* layerContainer = &buffer->m_objects;
+                    SHAPE_POLY_SET&    layerPoly = buffer->m_poly;
 
-            // The hole in the body is inflated by copper thickness, if not plated, no copper
-            const int inflate = ( pad->GetAttribute () != PAD_ATTRIB::NPTH ) ?
-                                GetHolePlatingThickness() / 2 : 0;
+                    BVH_CONTAINER_2D*  layerHoleContainer = nullptr;
+                    SHAPE_POLY_SET*    layerOuterHolesPoly = nullptr;
+                    SHAPE_POLY_SET*    layerInnerHolesPoly = nullptr;
 
-            m_holeCount++;
-            m_averageHoleDiameter += ( ( pad->GetDrillSize().x +
-                                             pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
+                    if( fullBuild && m_layerHoleMap.find( layer ) != m_layerHoleMap.end() )
+                    {
+                        layerHoleContainer = m_layerHoleMap.at( layer );
+                        layerOuterHolesPoly = m_layerHoleOdPolys.at( layer );
+                        layerInnerHolesPoly = m_layerHoleIdPolys.at( layer );
+                    }
 
-            m_throughHoleOds.Add( createPadWithDrill( pad, inflate ) );
+                    for( const PCB_TRACK* track : trackList )
+                    {
+                        // NOTE: Vias can be on multiple layers
+                        if( !track->IsOnLayer( layer ) )
+                            continue;
 
-            if( m_Cfg->m_Render.clip_silk_on_via_annulus && m_Cfg->m_Render.realistic )
-                m_throughHoleAnnularRings.Add( createPadWithDrill( pad, inflate ) );
+                        const PCB_VIA* via = dyn_cast<const PCB_VIA*>( track );
 
-            m_throughHoleIds.Add( createPadWithDrill( pad, 0 ) );
-        }
-    }
+                        // Skip vias annulus when not connected on this layer (if removing is
+                        // enabled)
+                        if( !via || via->FlashLayer( layer ) )
+                        {
+                            // Add object item to layer container
+                            createTrack( track, layerContainer );
 
-    if( m_holeCount )
-        m_averageHoleDiameter /= (float)m_holeCount;
+                            // Add the track/via contour
+                            if( buildCopperPolys )
+                            {
+                                track->TransformShapeToPolygon( layerPoly, layer, 0, maxError,
+                                                                ERROR_INSIDE );
+                            }
+                        }
 
-    // Add contours of the pad holes (pads can be Circle or Segment holes)
-    for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        for( PAD* pad : footprint->Pads() )
-        {
-            const VECTOR2I padHole = pad->GetDrillSize();
+                        if( !via || via->GetViaType() == VIATYPE::THROUGH || !layerHoleContainer )
+                            continue;
 
-            if( !padHole.x ) // Not drilled pad like SMD pad
-                continue;
+                        // Add hole objects and contours of blind and buried vias
+                        // holes and layer copper extend half info cylinder wall to hide
+                        // transition
+                        const float thickness = GetHolePlatingThickness() * BiuTo3dUnits() / 2.0f;
+                        const float hole_inner_radius =
+                                via->GetDrillValue() * BiuTo3dUnits() / 2.0f;
 
-            // The hole in the body is inflated by copper thickness.
-            const int inflate = GetHolePlatingThickness();
+                        const SFVEC2F via_center( via->GetStart().x * m_biuTo3Dunits,
+                                                  -via->GetStart().y * m_biuTo3Dunits );
 
-            if( pad->GetAttribute () != PAD_ATTRIB::NPTH )
-            {
-                if( m_Cfg->m_Render.clip_silk_on_via_annulus && m_Cfg->m_Render.realistic )
-                {
-                    pad->TransformHoleToPolygon( m_throughHoleAnnularRingPolys, inflate, maxError,
-                                                 ERROR_INSIDE );
-                }
+                        layerHoleContainer->Add(
+                                new FILLED_CIRCLE_2D( via_center, hole_inner_radius + thickness,
+                                                      *track ) );
 
-                pad->TransformHoleToPolygon( m_throughHoleOdPolys, inflate, maxError,
-                                             ERROR_INSIDE );
-            }
-            else
-            {
-                // If not plated, no copper.
-                if( m_Cfg->m_Render.clip_silk_on_via_annulus && m_Cfg->m_Render.realistic )
-                {
-                    pad->TransformHoleToPolygon( m_throughHoleAnnularRingPolys, 0, maxError,
-                                                 ERROR_INSIDE );
-                }
+                        const int holediameter = via->GetDrillValue();
+                        const int hole_outer_radius = ( holediameter / 2 )
+                                                      + GetHolePlatingThickness();
 
-                pad->TransformHoleToPolygon( m_nonPlatedThroughHoleOdPolys, 0, maxError,
-                                             ERROR_INSIDE );
-            }
-        }
-    }
+                        TransformCircleToPolygon( *layerOuterHolesPoly, via->GetStart(),
+                                                  hole_outer_radius, maxError, ERROR_INSIDE );
 
-    const bool renderPlatedPadsAsPlated = m_Cfg->m_Render.renderPlatedPadsAsPlated
-                                                && m_Cfg->m_Render.realistic;
+                        TransformCircleToPolygon( *layerInnerHolesPoly, via->GetStart(),
+                                                  holediameter / 2, maxError, ERROR_INSIDE );
+                    }
 
-    // Add footprints PADs objects to containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
+                    for( FOOTPRINT* footprint : m_board->Footprints() )
+                    {
+                        // Note: NPTH pads are not drawn on copper layers when the pad has the
+                        // same shape as its hole
+                        addPads( footprint, layerContainer, layer, true, renderPlatedPadsAsPlated,
+                                 false );
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+                        // Micro-wave footprints may have items on copper layers
+                        addFootprintShapes( footprint, layerContainer, layer );
 
-        // ADD PADS
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            // Note: NPTH pads are not drawn on copper layers when the pad has the same shape
-            // as its hole
-            addPads( footprint, layerContainer, layer, true, renderPlatedPadsAsPlated, false );
+                        if( buildCopperPolys )
+                        {
+                            footprint->TransformPadsToPolySet( layerPoly, layer, 0, maxError,
+                                                               ERROR_INSIDE, true,
+                                                               renderPlatedPadsAsPlated, false );
 
-            // Micro-wave footprints may have items on copper layers
-            addFootprintShapes( footprint, layerContainer, layer );
-        }
-    }
+                            transformFPShapesToPolySet( footprint, layer, layerPoly );
+                        }
+                    }
 
-    if( renderPlatedPadsAsPlated )
-    {
-        // ADD PLATED PADS
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            addPads( footprint, m_platedPadsFront, F_Cu, true, false, true );
-            addPads( footprint, m_platedPadsBack, B_Cu, true, false, true );
-        }
+                    // Add graphic items on copper layers (texts and other graphics)
+                    addDrawings( layer, layerContainer, true );
 
-        m_platedPadsFront->BuildBVH();
-        m_platedPadsBack->BuildBVH();
+                    if( buildCopperPolys )
+                        addDrawingPolys( layer, layerPoly, true );
+
+                    if( layerHoleContainer )
+                    {
+                        layerHoleContainer->BuildBVH();
+                        layerOuterHolesPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
+                        layerInnerHolesPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
+                    }
+                } );
     }
 
-    // Add footprints PADs poly contours (vertical outlines)
-    if( m_Cfg->m_Render.opengl_copper_thickness && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL )
+    // Copper zones: one task per zone layer, as a large zone can take longer to convert than
+    // all the other items of its layer
+    if( m_Cfg->m_Render.show_zones )
     {
-        for( PCB_LAYER_ID layer : layer_ids )
+        for( ZONE* zone : m_board->Zones() )
         {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
-
-            // Add pads to polygon list
-            for( FOOTPRINT* footprint : m_board->Footprints() )
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
             {
-                // Note: NPTH pads are not drawn on copper layers when the pad has same shape as
-                // its hole
-                footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE,
-                                                   true, renderPlatedPadsAsPlated, false );
+                if( !enabledCopperLayers.Contains( layer ) )
+                    continue;
 
-                transformFPShapesToPolySet( footprint, layer, *layerPoly );
-            }
-        }
+                buffers.push_back( std::make_unique<LAYER_BUFFER>( layer ) );
+                LAYER_BUFFER* buffer = buffers.back().get();
 
-        if( renderPlatedPadsAsPlated )
-        {
-            // ADD PLATED PADS contours
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                footprint->TransformPadsToPolySet( *m_frontPlatedPadPolys, F_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
+                addTask( TASK_ZONES,
+                        [&, zone, layer, buffer]()
+                        {
+                            addSolidAreasShapes( zone, &buffer->m_objects, layer );
 
-                footprint->TransformPadsToPolySet( *m_backPlatedPadPolys, B_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
+                            if( buildCopperPolys )
+                                zone->TransformSolidAreasShapesToPolygon( layer, buffer->m_poly );
+                        } );
             }
         }
     }
 
-    // Add graphic item on copper layers to object containers
-    for( PCB_LAYER_ID layer : layer_ids )
+    // Through holes of vias and pads.  This task is the only one using these containers.
+    if( fullBuild )
     {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
+        addTask( TASK_HOLES,
+                [&]()
+                {
+                    // The through via holes are only added if a copper layer is shown
+                    for( const PCB_TRACK* track : trackList )
+                    {
+                        if( layer_ids.empty() || track->Type() != PCB_VIA_T )
+                            continue;
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+                        const PCB_VIA* via = static_cast<const PCB_VIA*>( track );
 
-        // Add graphic items on copper layers (texts and other graphics)
-        for( BOARD_ITEM* item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( layer ) )
-                continue;
+                        if( via->GetViaType() != VIATYPE::THROUGH )
+                            continue;
 
-            switch( item->Type() )
-            {
-            case PCB_SHAPE_T:
-                addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXT_T:
-                addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXTBOX_T:
-                addText( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                break;
-
-            case PCB_DIM_ALIGNED_T:
-            case PCB_DIM_CENTER_T:
-            case PCB_DIM_RADIAL_T:
-            case PCB_DIM_ORTHOGONAL_T:
-            case PCB_DIM_LEADER_T:
-                addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                break;
-
-            default:
-                wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-                break;
-            }
-        }
-    }
+                        const float holediameter = via->GetDrillValue() * BiuTo3dUnits();
 
-    // Add graphic item on copper layers to poly contours (vertical outlines)
-    if( m_Cfg->m_Render.opengl_copper_thickness && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+                        // holes and layer copper extend half info cylinder wall to hide
+                        // transition
+                        const float thickness = GetHolePlatingThickness() * BiuTo3dUnits() / 2.0f;
+                        const float hole_inner_radius = holediameter / 2.0f;
+                        const float ring_radius = via->GetWidth() * BiuTo3dUnits() / 2.0f;
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                        const SFVEC2F via_center( via->GetStart().x * m_biuTo3Dunits,
+                                                  -via->GetStart().y * m_biuTo3Dunits );
 
-            // Add graphic items on copper layers (texts and other )
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
+                        // Add through hole object
+                        m_throughHoleOds.Add( new FILLED_CIRCLE_2D( via_center,
+                                                                    hole_inner_radius + thickness,
+                                                                    *track ) );
+                        m_throughHoleViaOds.Add(
+                                new FILLED_CIRCLE_2D( via_center, hole_inner_radius + thickness,
+                                                      *track ) );
 
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
+                        if( clipSilkOnViaAnnulus )
+                        {
+                            m_throughHoleAnnularRings.Add( new FILLED_CIRCLE_2D( via_center,
+                                                                                 ring_radius,
+                                                                                 *track ) );
+                        }
 
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+                        m_throughHoleIds.Add( new FILLED_CIRCLE_2D( via_center, hole_inner_radius,
+                                                                    *track ) );
 
-                    text->TransformTextToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                        const int hole_outer_radius = ( via->GetDrillValue() / 2 )
+                                                      + GetHolePlatingThickness();
+                        const int hole_outer_ring_radius = via->GetWidth() / 2.0f;
 
-                case PCB_TEXTBOX_T:
-                {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+                        // Add through hole contours
+                        TransformCircleToPolygon( m_throughHoleOdPolys, via->GetStart(),
+                                                  hole_outer_radius, maxError, ERROR_INSIDE );
 
-                    textbox->TransformTextToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                        // Add same thing for vias only
+                        TransformCircleToPolygon( m_throughHoleViaOdPolys, via->GetStart(),
+                                                  hole_outer_radius, maxError, ERROR_INSIDE );
 
-                default:
-                    wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                                item->Type() );
-                    break;
-                }
-            }
-        }
-    }
+                        if( clipSilkOnViaAnnulus )
+                        {
+                            TransformCircleToPolygon( m_throughHoleAnnularRingPolys,
+                                                      via->GetStart(), hole_outer_ring_radius,
+                                                      maxError, ERROR_INSIDE );
+                        }
+                    }
 
-    if( m_Cfg->m_Render.show_zones )
-    {
-        if( aStatusReporter )
-            aStatusReporter->Report( _( "Create zones" ) );
+                    // Add holes of footprints
+                    for( FOOTPRINT* footprint : m_board->Footprints() )
+                    {
+                        for( PAD* pad : footprint->Pads() )
+                        {
+                            const VECTOR2I padHole = pad->GetDrillSize();
 
-        std::vector<std::pair<ZONE*, PCB_LAYER_ID>> zones;
-        std::unordered_map<PCB_LAYER_ID, std::unique_ptr<std::mutex>> layer_lock;
+                            if( !padHole.x )    // Not drilled pad like SMD pad
+                                continue;
 
-        for( ZONE* zone : m_board->Zones() )
-        {
-            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
-            {
-                zones.emplace_back( std::make_pair( zone, layer ) );
-                layer_lock.emplace( layer, std::make_unique<std::mutex>() );
-            }
-        }
+                            // The hole in the body is inflated by copper thickness, if not plated,
+                            // no copper
+                            const int inflate = ( pad->GetAttribute () != PAD_ATTRIB::NPTH ) ?
+                                                GetHolePlatingThickness() / 2 : 0;
 
-        // Add zones objects
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
+                            m_throughHoleOds.Add( createPadWithDrill( pad, inflate ) );
 
-        size_t parallelThreadCount = std::min<size_t>( zones.size(),
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
+                            if( clipSilkOnViaAnnulus )
+                                m_throughHoleAnnularRings.Add( createPadWithDrill( pad, inflate ) );
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < zones.size();
-                            areaId = nextZone.fetch_add( 1 ) )
-                {
-                    ZONE* zone = zones[areaId].first;
+                            m_throughHoleIds.Add( createPadWithDrill( pad, 0 ) );
+                        }
+                    }
 
-                    if( zone == nullptr )
-                        break;
+                    // Add contours of the pad holes (pads can be Circle or Segment holes)
+                    for( FOOTPRINT* footprint : m_board->Footprints() )
+                    {
+                        for( PAD* pad : footprint->Pads() )
+                        {
+                            const VECTOR2I padHole = pad->GetDrillSize();
 
-                    PCB_LAYER_ID layer = zones[areaId].second;
+                            if( !padHole.x ) // Not drilled pad like SMD pad
+                                continue;
 
-                    auto layerContainer = m_layerMap.find( layer );
-                    auto layerPolyContainer = m_layers_poly.find( layer );
+                            // The hole in the body is inflated by copper thickness.
+                            const int inflate = GetHolePlatingThickness();
 
-                    if( layerContainer != m_layerMap.end() )
-                        addSolidAreasShapes( zone, layerContainer->second, layer );
+                            if( pad->GetAttribute () != PAD_ATTRIB::NPTH )
+                            {
+                                if( clipSilkOnViaAnnulus )
+                                {
+                                    pad->TransformHoleToPolygon( m_throughHoleAnnularRingPolys,
+                                                                 inflate, maxError, ERROR_INSIDE );
+                                }
+
+                                pad->TransformHoleToPolygon( m_throughHoleOdPolys, inflate,
+                                                             maxError, ERROR_INSIDE );
+                            }
+                            else
+                            {
+                                // If not plated, no copper.
+                                if( clipSilkOnViaAnnulus )
+                                {
+                                    pad->TransformHoleToPolygon( m_throughHoleAnnularRingPolys, 0,
+                                                                 maxError, ERROR_INSIDE );
+                                }
+
+                                pad->TransformHoleToPolygon( m_nonPlatedThroughHoleOdPolys, 0,
+                                                             maxError, ERROR_INSIDE );
+                            }
+                        }
+                    }
+                } );
+    }
 
-                    if( m_Cfg->m_Render.opengl_copper_thickness
-                          && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL
-                          && layerPolyContainer != m_layers_poly.end() )
+    if( renderPlatedPadsAsPlated && fullBuild )
+    {
+        addTask( TASK_PLATED_PADS,
+                [&]()
+                {
+                    // ADD PLATED PADS
+                    for( FOOTPRINT* footprint : m_board->Footprints() )
                     {
-                        auto mut_it = layer_lock.find( layer );
-
-                        std::lock_guard< std::mutex > lock( *( mut_it->second ) );
-                        zone->TransformSolidAreasShapesToPolygon( layer, *layerPolyContainer->second );
+                        addPads( footprint, m_platedPadsFront, F_Cu, true, false, true );
+                        addPads( footprint, m_platedPadsBack, B_Cu, true, false, true );
                     }
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                    m_platedPadsFront->BuildBVH();
+                    m_platedPadsBack->BuildBVH();
 
+                    // ADD PLATED PADS contours
+                    if( buildCopperPolys )
+                    {
+                        for( FOOTPRINT* footprint : m_board->Footprints() )
+                        {
+                            footprint->TransformPadsToPolySet( *m_frontPlatedPadPolys, F_Cu, 0,
+                                                               maxError, ERROR_INSIDE, true, false,
+                                                               true );
+
+                            footprint->TransformPadsToPolySet( *m_backPlatedPadPolys, B_Cu, 0,
+                                                               maxError, ERROR_INSIDE, true, false,
+                                                               true );
+                        }
+                    }
+                } );
     }
 
-    // Simplify layer polygons
-
-    if( aStatusReporter )
-        aStatusReporter->Report( _( "Simplifying copper layers polygons" ) );
-
-    if( m_Cfg->m_Render.opengl_copper_thickness && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL )
+    // Tech layers.  Each task is the only one using its layer containers.
+    for( PCB_LAYER_ID layer : techLayers )
     {
-        if( renderPlatedPadsAsPlated )
-        {
-            if( m_frontPlatedPadPolys && ( m_layers_poly.find( F_Cu ) != m_layers_poly.end() ) )
-            {
-                if( aStatusReporter )
-                    aStatusReporter->Report( _( "Simplifying polygons on F_Cu" ) );
+        addTask( TASK_TECH,
+                [&, layer]()
+                {
+                    BVH_CONTAINER_2D* layerContainer = m_layerMap.at( layer );
+                    SHAPE_POLY_SET*   layerPoly = m_layers_poly.at( layer );
 
-                SHAPE_POLY_SET *layerPoly_F_Cu = m_layers_poly[F_Cu];
-                layerPoly_F_Cu->BooleanSubtract( *m_frontPlatedPadPolys, SHAPE_POLY_SET::PM_FAST );
+                    // Add drawing objects
+                    addDrawings( layer, layerContainer, false );
 
-                 m_frontPlatedPadPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
-            }
+                    // Add drawing contours (vertical walls)
+                    if( buildVerticalWallsForTechLayers )
+                        addDrawingPolys( layer, *layerPoly, false );
 
-            if( m_backPlatedPadPolys && ( m_layers_poly.find( B_Cu ) != m_layers_poly.end() ) )
-            {
-                if( aStatusReporter )
-                    aStatusReporter->Report( _( "Simplifying polygons on B_Cu" ) );
-
-                SHAPE_POLY_SET *layerPoly_B_Cu = m_layers_poly[B_Cu];
-                layerPoly_B_Cu->BooleanSubtract( *m_backPlatedPadPolys, SHAPE_POLY_SET::PM_FAST );
+                    const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+                    int linewidth = bds.m_LineThickness[ LAYER_CLASS_SILK ];
 
-                m_backPlatedPadPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
-            }
-        }
+                    // Add footprints tech layers - objects
+                    for( FOOTPRINT* footprint : m_board->Footprints() )
+                    {
+                        if( layer == F_SilkS || layer == B_SilkS )
+                        {
+                            for( PAD* pad : footprint->Pads() )
+                            {
+                                if( !pad->IsOnLayer( layer ) )
+                                    continue;
 
-        std::vector<PCB_LAYER_ID> &selected_layer_id = layer_ids;
-        std::vector<PCB_LAYER_ID> layer_id_without_F_and_B;
+                                buildPadOutlineAsSegments( pad, layerContainer, linewidth );
+                            }
+                        }
+                        else
+                        {
+                            addPads( footprint, layerContainer, layer, false, false, false );
+                        }
 
-        if( renderPlatedPadsAsPlated )
-        {
-            layer_id_without_F_and_B.clear();
-            layer_id_without_F_and_B.reserve( layer_ids.size() );
+                        addFootprintShapes( footprint, layerContainer, layer );
+                    }
 
-            for( PCB_LAYER_ID layer: layer_ids )
-            {
-                if( layer != F_Cu && layer != B_Cu )
-                    layer_id_without_F_and_B.push_back( layer );
-            }
+                    // Add footprints tech layers - contours (vertical walls)
+                    if( buildVerticalWallsForTechLayers )
+                    {
+                        for( FOOTPRINT* footprint : m_board->Footprints() )
+                        {
+                            if( layer == F_SilkS || layer == B_SilkS )
+                            {
+                                for( PAD* pad : footprint->Pads() )
+                                {
+                                    if( !pad->IsOnLayer( layer ) )
+                                        continue;
 
-            selected_layer_id = layer_id_without_F_and_B;
-        }
+                                    buildPadOutlineAsPolygon( pad, *layerPoly, linewidth );
+                                }
+                            }
+                            else
+                            {
+                                footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError,
+                                                                   ERROR_INSIDE );
+                            }
 
-        if( selected_layer_id.size() > 0 )
-        {
-            if( aStatusReporter )
-            {
-                aStatusReporter->Report( wxString::Format( _( "Simplifying %d copper layers" ),
-                                                           (int) selected_layer_id.size() ) );
-            }
+                            // On tech layers, use a poor circle approximation, only for texts
+                            // (stroke font)
+                            footprint->TransformFPTextToPolySet( *layerPoly, layer, 0, maxError,
+                                                                 ERROR_INSIDE );
 
-            std::atomic<size_t> nextItem( 0 );
-            std::atomic<size_t> threadsFinished( 0 );
+                            // Add the remaining things with dynamic seg count for circles
+                            transformFPShapesToPolySet( footprint, layer, *layerPoly );
+                        }
+                    }
 
-            size_t parallelThreadCount = std::min<size_t>(
-                    std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                    selected_layer_id.size() );
+                    // Draw non copper zones
+                    if( m_Cfg->m_Render.show_zones )
+                    {
+                        for( ZONE* zone : m_board->Zones() )
+                        {
+                            if( zone->IsOnLayer( layer ) )
+                                addSolidAreasShapes( zone, layerContainer, layer );
+                        }
 
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            {
-                std::thread t = std::thread(
-                        [&nextItem, &threadsFinished, &selected_layer_id, this]()
+                        if( buildVerticalWallsForTechLayers )
                         {
-                            for( size_t i = nextItem.fetch_add( 1 );
-                                        i < selected_layer_id.size();
-                                        i = nextItem.fetch_add( 1 ) )
+                            for( ZONE* zone : m_board->Zones() )
                             {
-                                auto layerPoly = m_layers_poly.find( selected_layer_id[i] );
-
-                                if( layerPoly != m_layers_poly.end() )
-                                    // This will make a union of all added contours
-                                    layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
+                                if( zone->IsOnLayer( layer ) )
+                                    zone->TransformSolidAreasShapesToPolygon( layer, *layerPoly );
                             }
+                        }
+                    }
 
-                            threadsFinished++;
-                        } );
-
-                t.detach();
-            }
+                    // This will make a union of all added contours
+                    layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
 
-            while( threadsFinished < parallelThreadCount )
-                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-        }
+                    // We only need the Solder mask to initialize the BVH
+                    // because..?
+                    if( layer == B_Mask || layer == F_Mask )
+                        layerContainer->BuildBVH();
+                } );
     }
 
-    // Simplify holes polygon contours
     if( aStatusReporter )
-        aStatusReporter->Report( _( "Simplify holes contours" ) );
+        aStatusReporter->Report( _( "Create tracks and vias" ) );
 
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        if( m_layerHoleOdPolys.find( layer ) != m_layerHoleOdPolys.end() )
-        {
-            // found
-            SHAPE_POLY_SET *polyLayer = m_layerHoleOdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+    runOnThreadPool( tasks );
+    tasks.clear();
 
-            wxASSERT( m_layerHoleIdPolys.find( layer ) != m_layerHoleIdPolys.end() );
+    double buildTime = phaseTimer.msecs( true );
 
-            polyLayer = m_layerHoleIdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
-        }
+    // Move the copper buffers to their layers, in creation order
+    for( std::unique_ptr<LAYER_BUFFER>& buffer : buffers )
+    {
+        m_layerMap[buffer->m_layer]->Splice( buffer->m_objects );
+
+        if( buildCopperPolys )
+            m_layers_poly[buffer->m_layer]->Append( buffer->m_poly );
     }
 
-    // End Build Copper layers
+    buffers.clear();
 
-    // This will make a union of all added contours
-    m_throughHoleOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_nonPlatedThroughHoleOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_throughHoleViaOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_throughHoleAnnularRingPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+    double mergeTime = phaseTimer.msecs( true );
 
-    // Build Tech layers
-    // Based on:
-    //    https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L1059
+    // Simplify layer polygons
     if( aStatusReporter )
-        aStatusReporter->Report( _( "Build Tech layers" ) );
-
-    // draw graphic items, on technical layers
-
-    // Vertical walls (layer thickness) around shapes is really time consumming
-    // They are built on request
-    bool buildVerticalWallsForTechLayers = m_Cfg->m_Render.opengl_copper_thickness
-                                              && m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL;
-
-    static const PCB_LAYER_ID techLayerList[] = {
-            B_Adhes,
-            F_Adhes,
-            B_Paste,
-            F_Paste,
-            B_SilkS,
-            F_SilkS,
-            B_Mask,
-            F_Mask,
-
-            // Aux Layers
-            Dwgs_User,
-            Cmts_User,
-            Eco1_User,
-            Eco2_User,
-            Edge_Cuts,
-            Margin
-        };
+        aStatusReporter->Report( _( "Simplifying copper layers polygons" ) );
 
-    // User layers are not drawn here, only technical layers
-    for( LSEQ seq = LSET::AllNonCuMask().Seq( techLayerList, arrayDim( techLayerList ) );
-         seq;
-         ++seq )
+    if( buildCopperPolys )
     {
-        const PCB_LAYER_ID layer = *seq;
-
-        if( !Is3dLayerEnabled( layer ) )
-            continue;
-
-        if( aStatusReporter )
-            aStatusReporter->Report( wxString::Format( _( "Build Tech layer %d" ), (int) layer ) );
-
-        BVH_CONTAINER_2D *layerContainer = new BVH_CONTAINER_2D;
-        m_layerMap[layer] = layerContainer;
-
-        SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
-        m_layers_poly[layer] = layerPoly;
-
-        // Add drawing objects
-        for( BOARD_ITEM* item : m_board->Drawings() )
+        for( PCB_LAYER_ID layer : layer_ids )
         {
-            if( !item->IsOnLayer( layer ) )
-                continue;
+            SHAPE_POLY_SET* layerPoly = m_layers_poly[layer];
 
-            switch( item->Type() )
+            if( renderPlatedPadsAsPlated && layer == F_Cu && m_frontPlatedPadPolys )
             {
-            case PCB_SHAPE_T:
-                addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXT_T:
-                addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXTBOX_T:
-                addText( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                break;
-
-            case PCB_DIM_ALIGNED_T:
-            case PCB_DIM_CENTER_T:
-            case PCB_DIM_RADIAL_T:
-            case PCB_DIM_ORTHOGONAL_T:
-            case PCB_DIM_LEADER_T:
-                addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                break;
-
-            default:
-                break;
-            }
-        }
-
-        // Add drawing contours (vertical walls)
-        if( buildVerticalWallsForTechLayers )
-        {
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
-
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
-
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
-
-                    text->TransformTextToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
-
-                case PCB_TEXTBOX_T:
-                {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
-
-                    textbox->TransformTextToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                tasks.emplace_back(
+                        [this, layerPoly, fullBuild]()
+                        {
+                            layerPoly->BooleanSubtract( *m_frontPlatedPadPolys,
+                                                        SHAPE_POLY_SET::PM_FAST );
 
-                default:
-                    break;
-                }
+                            if( fullBuild )
+                                m_frontPlatedPadPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
+                        } );
             }
-        }
-
-        // Add footprints tech layers - objects
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            if( layer == F_SilkS || layer == B_SilkS )
+            else if( renderPlatedPadsAsPlated && layer == B_Cu && m_backPlatedPadPolys )
             {
-                int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
-
-                for( PAD* pad : footprint->Pads() )
-                {
-                    if( !pad->IsOnLayer( layer ) )
-                        continue;
+                tasks.emplace_back(
+                        [this, layerPoly, fullBuild]()
+                        {
+                            layerPoly->BooleanSubtract( *m_backPlatedPadPolys,
+                                                        SHAPE_POLY_SET::PM_FAST );
 
-                    buildPadOutlineAsSegments( pad, layerContainer, linewidth );
-                }
+                            if( fullBuild )
+                                m_backPlatedPadPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
+                        } );
             }
             else
             {
-                addPads( footprint, layerContainer, layer, false, false, false );
+                // This will make a union of all added contours
+                tasks.emplace_back(
+                        [layerPoly]()
+                        {
+                            layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
+                        } );
             }
-
-            addFootprintShapes( footprint, layerContainer, layer );
         }
+    }
 
-
-        // Add footprints tech layers - contours (vertical walls)
-        if( buildVerticalWallsForTechLayers )
+    if( fullBuild )
+    {
+        // This will make a union of all added contours
+        for( SHAPE_POLY_SET* poly : { &m_throughHoleOdPolys, &m_nonPlatedThroughHoleOdPolys,
+                                      &m_throughHoleViaOdPolys, &m_throughHoleAnnularRingPolys } )
         {
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                if( layer == F_SilkS || layer == B_SilkS )
-                {
-                    int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
-
-                    for( PAD* pad : footprint->Pads() )
+            tasks.emplace_back(
+                    [poly]()
                     {
-                        if( !pad->IsOnLayer( layer ) )
-                            continue;
-
-                        buildPadOutlineAsPolygon( pad, *layerPoly, linewidth );
-                    }
-                }
-                else
-                {
-                    footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                }
-
-                // On tech layers, use a poor circle approximation, only for texts (stroke font)
-                footprint->TransformFPTextToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-
-                // Add the remaining things with dynamic seg count for circles
-                transformFPShapesToPolySet( footprint, layer, *layerPoly );
-            }
+                        poly->Simplify( SHAPE_POLY_SET::PM_FAST );
+                    } );
         }
 
-        // Draw non copper zones
-        if( m_Cfg->m_Render.show_zones )
+        // Build BVH (Bounding volume hierarchy) for holes and vias
+        for( BVH_CONTAINER_2D* container : { &m_throughHoleIds, &m_throughHoleOds,
+                                             &m_throughHoleAnnularRings } )
         {
-            for( ZONE* zone : m_board->Zones() )
-            {
-                if( zone->IsOnLayer( layer ) )
-                    addSolidAreasShapes( zone, layerContainer, layer );
-            }
-
-            if( buildVerticalWallsForTechLayers )
-            {
-                for( ZONE* zone : m_board->Zones() )
-                {
-
-                    if( zone->IsOnLayer( layer ) )
-                        zone->TransformSolidAreasShapesToPolygon( layer, *layerPoly );
-                }
-            }
+            tasks.emplace_back(
+                    [container]()
+                    {
+                        container->BuildBVH();
+                    } );
         }
-
-        // This will make a union of all added contours
-        layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
     }
-    // End Build Tech layers
-
-    // Build BVH (Bounding volume hierarchy) for holes and vias
-
-    if( aStatusReporter )
-        aStatusReporter->Report( _( "Build BVH for holes and vias" ) );
 
-    m_throughHoleIds.BuildBVH();
-    m_throughHoleOds.BuildBVH();
-    m_throughHoleAnnularRings.BuildBVH();
+    runOnThreadPool( tasks );
 
-    if( !m_layerHoleMap.empty() )
-    {
-        for( std::pair<const PCB_LAYER_ID, BVH_CONTAINER_2D*>& hole : m_layerHoleMap )
-            hole.second->BuildBVH();
-    }
+    double simplifyTime = phaseTimer.msecs( true );
 
-    // We only need the Solder mask to initialize the BVH
-    // because..?
-    if( m_layerMap[B_Mask] )
-        m_layerMap[B_Mask]->BuildBVH();
+    wxLogTrace( m_logTrace,
+                wxT( "BOARD_ADAPTER::createLayers: prepare %.1f ms, build %.1f ms, merge %.1f ms, "
+                     "simplify %.1f ms" ),
+                prepareTime, buildTime, mergeTime, simplifyTime );
 
-    if( m_layerMap[F_Mask] )
-        m_layerMap[F_Mask]->BuildBVH();
+    wxLogTrace( m_logTrace,
+                wxT( "BOARD_ADAPTER::createLayers: build task time: copper %.1f ms, zones %.1f ms, "
+                     "holes %.1f ms, plated pads %.1f ms, tech layers %.1f ms" ),
+                taskTime[TASK_COPPER] / 1000.0, taskTime[TASK_ZONES] / 1000.0,
+                taskTime[TASK_HOLES] / 1000.0, taskTime[TASK_PLATED_PADS] / 1000.0,
+                taskTime[TASK_TECH] / 1000.0 );
 }
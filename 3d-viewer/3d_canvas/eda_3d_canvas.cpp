@@ -310,6 +310,13 @@ void EDA_3D_CANVAS::ReloadRequest( BOARD* aBoard , S3D_CACHE* aCachePointer )
 }
 
 
+void EDA_3D_CANVAS::UpdateRequest( const BOARD_3D_CHANGES& aChanges )
+{
+    if( m_3d_render )
+        m_3d_render->UpdateRequest( aChanges );
+}
+
+
 void EDA_3D_CANVAS::RenderRaytracingRequest()
 {
     m_3d_render = m_3d_render_raytracing;
@@ -487,7 +494,8 @@ void EDA_3D_CANVAS::DoRePaint()
             bool reloadRaytracingForCalculations = false;
 
             if( m_boardAdapter.m_Cfg->m_Render.engine == RENDER_ENGINE::OPENGL
-                    && m_3d_render_opengl->IsReloadRequestPending() )
+                    && ( m_3d_render_opengl->IsReloadRequestPending()
+                         || m_3d_render_opengl->IsUpdateRequestPending() ) )
             {
                 reloadRaytracingForCalculations = true;
             }
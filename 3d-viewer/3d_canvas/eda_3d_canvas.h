@@ -83,6 +83,11 @@ public:
 
     void ReloadRequest( BOARD* aBoard = nullptr, S3D_CACHE* aCachePointer = nullptr );
 
+    /**
+     * Request the current render to update only what is touched by some board changes.
+     */
+    void UpdateRequest( const BOARD_3D_CHANGES& aChanges );
+
     /**
      * Query if there is a pending reload request.
      *
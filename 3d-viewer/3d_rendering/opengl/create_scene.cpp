@@ -445,12 +445,17 @@ OPENGL_RENDER_LIST* RENDER_3D_OPENGL::createBoard( const SHAPE_POLY_SET& aBoardP
 }
 
 
-void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningReporter )
+void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningReporter,
+                               bool aKeepModels )
 {
     m_reloadRequested = false;
+    m_pendingChanges.Clear();
 
     freeAllLists();
 
+    if( !aKeepModels )
+        free3dModels();
+
     OBJECT_2D_STATS::Instance().ResetStats();
 
     unsigned stats_startReloadTime = GetRunningMicroSecs();
@@ -564,8 +569,6 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
     if( aStatusReporter )
         aStatusReporter->Report( _( "Load OpenGL: layers" ) );
 
-    const MAP_POLY& map_poly = m_boardAdapter.GetPolyMap();
-
     for( const std::pair<const PCB_LAYER_ID, BVH_CONTAINER_2D*>& ii : m_boardAdapter.GetLayerMap() )
     {
         const PCB_LAYER_ID layer_id = ii.first;
@@ -579,54 +582,7 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
                                                        (int) layer_id ) );
         }
 
-        const BVH_CONTAINER_2D* container2d = ii.second;
-
-        SHAPE_POLY_SET polyListSubtracted;
-        SHAPE_POLY_SET* polyList = nullptr;
-
-        // Load the vertical (Z axis) component of shapes
-
-        if( map_poly.find( layer_id ) != map_poly.end() )
-        {
-            polyListSubtracted = *map_poly.at( layer_id );;
-
-            if( m_boardAdapter.m_Cfg->m_Render.realistic )
-            {
-                polyListSubtracted.BooleanIntersection( m_boardAdapter.GetBoardPoly(),
-                                                        SHAPE_POLY_SET::PM_FAST );
-
-                if( layer_id != B_Mask && layer_id != F_Mask )
-                {
-                    polyListSubtracted.BooleanSubtract( m_boardAdapter.GetThroughHoleOdPolys(),
-                                                        SHAPE_POLY_SET::PM_FAST );
-                    polyListSubtracted.BooleanSubtract( m_boardAdapter.GetOuterNonPlatedThroughHolePoly(),
-                                                        SHAPE_POLY_SET::PM_FAST );
-                }
-
-                if( m_boardAdapter.m_Cfg->m_Render.subtract_mask_from_silk )
-                {
-                    if( layer_id == B_SilkS && map_poly.find( B_Mask ) != map_poly.end() )
-                    {
-                        polyListSubtracted.BooleanSubtract( *map_poly.at( B_Mask ),
-                                                            SHAPE_POLY_SET::PM_FAST );
-                    }
-                    else if( layer_id == F_SilkS && map_poly.find( F_Mask ) != map_poly.end() )
-                    {
-                        polyListSubtracted.BooleanSubtract( *map_poly.at( F_Mask ),
-                                                            SHAPE_POLY_SET::PM_FAST );
-                    }
-                }
-            }
-
-            polyList = &polyListSubtracted;
-        }
-
-        OPENGL_RENDER_LIST* oglList = generateLayerList( container2d, polyList, layer_id,
-                                                         &m_boardAdapter.GetThroughHoleIds() );
-
-        if( oglList != nullptr )
-            m_layers[layer_id] = oglList;
-
+        loadLayer( layer_id );
     }
 
     if( m_boardAdapter.m_Cfg->m_Render.renderPlatedPadsAsPlated
@@ -688,6 +644,125 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
 }
 
 
+bool RENDER_3D_OPENGL::update( REPORTER* aStatusReporter, REPORTER* aWarningReporter )
+{
+    BOARD_3D_CHANGES changes = m_pendingChanges;
+    m_pendingChanges.Clear();
+
+    unsigned stats_startUpdateTime = GetRunningMicroSecs();
+
+    LSET layers;
+
+    if( !m_boardAdapter.UpdateLayers( changes, aStatusReporter, layers ) )
+    {
+        // Holes or the board outline changed: everything must be built again, but the 3D models
+        // are still valid
+        reload( aStatusReporter, aWarningReporter, true );
+        return false;
+    }
+
+    // Silkscreen is clipped by the solder mask
+    if( m_boardAdapter.m_Cfg->m_Render.realistic
+            && m_boardAdapter.m_Cfg->m_Render.subtract_mask_from_silk )
+    {
+        if( layers.Contains( B_Mask ) )
+            layers.set( B_SilkS );
+
+        if( layers.Contains( F_Mask ) )
+            layers.set( F_SilkS );
+    }
+
+    const MAP_CONTAINER_2D_BASE& layerMap = m_boardAdapter.GetLayerMap();
+
+    for( PCB_LAYER_ID layer_id : layers.Seq() )
+    {
+        auto it = m_layers.find( layer_id );
+
+        if( it != m_layers.end() )
+        {
+            delete it->second;
+            m_layers.erase( it );
+        }
+
+        if( layerMap.count( layer_id ) && m_boardAdapter.Is3dLayerEnabled( layer_id ) )
+            loadLayer( layer_id );
+    }
+
+    // An entry must exist in m_layers or we'll never look at the plated pads
+    if( m_platedPadsFront && m_layers.count( F_Cu ) == 0 )
+        m_layers[F_Cu] = generateEmptyLayerList( F_Cu );
+
+    if( m_platedPadsBack && m_layers.count( B_Cu ) == 0 )
+        m_layers[B_Cu] = generateEmptyLayerList( B_Cu );
+
+    if( changes.m_FootprintsChanged )
+        load3dModels( aStatusReporter );
+
+    if( aStatusReporter )
+    {
+        // Calculation time in seconds
+        double calculation_time = (double)( GetRunningMicroSecs() - stats_startUpdateTime ) / 1e6;
+
+        aStatusReporter->Report( wxString::Format( _( "Reload time %.3f s" ), calculation_time ) );
+    }
+
+    return true;
+}
+
+
+void RENDER_3D_OPENGL::loadLayer( PCB_LAYER_ID aLayerId )
+{
+    const MAP_POLY&         map_poly = m_boardAdapter.GetPolyMap();
+    const BVH_CONTAINER_2D* container2d = m_boardAdapter.GetLayerMap().at( aLayerId );
+
+    SHAPE_POLY_SET polyListSubtracted;
+    SHAPE_POLY_SET* polyList = nullptr;
+
+    // Load the vertical (Z axis) component of shapes
+
+    if( map_poly.find( aLayerId ) != map_poly.end() )
+    {
+        polyListSubtracted = *map_poly.at( aLayerId );
+
+        if( m_boardAdapter.m_Cfg->m_Render.realistic )
+        {
+            polyListSubtracted.BooleanIntersection( m_boardAdapter.GetBoardPoly(),
+                                                    SHAPE_POLY_SET::PM_FAST );
+
+            if( aLayerId != B_Mask && aLayerId != F_Mask )
+            {
+                polyListSubtracted.BooleanSubtract( m_boardAdapter.GetThroughHoleOdPolys(),
+                                                    SHAPE_POLY_SET::PM_FAST );
+                polyListSubtracted.BooleanSubtract( m_boardAdapter.GetOuterNonPlatedThroughHolePoly(),
+                                                    SHAPE_POLY_SET::PM_FAST );
+            }
+
+            if( m_boardAdapter.m_Cfg->m_Render.subtract_mask_from_silk )
+            {
+                if( aLayerId == B_SilkS && map_poly.find( B_Mask ) != map_poly.end() )
+                {
+                    polyListSubtracted.BooleanSubtract( *map_poly.at( B_Mask ),
+                                                        SHAPE_POLY_SET::PM_FAST );
+                }
+                else if( aLayerId == F_SilkS && map_poly.find( F_Mask ) != map_poly.end() )
+                {
+                    polyListSubtracted.BooleanSubtract( *map_poly.at( F_Mask ),
+                                                        SHAPE_POLY_SET::PM_FAST );
+                }
+            }
+        }
+
+        polyList = &polyListSubtracted;
+    }
+
+    OPENGL_RENDER_LIST* oglList = generateLayerList( container2d, polyList, aLayerId,
+                                                     &m_boardAdapter.GetThroughHoleIds() );
+
+    if( oglList != nullptr )
+        m_layers[aLayerId] = oglList;
+}
+
+
 void RENDER_3D_OPENGL::addTopAndBottomTriangles( TRIANGLE_DISPLAY_LIST* aDst, const SFVEC2F& v0,
                                                  const SFVEC2F& v1, const SFVEC2F& v2, float top,
                                                  float bot )
@@ -76,6 +76,7 @@ RENDER_3D_OPENGL::~RENDER_3D_OPENGL()
     wxLogTrace( m_logTrace, wxT( "RENDER_3D_OPENGL::RENDER_3D_OPENGL" ) );
 
     freeAllLists();
+    free3dModels();
 
     glDeleteTextures( 1, &m_circleTexture );
 }
@@ -566,6 +567,17 @@ bool RENDER_3D_OPENGL::Redraw( bool aIsMoving, REPORTER* aStatusReporter,
         m_lastGridType = static_cast<GRID3D_TYPE>( m_boardAdapter.m_Cfg->m_Render.grid_type );
         generate3dGrid( m_lastGridType );
     }
+    else if( IsUpdateRequestPending() )
+    {
+        std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
+
+        // The board size, and so the grid, only changes if the update falls back to a reload
+        if( !update( aStatusReporter, aWarningReporter ) )
+        {
+            m_lastGridType = static_cast<GRID3D_TYPE>( m_boardAdapter.m_Cfg->m_Render.grid_type );
+            generate3dGrid( m_lastGridType );
+        }
+    }
     else
     {
         // Check if grid was changed
@@ -1051,13 +1063,6 @@ void RENDER_3D_OPENGL::freeAllLists()
 
     m_triangles.clear();
 
-    for( const std::pair<const wxString, MODEL_3D*>& entry : m_3dModelMap )
-        delete entry.second;
-
-    m_3dModelMap.clear();
-
-    m_3dModelMatrixMap.clear();
-
     delete m_board;
     m_board = nullptr;
 
@@ -1084,6 +1089,17 @@ void RENDER_3D_OPENGL::freeAllLists()
 }
 
 
+void RENDER_3D_OPENGL::free3dModels()
+{
+    for( const std::pair<const wxString, MODEL_3D*>& entry : m_3dModelMap )
+        delete entry.second;
+
+    m_3dModelMap.clear();
+
+    m_3dModelMatrixMap.clear();
+}
+
+
 void RENDER_3D_OPENGL::renderSolderMaskLayer( PCB_LAYER_ID aLayerID, float aZPosition,
                                               bool aDrawMiddleSegments, bool aSkipRenderHoles )
 {
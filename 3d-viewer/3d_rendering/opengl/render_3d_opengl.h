@@ -168,11 +168,30 @@ private:
     bool initializeOpenGL();
     OPENGL_RENDER_LIST* createBoard( const SHAPE_POLY_SET& aBoardPoly,
                                      const BVH_CONTAINER_2D* aThroughHoles = nullptr );
-    void reload( REPORTER* aStatusReporter, REPORTER* aWarningReporter );
+    /**
+     * Rebuild the whole scene.
+     *
+     * @param aKeepModels keep the 3D models already loaded, only load the missing ones.
+     */
+    void reload( REPORTER* aStatusReporter, REPORTER* aWarningReporter,
+                 bool aKeepModels = false );
+
+    /**
+     * Apply the pending board changes, rebuilding only the display lists of the changed layers.
+     *
+     * @return false if a full reload was needed instead.
+     */
+    bool update( REPORTER* aStatusReporter, REPORTER* aWarningReporter );
+
+    /**
+     * Create the display list of a board layer from its 2D container and polygons.
+     */
+    void loadLayer( PCB_LAYER_ID aLayerId );
 
     void setArrowMaterial();
 
     void freeAllLists();
+    void free3dModels();
 
     struct
     {
@@ -28,6 +28,7 @@
  */
 
 #include "bvh_pbrt.h"
+#include "../raypacket_simd.h"
 
 
 #define BVH_RANGED_TRAVERSAL
@@ -44,44 +45,22 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                        unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
-{
-    float hitT;
-
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT )
-      && ( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit ) )
-        return ia;
-
-    if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
-        return RAYPACKET_RAYS_PER_PACKET;
-
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-    {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT )
-          && ( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit ) )
-            return i;
-    }
-
-    return RAYPACKET_RAYS_PER_PACKET;
-}
-
-
 #ifdef BVH_RANGED_TRAVERSAL
 
-static inline unsigned int getLastHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                       unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+/**
+ * @return the mask of the rays, from \a ia, hitting \a aBBox before their current hit.
+ */
+static inline uint64_t getHits( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
+                                unsigned int ia, const float* aTHit )
 {
-    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
-    {
-        float hitT;
+    if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
+        return 0;
 
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT )
-          && ( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit ) )
-            return ie + 1;
-    }
+    const RAYPACKET_BOX box = { { aBBox.Min().x, aBBox.Min().y, aBBox.Min().z },
+                                { aBBox.Max().x, aBBox.Max().y, aBBox.Max().z } };
 
-    return ia + 1;
+    return RAYPACKET_Kernels().IntersectBox( aRayPacket.m_soa, box, aTHit, ia,
+                                             RAYPACKET_RAYS_PER_PACKET );
 }
 
 
@@ -101,16 +80,24 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
     int todoOffset = 0, nodeNum = 0;
     StackNode todo[MAX_TODOS];
 
+    // Closest hit of each ray, laid out for the packet kernels
+    alignas( 32 ) float tHit[RAYPACKET_RAYS_PER_PACKET];
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+
     unsigned int ia = 0;
 
     while( true )
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        const uint64_t cellHits = getHits( aRayPacket, curCell->bounds, ia, tHit );
 
-        if( ia < RAYPACKET_RAYS_PER_PACKET )
+        if( cellHits )
         {
+            ia = RAYPACKET_FirstRay( cellHits );
+
             if( curCell->nPrimitives == 0 )
             {
                 StackNode& node = todo[todoOffset++];
@@ -121,8 +108,7 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
             }
             else
             {
-                const unsigned int ie = getLastHit( aRayPacket, curCell->bounds, ia,
-                                                    aHitInfoPacket );
+                const unsigned int ie = RAYPACKET_LastRay( cellHits ) + 1;
 
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
@@ -130,17 +116,17 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
 
                     if( aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
                     {
-                        for( unsigned int i = ia; i < ie; ++i )
+                        uint64_t hits = obj->IntersectPacket( aRayPacket, ia, ie, tHit,
+                                                              aHitInfoPacket );
+
+                        anyHit |= ( hits != 0 );
+
+                        for( ; hits; hits &= hits - 1 )
                         {
-                            const bool hit = obj->Intersect( aRayPacket.m_ray[i],
-                                                             aHitInfoPacket[i].m_HitInfo );
+                            const unsigned int i = RAYPACKET_FirstRay( hits );
 
-                            if( hit )
-                            {
-                                anyHit |= hit;
-                                aHitInfoPacket[i].m_hitresult |= hit;
-                                aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
-                            }
+                            aHitInfoPacket[i].m_hitresult = true;
+                            aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
                         }
                     }
                 }
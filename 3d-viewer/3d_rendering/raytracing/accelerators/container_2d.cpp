@@ -41,7 +41,6 @@ CONTAINER_2D_BASE::CONTAINER_2D_BASE( OBJECT_2D_TYPE aObjType )
 
 void CONTAINER_2D_BASE::Clear()
 {
-    std::lock_guard<std::mutex> lock( m_lock );
     m_bbox.Reset();
 
     for( LIST_OBJECT2D::iterator ii = m_objects.begin(); ii != m_objects.end(); ++ii )
@@ -53,6 +52,17 @@ void CONTAINER_2D_BASE::Clear()
 }
 
 
+void CONTAINER_2D_BASE::Splice( CONTAINER_2D_BASE& aOther )
+{
+    if( aOther.m_objects.empty() )
+        return;
+
+    m_objects.splice( m_objects.end(), aOther.m_objects );
+    m_bbox.Union( aOther.m_bbox );
+    aOther.m_bbox.Reset();
+}
+
+
 CONTAINER_2D_BASE::~CONTAINER_2D_BASE()
 {
     Clear();
@@ -31,7 +31,6 @@
 
 #include "../shapes2D/object_2d.h"
 #include <list>
-#include <mutex>
 
 struct RAYSEG2D;
 
@@ -39,6 +38,13 @@ typedef std::list<OBJECT_2D*> LIST_OBJECT2D;
 typedef std::list<const OBJECT_2D*> CONST_LIST_OBJECT2D;
 
 
+/**
+ * A list of 2D objects and their bounding box.
+ *
+ * Containers are not thread safe: a container must only be filled by one thread at a time.
+ * Threads building objects in parallel should use their own container and move the objects
+ * to the final one with Splice().
+ */
 class CONTAINER_2D_BASE
 {
 public:
@@ -50,12 +56,18 @@ public:
     {
         if( aObject )
         {
-            std::lock_guard<std::mutex> lock( m_lock );
             m_objects.push_back( aObject );
             m_bbox.Union( aObject->GetBBox() );
         }
     }
 
+    /**
+     * Move all the objects of \a aOther to the end of this container.
+     *
+     * \a aOther is left empty.  This does not copy nor reallocate the objects.
+     */
+    void Splice( CONTAINER_2D_BASE& aOther );
+
     const BBOX_2D& GetBBox() const
     {
         return m_bbox;
@@ -85,9 +97,6 @@ public:
 protected:
     BBOX_2D m_bbox;
     LIST_OBJECT2D m_objects;
-
-private:
-    std::mutex m_lock;
 };
 
 
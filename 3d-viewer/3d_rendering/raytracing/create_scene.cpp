@@ -372,14 +372,26 @@ void RENDER_3D_RAYTRACE::Reload( REPORTER* aStatusReporter, REPORTER* aWarningRe
 
     if( !aOnlyLoadCopperAndShapes )
     {
-        m_boardAdapter.InitSettings( aStatusReporter, aWarningReporter );
+        LSET updatedLayers;
 
-        SFVEC3F camera_pos = m_boardAdapter.GetBoardCenter();
-        m_camera.SetBoardLookAtPos( camera_pos );
+        // After board edits, only the layers touched by the changes are built again.  The
+        // scene itself is always built again from the layers.
+        if( !m_pendingChanges.HasChanges()
+                || !m_boardAdapter.UpdateLayers( m_pendingChanges, aStatusReporter,
+                                                 updatedLayers ) )
+        {
+            m_boardAdapter.InitSettings( aStatusReporter, aWarningReporter );
+
+            SFVEC3F camera_pos = m_boardAdapter.GetBoardCenter();
+            m_camera.SetBoardLookAtPos( camera_pos );
+        }
+
+        m_pendingChanges.Clear();
     }
 
     m_objectContainer.Clear();
     m_containerWithObjectsToDelete.Clear();
+    m_modelGeometryMap.clear();
 
     setupMaterials();
 
@@ -1431,10 +1443,6 @@ void RENDER_3D_RAYTRACE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL*
     if( a3DModel == nullptr )
         return;
 
-    wxASSERT( a3DModel->m_Materials != nullptr );
-    wxASSERT( a3DModel->m_Meshes != nullptr );
-    wxASSERT( a3DModel->m_MaterialsSize > 0 );
-    wxASSERT( a3DModel->m_MeshesSize > 0 );
     wxASSERT( aFPOpacity > 0.0f );
     wxASSERT( aFPOpacity <= 1.0f );
 
@@ -1443,6 +1451,39 @@ void RENDER_3D_RAYTRACE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL*
         aFPOpacity = 1.0f;
     }
 
+    const bool mirrored = glm::determinant( glm::mat3( aModelMatrix ) ) < 0.0f;
+
+    const MODEL_GEOMETRY_3D& geometry = getModelGeometry( a3DModel, aFPOpacity, mirrored,
+                                                          aSkipMaterialInformation );
+
+    if( geometry.IsEmpty() )
+        return;
+
+    MODEL_INSTANCE_3D* instance = new MODEL_INSTANCE_3D( geometry, aModelMatrix );
+
+    instance->SetBoardItem( aBoardItem );
+
+    aDstContainer.Add( instance );
+}
+
+
+const MODEL_GEOMETRY_3D& RENDER_3D_RAYTRACE::getModelGeometry( const S3DMODEL* a3DModel,
+                                                               float aFPOpacity, bool aMirrored,
+                                                               bool aSkipMaterialInformation )
+{
+    std::unique_ptr<MODEL_GEOMETRY_3D>& geometry =
+            m_modelGeometryMap[std::make_tuple( a3DModel, aFPOpacity, aMirrored )];
+
+    if( geometry )
+        return *geometry;
+
+    geometry = std::make_unique<MODEL_GEOMETRY_3D>();
+
+    wxASSERT( a3DModel->m_Materials != nullptr );
+    wxASSERT( a3DModel->m_Meshes != nullptr );
+    wxASSERT( a3DModel->m_MaterialsSize > 0 );
+    wxASSERT( a3DModel->m_MeshesSize > 0 );
+
     if( ( a3DModel->m_Materials != nullptr ) && ( a3DModel->m_Meshes != nullptr )
       && ( a3DModel->m_MaterialsSize > 0 ) && ( a3DModel->m_MeshesSize > 0 ) )
     {
@@ -1453,8 +1494,6 @@ void RENDER_3D_RAYTRACE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL*
             materialVector = getModelMaterial( a3DModel );
         }
 
-        const glm::mat3 normalMatrix = glm::transpose( glm::inverse( glm::mat3( aModelMatrix ) ) );
-
         for( unsigned int mesh_i = 0; mesh_i < a3DModel->m_MeshesSize; ++mesh_i )
         {
             const SMESH& mesh = a3DModel->m_Meshes[mesh_i];
@@ -1472,6 +1511,8 @@ void RENDER_3D_RAYTRACE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL*
               && ( mesh.m_VertexSize > 0 ) && ( ( mesh.m_FaceIdxSize % 3 ) == 0 )
               && ( mesh.m_MaterialIdx < a3DModel->m_MaterialsSize ) )
             {
+                geometry->AddVertices( mesh.m_Positions, mesh.m_VertexSize );
+
                 float                       fpTransparency;
                 const BLINN_PHONG_MATERIAL* blinn_material;
 
@@ -1487,8 +1528,13 @@ void RENDER_3D_RAYTRACE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL*
                 for( unsigned int faceIdx = 0; faceIdx < mesh.m_FaceIdxSize; faceIdx += 3 )
                 {
                     const unsigned int idx0 = mesh.m_FaceIdx[faceIdx + 0];
-                    const unsigned int idx1 = mesh.m_FaceIdx[faceIdx + 1];
-                    const unsigned int idx2 = mesh.m_FaceIdx[faceIdx + 2];
+                    unsigned int       idx1 = mesh.m_FaceIdx[faceIdx + 1];
+                    unsigned int       idx2 = mesh.m_FaceIdx[faceIdx + 2];
+
+                    // A mirrored placement turns the triangles around, swap two vertices so
+                    // they still face the same side in world space
+                    if( aMirrored )
+                        std::swap( idx1, idx2 );
 
                     wxASSERT( idx0 < mesh.m_VertexSize );
                     wxASSERT( idx1 < mesh.m_VertexSize );
@@ -1505,20 +1551,9 @@ void RENDER_3D_RAYTRACE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL*
                         const SFVEC3F& n1 = mesh.m_Normals[idx1];
                         const SFVEC3F& n2 = mesh.m_Normals[idx2];
 
-                        // Transform vertex with the model matrix
-                        const SFVEC3F vt0 = SFVEC3F( aModelMatrix * glm::vec4( v0, 1.0f ) );
-                        const SFVEC3F vt1 = SFVEC3F( aModelMatrix * glm::vec4( v1, 1.0f ) );
-                        const SFVEC3F vt2 = SFVEC3F( aModelMatrix * glm::vec4( v2, 1.0f ) );
-
-                        const SFVEC3F nt0 = glm::normalize( SFVEC3F( normalMatrix * n0 ) );
-                        const SFVEC3F nt1 = glm::normalize( SFVEC3F( normalMatrix * n1 ) );
-                        const SFVEC3F nt2 = glm::normalize( SFVEC3F( normalMatrix * n2 ) );
+                        TRIANGLE* newTriangle = new TRIANGLE( v0, v2, v1, n0, n2, n1 );
 
-                        TRIANGLE* newTriangle = new TRIANGLE( vt0, vt2, vt1, nt0, nt2, nt1 );
-
-                        newTriangle->SetBoardItem( aBoardItem );
-
-                        aDstContainer.Add( newTriangle );
+                        geometry->Add( newTriangle );
 
                         if( !aSkipMaterialInformation )
                         {
@@ -1562,4 +1597,8 @@ void RENDER_3D_RAYTRACE::addModels( CONTAINER_3D& aDstContainer, const S3DMODEL*
             }
         }
     }
+
+    geometry->Build();
+
+    return *geometry;
 }
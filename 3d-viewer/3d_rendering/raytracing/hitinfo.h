@@ -44,6 +44,11 @@ struct HITINFO
     SFVEC3F m_HitPoint;                 ///< (12) hit position
     float m_ShadowFactor;               ///< ( 4) Shadow attenuation (1.0 no shadow, 0.0f darkness)
 
+    /// Model instance that was hitted, only valid while pHitObject is pInstanceHitObject.
+    /// pHitObject is then the model triangle, in the space of the model.
+    const OBJECT_3D* pHitInstance = nullptr;
+    const OBJECT_3D* pInstanceHitObject = nullptr;
+
 #ifdef RAYTRACING_RAY_STATISTICS
     // Statistics
     unsigned int m_NrRayObjTests;       ///< Number of ray-objects tests
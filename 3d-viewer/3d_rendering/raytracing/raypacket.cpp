@@ -37,6 +37,22 @@ static void RAYPACKET_GenerateFrustum( FRUSTUM* m_Frustum, RAY* m_ray )
 }
 
 
+void RAYPACKET_SOA::Init( const RAY* aRays )
+{
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        const RAY& ray = aRays[i];
+
+        for( unsigned int axis = 0; axis < 3; ++axis )
+        {
+            m_Origin[axis][i] = ray.m_Origin[axis];
+            m_Dir[axis][i] = ray.m_Dir[axis];
+            m_InvDir[axis][i] = ray.m_InvDir[axis];
+        }
+    }
+}
+
+
 RAYPACKET::RAYPACKET( const CAMERA& aCamera, const SFVEC2I& aWindowsPosition )
 {
     unsigned int i = 0;
@@ -60,6 +76,7 @@ RAYPACKET::RAYPACKET( const CAMERA& aCamera, const SFVEC2I& aWindowsPosition )
     wxASSERT( i == RAYPACKET_RAYS_PER_PACKET );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    m_soa.Init( m_ray );
 }
 
 
@@ -68,6 +85,7 @@ RAYPACKET::RAYPACKET( const CAMERA& aCamera, const SFVEC2F& aWindowsPosition )
     RAYPACKET_InitRays( aCamera, aWindowsPosition, m_ray );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    m_soa.Init( m_ray );
 }
 
 
@@ -78,6 +96,7 @@ RAYPACKET::RAYPACKET( const CAMERA& aCamera, const SFVEC2F& aWindowsPosition,
                                            a2DWindowsPosDisplacementFactor, m_ray );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    m_soa.Init( m_ray );
 }
 
 
@@ -109,6 +128,7 @@ RAYPACKET::RAYPACKET( const CAMERA& aCamera, const SFVEC2I& aWindowsPosition,
     wxASSERT( i == RAYPACKET_RAYS_PER_PACKET );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    m_soa.Init( m_ray );
 }
 
 
@@ -137,6 +157,7 @@ RAYPACKET::RAYPACKET( const CAMERA& aCamera, const SFVEC2I& aWindowsPosition,
     wxASSERT( i == RAYPACKET_RAYS_PER_PACKET );
 
     RAYPACKET_GenerateFrustum( &m_Frustum, m_ray );
+    m_soa.Init( m_ray );
 }
 
 
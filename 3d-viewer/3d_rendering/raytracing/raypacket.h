@@ -28,6 +28,7 @@
 #include "ray.h"
 #include "frustum.h"
 #include "../camera.h"
+#include "raypacket_simd.h"
 
 #define RAYPACKET_DIM (1 << 3)
 #define RAYPACKET_MASK (unsigned int) ( ( RAYPACKET_DIM - 1 ) )
@@ -35,6 +36,10 @@
 #define RAYPACKET_RAYS_PER_PACKET ( RAYPACKET_DIM * RAYPACKET_DIM )
 
 
+static_assert( RAYPACKET_RAYS_PER_PACKET == RAYPACKET_SOA::RAYS,
+               "The packet kernels are built for 64 rays" );
+
+
 struct RAYPACKET
 {
     RAYPACKET( const CAMERA& aCamera, const SFVEC2I& aWindowsPosition );
@@ -50,8 +55,9 @@ struct RAYPACKET
     RAYPACKET( const CAMERA& aCamera, const SFVEC2F& aWindowsPosition,
                const SFVEC2F& a2DWindowsPosDisplacementFactor );
 
-    FRUSTUM     m_Frustum;
-    RAY         m_ray[RAYPACKET_RAYS_PER_PACKET];
+    FRUSTUM       m_Frustum;
+    RAY           m_ray[RAYPACKET_RAYS_PER_PACKET];
+    RAYPACKET_SOA m_soa;
 };
 
 void RAYPACKET_InitRays( const CAMERA& aCamera, const SFVEC2F& aWindowsPosition, RAY* aRayPck );
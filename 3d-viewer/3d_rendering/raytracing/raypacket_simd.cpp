@@ -0,0 +1,194 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file raypacket_simd.cpp
+ * @brief Plain C++ packet kernels and the selection of the kernels to use.
+ */
+
+#include "raypacket_simd_kernels.h"
+
+#include <atomic>
+#include <cmath>
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#define RAYPACKET_X86
+#endif
+
+#if defined( RAYPACKET_X86 ) && defined( _MSC_VER )
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+/// One ray at a time, used when no SIMD instruction set is available.
+struct SCALAR_LANES
+{
+    typedef float F;
+    typedef bool  M;
+
+    static constexpr unsigned int WIDTH = 1;
+
+    static F    Load( const float* aSrc ) { return *aSrc; }
+    static void Store( float* aDst, F aValue ) { *aDst = aValue; }
+    static F    Set1( float aValue ) { return aValue; }
+
+    static F Add( F a, F b ) { return a + b; }
+    static F Sub( F a, F b ) { return a - b; }
+    static F Mul( F a, F b ) { return a * b; }
+    static F Div( F a, F b ) { return a / b; }
+    static F Sqrt( F a ) { return std::sqrt( a ); }
+    static F Min( F a, F b ) { return a < b ? a : b; }
+    static F Max( F a, F b ) { return a > b ? a : b; }
+
+    static M CmpLt( F a, F b ) { return a < b; }
+    static M CmpLe( F a, F b ) { return a <= b; }
+    static M CmpGt( F a, F b ) { return a > b; }
+    static M CmpGe( F a, F b ) { return a >= b; }
+    static M CmpUnord( F a, F b ) { return std::isnan( a ) || std::isnan( b ); }
+
+    static M And( M a, M b ) { return a && b; }
+    static M Or( M a, M b ) { return a || b; }
+    static M AndNot( M aMask, M aRemove ) { return aMask && !aRemove; }
+    static F Select( M aMask, F aIfSet, F aIfClear ) { return aMask ? aIfSet : aIfClear; }
+
+    static unsigned int Bits( M aMask ) { return aMask ? 1 : 0; }
+};
+
+
+const RAYPACKET_KERNELS s_scalarKernels = RAYPACKET_LANE_KERNELS<SCALAR_LANES>::Kernels();
+
+std::atomic<const RAYPACKET_KERNELS*> s_kernels( nullptr );
+std::atomic<RAYPACKET_SIMD>           s_simd( RAYPACKET_SIMD::NONE );
+
+
+bool cpuHasAVX2()
+{
+#if defined( RAYPACKET_X86 ) && !defined( _MSC_VER )
+    // Also checks the OS saves the AVX registers
+    __builtin_cpu_init();
+    return __builtin_cpu_supports( "avx2" );
+#elif defined( RAYPACKET_X86 )
+    int info[4];
+
+    __cpuid( info, 0 );
+
+    if( info[0] < 7 )
+        return false;
+
+    __cpuid( info, 1 );
+
+    const bool osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+    const bool avx = ( info[2] & ( 1 << 28 ) ) != 0;
+
+    // The OS must save the YMM registers on context switches
+    if( !osxsave || !avx || ( _xgetbv( 0 ) & 0x6 ) != 0x6 )
+        return false;
+
+    __cpuidex( info, 7, 0 );
+
+    return ( info[1] & ( 1 << 5 ) ) != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+
+RAYPACKET_SIMD RAYPACKET_GetBestSimd()
+{
+    static const RAYPACKET_SIMD best = []()
+    {
+        if( cpuHasAVX2() && RAYPACKET_KernelsAVX2() )
+            return RAYPACKET_SIMD::AVX2;
+
+        // SSE2 kernels are only built when the whole program already requires SSE2
+        if( RAYPACKET_KernelsSSE2() )
+            return RAYPACKET_SIMD::SSE2;
+
+        return RAYPACKET_SIMD::NONE;
+    }();
+
+    return best;
+}
+
+
+RAYPACKET_SIMD RAYPACKET_SetSimd( RAYPACKET_SIMD aSimd )
+{
+    const RAYPACKET_SIMD best = RAYPACKET_GetBestSimd();
+
+    if( aSimd == RAYPACKET_SIMD::AVX2 && best != RAYPACKET_SIMD::AVX2 )
+        aSimd = best;
+
+    if( aSimd == RAYPACKET_SIMD::SSE2 && !RAYPACKET_KernelsSSE2() )
+        aSimd = RAYPACKET_SIMD::NONE;
+
+    const RAYPACKET_KERNELS* kernels = &s_scalarKernels;
+
+    if( aSimd == RAYPACKET_SIMD::AVX2 )
+        kernels = RAYPACKET_KernelsAVX2();
+    else if( aSimd == RAYPACKET_SIMD::SSE2 )
+        kernels = RAYPACKET_KernelsSSE2();
+
+    s_simd.store( aSimd );
+    s_kernels.store( kernels, std::memory_order_release );
+
+    return aSimd;
+}
+
+
+RAYPACKET_SIMD RAYPACKET_GetSimd()
+{
+    RAYPACKET_Kernels();
+
+    return s_simd.load();
+}
+
+
+const RAYPACKET_KERNELS& RAYPACKET_Kernels()
+{
+    const RAYPACKET_KERNELS* kernels = s_kernels.load( std::memory_order_acquire );
+
+    if( !kernels )
+    {
+        RAYPACKET_SetSimd( RAYPACKET_GetBestSimd() );
+        kernels = s_kernels.load( std::memory_order_acquire );
+    }
+
+    return *kernels;
+}
+
+
+const char* RAYPACKET_SimdName( RAYPACKET_SIMD aSimd )
+{
+    switch( aSimd )
+    {
+    case RAYPACKET_SIMD::SSE2: return "SSE2";
+    case RAYPACKET_SIMD::AVX2: return "AVX2";
+    default:                   return "none";
+    }
+}
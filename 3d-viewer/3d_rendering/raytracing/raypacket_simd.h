@@ -0,0 +1,236 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file raypacket_simd.h
+ * @brief Intersection kernels testing all the rays of a packet at once.
+ *
+ * The kernels work on the #RAYPACKET_SOA layout of a packet and return a bit mask of the
+ * rays that passed the test (bit i for ray i).  They are built several times, one per
+ * instruction set, and the best one the CPU supports is selected at run time.
+ *
+ * This header is also included by files built for instruction sets the CPU may not have, so
+ * it must not depend on other headers.
+ */
+
+#ifndef RAYPACKET_SIMD_H
+#define RAYPACKET_SIMD_H
+
+#include <cstdint>
+
+struct RAY;
+
+
+/**
+ * Structure-of-arrays copy of the rays of a packet.
+ *
+ * Each component is stored contiguously so the kernels can load the same component of
+ * consecutive rays at once.
+ */
+struct alignas( 32 ) RAYPACKET_SOA
+{
+    /// Number of rays in a packet, as RAYPACKET_RAYS_PER_PACKET.  Masks use one bit per ray.
+    static constexpr unsigned int RAYS = 64;
+
+    void Init( const RAY* aRays );
+
+    float m_Origin[3][RAYS];
+    float m_Dir[3][RAYS];
+    float m_InvDir[3][RAYS];
+};
+
+
+enum class RAYPACKET_SIMD
+{
+    NONE,   ///< Plain C++, one ray at a time
+    SSE2,   ///< 4 rays at a time
+    AVX2    ///< 8 rays at a time
+};
+
+
+/// Axis aligned box, see BBOX_3D.
+struct RAYPACKET_BOX
+{
+    float m_Min[3];
+    float m_Max[3];
+};
+
+
+/// Precomputed triangle, see TRIANGLE for the meaning of the values.
+struct RAYPACKET_TRIANGLE
+{
+    unsigned int m_K;
+    unsigned int m_Ku;
+    unsigned int m_Kv;
+    float        m_Nu, m_Nv, m_Nd;
+    float        m_Bnu, m_Bnv;
+    float        m_Cnu, m_Cnv;
+    float        m_Au, m_Av;        ///< First vertex on the m_Ku and m_Kv axis
+    float        m_Normal[3];
+};
+
+
+/// Vertical cylinder, see CYLINDER.
+struct RAYPACKET_CYLINDER
+{
+    float m_CenterX, m_CenterY;
+    float m_RadiusSquared;
+    float m_ZMin, m_ZMax;
+};
+
+
+/// Top and bottom faces of a vertical round segment, see ROUND_SEGMENT.
+struct RAYPACKET_ROUND_SEGMENT
+{
+    float m_StartX, m_StartY;
+    float m_EndX, m_EndY;
+    float m_EndMinusStartX, m_EndMinusStartY;
+    float m_DotEndMinusStart;
+    float m_RadiusSquared;
+    float m_ZMin, m_ZMax;
+};
+
+
+/**
+ * The intersection kernels of one instruction set.
+ *
+ * All of them test the rays from \a aFirst up to, but not including, \a aLast.  \a aTMax
+ * holds the current closest hit distance of each ray, a ray only hits if it is closer.
+ * Output arrays must hold RAYPACKET_SOA::RAYS values, only the values of the rays in
+ * the returned mask are meaningful.
+ */
+struct RAYPACKET_KERNELS
+{
+    /**
+     * Slab test of the rays against a box.
+     */
+    uint64_t ( *IntersectBox )( const RAYPACKET_SOA& aRays, const RAYPACKET_BOX& aBox,
+                                const float* aTMax, unsigned int aFirst, unsigned int aLast );
+
+    /**
+     * Ray / triangle test, with the barycentric coordinates of the hits in \a aOutU and
+     * \a aOutV.
+     */
+    uint64_t ( *IntersectTriangle )( const RAYPACKET_SOA& aRays,
+                                     const RAYPACKET_TRIANGLE& aTriangle, const float* aTMax,
+                                     unsigned int aFirst, unsigned int aLast, float* aOutT,
+                                     float* aOutU, float* aOutV );
+
+    /**
+     * Ray / vertical cylinder wall test.
+     */
+    uint64_t ( *IntersectCylinder )( const RAYPACKET_SOA& aRays,
+                                     const RAYPACKET_CYLINDER& aCylinder, const float* aTMax,
+                                     unsigned int aFirst, unsigned int aLast, float* aOutT );
+
+    /**
+     * Test the rays against the top and bottom faces of a round segment.
+     *
+     * Rays that neither hit a face nor can be rejected from the faces alone are returned in
+     * \a aOutUndecided, the side walls and round ends must be tested for them.
+     */
+    uint64_t ( *IntersectRoundSegmentFaces )( const RAYPACKET_SOA& aRays,
+                                              const RAYPACKET_ROUND_SEGMENT& aSegment,
+                                              const float* aTMax, unsigned int aFirst,
+                                              unsigned int aLast, float* aOutT,
+                                              uint64_t* aOutUndecided );
+};
+
+
+/**
+ * @return the kernels to use, for the instruction set chosen by RAYPACKET_SetSimd().
+ */
+const RAYPACKET_KERNELS& RAYPACKET_Kernels();
+
+/**
+ * @return the best instruction set supported by this build and the running CPU.
+ */
+RAYPACKET_SIMD RAYPACKET_GetBestSimd();
+
+/**
+ * @return the instruction set of the kernels in use.
+ */
+RAYPACKET_SIMD RAYPACKET_GetSimd();
+
+/**
+ * Select the instruction set of the kernels, for benchmarking and testing.  Unsupported
+ * instruction sets fall back to the best supported one.
+ *
+ * @return the instruction set actually selected.
+ */
+RAYPACKET_SIMD RAYPACKET_SetSimd( RAYPACKET_SIMD aSimd );
+
+/**
+ * @return a printable name of \a aSimd.
+ */
+const char* RAYPACKET_SimdName( RAYPACKET_SIMD aSimd );
+
+
+/**
+ * @return the index of the first ray of a non empty mask.
+ */
+inline unsigned int RAYPACKET_FirstRay( uint64_t aMask )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+    return (unsigned int) __builtin_ctzll( aMask );
+#else
+    unsigned int i = 0;
+
+    while( !( aMask & 1 ) )
+    {
+        aMask >>= 1;
+        ++i;
+    }
+
+    return i;
+#endif
+}
+
+
+/**
+ * @return the index of the last ray of a non empty mask.
+ */
+inline unsigned int RAYPACKET_LastRay( uint64_t aMask )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+    return 63 - (unsigned int) __builtin_clzll( aMask );
+#else
+    unsigned int i = 63;
+
+    while( !( aMask & ( (uint64_t) 1 << 63 ) ) )
+    {
+        aMask <<= 1;
+        --i;
+    }
+
+    return i;
+#endif
+}
+
+
+// Per instruction set kernel tables, nullptr when not available in this build.  They must
+// only be used after checking the CPU supports the instruction set.
+const RAYPACKET_KERNELS* RAYPACKET_KernelsSSE2();
+const RAYPACKET_KERNELS* RAYPACKET_KernelsAVX2();
+
+#endif // RAYPACKET_SIMD_H
@@ -0,0 +1,97 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file raypacket_simd_avx2.cpp
+ * @brief Packet kernels testing 8 rays at a time with AVX2.
+ *
+ * This file is built with AVX2 enabled (see 3d-viewer/CMakeLists.txt) while the rest of the
+ * program is not: its kernels are only called once the CPU has been checked.
+ */
+
+#include "raypacket_simd_kernels.h"
+
+#if defined( __AVX2__ )
+
+#include <immintrin.h>
+
+
+namespace
+{
+
+struct AVX2_LANES
+{
+    typedef __m256 F;
+    typedef __m256 M;
+
+    static constexpr unsigned int WIDTH = 8;
+
+    static F    Load( const float* aSrc ) { return _mm256_loadu_ps( aSrc ); }
+    static void Store( float* aDst, F aValue ) { _mm256_storeu_ps( aDst, aValue ); }
+    static F    Set1( float aValue ) { return _mm256_set1_ps( aValue ); }
+
+    static F Add( F a, F b ) { return _mm256_add_ps( a, b ); }
+    static F Sub( F a, F b ) { return _mm256_sub_ps( a, b ); }
+    static F Mul( F a, F b ) { return _mm256_mul_ps( a, b ); }
+    static F Div( F a, F b ) { return _mm256_div_ps( a, b ); }
+    static F Sqrt( F a ) { return _mm256_sqrt_ps( a ); }
+    static F Min( F a, F b ) { return _mm256_min_ps( a, b ); }
+    static F Max( F a, F b ) { return _mm256_max_ps( a, b ); }
+
+    static M CmpLt( F a, F b ) { return _mm256_cmp_ps( a, b, _CMP_LT_OQ ); }
+    static M CmpLe( F a, F b ) { return _mm256_cmp_ps( a, b, _CMP_LE_OQ ); }
+    static M CmpGt( F a, F b ) { return _mm256_cmp_ps( a, b, _CMP_GT_OQ ); }
+    static M CmpGe( F a, F b ) { return _mm256_cmp_ps( a, b, _CMP_GE_OQ ); }
+    static M CmpUnord( F a, F b ) { return _mm256_cmp_ps( a, b, _CMP_UNORD_Q ); }
+
+    static M And( M a, M b ) { return _mm256_and_ps( a, b ); }
+    static M Or( M a, M b ) { return _mm256_or_ps( a, b ); }
+    static M AndNot( M aMask, M aRemove ) { return _mm256_andnot_ps( aRemove, aMask ); }
+
+    static F Select( M aMask, F aIfSet, F aIfClear )
+    {
+        return _mm256_blendv_ps( aIfClear, aIfSet, aMask );
+    }
+
+    static unsigned int Bits( M aMask ) { return (unsigned int) _mm256_movemask_ps( aMask ); }
+};
+
+
+constexpr RAYPACKET_KERNELS s_kernels = RAYPACKET_LANE_KERNELS<AVX2_LANES>::Kernels();
+
+} // namespace
+
+
+const RAYPACKET_KERNELS* RAYPACKET_KernelsAVX2()
+{
+    return &s_kernels;
+}
+
+#else
+
+const RAYPACKET_KERNELS* RAYPACKET_KernelsAVX2()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,348 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file raypacket_simd_kernels.h
+ * @brief Packet intersection kernels, written once for any lane width.
+ *
+ * This file is only included by the files building the kernels of one instruction set.
+ * LANES provides the vector type and operations:
+ *
+ *  - F and M, the float and comparison mask vectors, and WIDTH, their number of lanes.
+ *  - Load(), Store() and Set1().
+ *  - Add(), Sub(), Mul(), Div(), Sqrt(), Min() and Max().
+ *  - CmpLt(), CmpLe(), CmpGt(), CmpGe() and CmpUnord().
+ *  - And(), Or(), AndNot( aMask, aRemove ) and Select( aMask, aIfSet, aIfClear ).
+ *  - Bits(), the mask as one bit per lane.
+ *
+ * The files building the kernels may be compiled for an instruction set the CPU does not
+ * have.  Only LANES and the plain data structures of raypacket_simd.h may be used here, an
+ * inline function of another header would be built with that instruction set too and could
+ * be the copy the linker keeps for the whole program.
+ */
+
+#ifndef RAYPACKET_SIMD_KERNELS_H
+#define RAYPACKET_SIMD_KERNELS_H
+
+#include "raypacket_simd.h"
+#include <cfloat>
+
+
+template <typename LANES>
+struct RAYPACKET_LANE_KERNELS
+{
+    typedef typename LANES::F F;
+    typedef typename LANES::M M;
+
+    static constexpr unsigned int WIDTH = LANES::WIDTH;
+    static constexpr uint64_t     LANE_BITS = ( (uint64_t) 1 << WIDTH ) - 1;
+
+
+    /// @return the mask of the rays aFirst to aLast - 1.
+    static uint64_t rangeMask( unsigned int aFirst, unsigned int aLast )
+    {
+        if( aFirst >= aLast )
+            return 0;
+
+        const uint64_t below = ( aLast >= RAYPACKET_SOA::RAYS )
+                                       ? ~(uint64_t) 0
+                                       : ( (uint64_t) 1 << aLast ) - 1;
+
+        return below & ( ~(uint64_t) 0 << aFirst );
+    }
+
+
+    /// @return the first ray of the block holding \a aFirst.
+    static unsigned int firstBlock( unsigned int aFirst ) { return aFirst & ~( WIDTH - 1 ); }
+
+
+    static uint64_t IntersectBox( const RAYPACKET_SOA& aRays, const RAYPACKET_BOX& aBox,
+                                  const float* aTMax, unsigned int aFirst, unsigned int aLast )
+    {
+        const F zero = LANES::Set1( 0.0f );
+        const F minusInf = LANES::Set1( -FLT_MAX );
+        const F plusInf = LANES::Set1( FLT_MAX );
+
+        uint64_t hits = 0;
+
+        for( unsigned int i = firstBlock( aFirst ); i < aLast; i += WIDTH )
+        {
+            F tNear = zero;
+            F tFar = LANES::Load( aTMax + i );
+
+            for( unsigned int axis = 0; axis < 3; ++axis )
+            {
+                const F org = LANES::Load( aRays.m_Origin[axis] + i );
+                const F invDir = LANES::Load( aRays.m_InvDir[axis] + i );
+                const F t0 = LANES::Mul( LANES::Sub( LANES::Set1( aBox.m_Min[axis] ), org ),
+                                         invDir );
+                const F t1 = LANES::Mul( LANES::Sub( LANES::Set1( aBox.m_Max[axis] ), org ),
+                                         invDir );
+
+                // A ray parallel to the slab and starting on one of its planes gives a NaN
+                // distance: keep it as if it was inside the slab.
+                const M onPlane = LANES::CmpUnord( t0, t1 );
+
+                tNear = LANES::Max( tNear, LANES::Select( onPlane, minusInf,
+                                                          LANES::Min( t0, t1 ) ) );
+                tFar = LANES::Min( tFar, LANES::Select( onPlane, plusInf,
+                                                        LANES::Max( t0, t1 ) ) );
+            }
+
+            hits |= (uint64_t) LANES::Bits( LANES::CmpLe( tNear, tFar ) ) << i;
+        }
+
+        return hits & rangeMask( aFirst, aLast );
+    }
+
+
+    static uint64_t IntersectTriangle( const RAYPACKET_SOA& aRays,
+                                       const RAYPACKET_TRIANGLE& aTriangle, const float* aTMax,
+                                       unsigned int aFirst, unsigned int aLast, float* aOutT,
+                                       float* aOutU, float* aOutV )
+    {
+        const float* orgK = aRays.m_Origin[aTriangle.m_K];
+        const float* orgU = aRays.m_Origin[aTriangle.m_Ku];
+        const float* orgV = aRays.m_Origin[aTriangle.m_Kv];
+        const float* dirK = aRays.m_Dir[aTriangle.m_K];
+        const float* dirU = aRays.m_Dir[aTriangle.m_Ku];
+        const float* dirV = aRays.m_Dir[aTriangle.m_Kv];
+
+        const F zero = LANES::Set1( 0.0f );
+        const F one = LANES::Set1( 1.0f );
+        const F nu = LANES::Set1( aTriangle.m_Nu );
+        const F nv = LANES::Set1( aTriangle.m_Nv );
+        const F nd = LANES::Set1( aTriangle.m_Nd );
+        const F bnu = LANES::Set1( aTriangle.m_Bnu );
+        const F bnv = LANES::Set1( aTriangle.m_Bnv );
+        const F cnu = LANES::Set1( aTriangle.m_Cnu );
+        const F cnv = LANES::Set1( aTriangle.m_Cnv );
+        const F au = LANES::Set1( aTriangle.m_Au );
+        const F av = LANES::Set1( aTriangle.m_Av );
+        const F nx = LANES::Set1( aTriangle.m_Normal[0] );
+        const F ny = LANES::Set1( aTriangle.m_Normal[1] );
+        const F nz = LANES::Set1( aTriangle.m_Normal[2] );
+
+        uint64_t hits = 0;
+
+        for( unsigned int i = firstBlock( aFirst ); i < aLast; i += WIDTH )
+        {
+            const F ok = LANES::Load( orgK + i );
+            const F ou = LANES::Load( orgU + i );
+            const F ov = LANES::Load( orgV + i );
+            const F dk = LANES::Load( dirK + i );
+            const F du = LANES::Load( dirU + i );
+            const F dv = LANES::Load( dirV + i );
+
+            // Same operations, in the same order, as TRIANGLE::Intersect()
+            const F lnd = LANES::Div( one, LANES::Add( LANES::Add( dk, LANES::Mul( nu, du ) ),
+                                                       LANES::Mul( nv, dv ) ) );
+            const F t = LANES::Mul( LANES::Sub( LANES::Sub( LANES::Sub( nd, ok ),
+                                                            LANES::Mul( nu, ou ) ),
+                                                LANES::Mul( nv, ov ) ),
+                                    lnd );
+
+            M hit = LANES::And( LANES::CmpGt( LANES::Load( aTMax + i ), t ),
+                                LANES::CmpGt( t, zero ) );
+
+            const F hu = LANES::Sub( LANES::Add( ou, LANES::Mul( t, du ) ), au );
+            const F hv = LANES::Sub( LANES::Add( ov, LANES::Mul( t, dv ) ), av );
+            const F beta = LANES::Add( LANES::Mul( hv, bnu ), LANES::Mul( hu, bnv ) );
+            const F gamma = LANES::Add( LANES::Mul( hu, cnu ), LANES::Mul( hv, cnv ) );
+
+            hit = LANES::AndNot( hit, LANES::CmpLt( beta, zero ) );
+            hit = LANES::AndNot( hit, LANES::CmpLt( gamma, zero ) );
+            hit = LANES::AndNot( hit, LANES::CmpGt( LANES::Add( beta, gamma ), one ) );
+
+            // Back facing triangles are not hit
+            const F dx = LANES::Load( aRays.m_Dir[0] + i );
+            const F dy = LANES::Load( aRays.m_Dir[1] + i );
+            const F dz = LANES::Load( aRays.m_Dir[2] + i );
+            const F dirDotN = LANES::Add( LANES::Add( LANES::Mul( dx, nx ), LANES::Mul( dy, ny ) ),
+                                          LANES::Mul( dz, nz ) );
+
+            hit = LANES::AndNot( hit, LANES::CmpGt( dirDotN, zero ) );
+
+            LANES::Store( aOutT + i, t );
+            LANES::Store( aOutU + i, beta );
+            LANES::Store( aOutV + i, gamma );
+
+            hits |= (uint64_t) LANES::Bits( hit ) << i;
+        }
+
+        return hits & rangeMask( aFirst, aLast );
+    }
+
+
+    static uint64_t IntersectCylinder( const RAYPACKET_SOA& aRays,
+                                       const RAYPACKET_CYLINDER& aCylinder, const float* aTMax,
+                                       unsigned int aFirst, unsigned int aLast, float* aOutT )
+    {
+        const F zero = LANES::Set1( 0.0f );
+        const F one = LANES::Set1( 1.0f );
+        const F epsilon = LANES::Set1( FLT_EPSILON );
+        const F centerX = LANES::Set1( aCylinder.m_CenterX );
+        const F centerY = LANES::Set1( aCylinder.m_CenterY );
+        const F radiusSquared = LANES::Set1( aCylinder.m_RadiusSquared );
+        const F zMin = LANES::Set1( aCylinder.m_ZMin );
+        const F zMax = LANES::Set1( aCylinder.m_ZMax );
+
+        uint64_t hits = 0;
+
+        for( unsigned int i = firstBlock( aFirst ); i < aLast; i += WIDTH )
+        {
+            const F dx = LANES::Load( aRays.m_Dir[0] + i );
+            const F dy = LANES::Load( aRays.m_Dir[1] + i );
+            const F dz = LANES::Load( aRays.m_Dir[2] + i );
+            const F ocx = LANES::Sub( LANES::Load( aRays.m_Origin[0] + i ), centerX );
+            const F ocy = LANES::Sub( LANES::Load( aRays.m_Origin[1] + i ), centerY );
+            const F oz = LANES::Load( aRays.m_Origin[2] + i );
+            const F tMax = LANES::Load( aTMax + i );
+
+            const F a = LANES::Add( LANES::Mul( dx, dx ), LANES::Mul( dy, dy ) );
+            const F b = LANES::Add( LANES::Mul( dx, ocx ), LANES::Mul( dy, ocy ) );
+
+            // CYLINDER::Intersect() computes b * b - a * c with doubles to avoid the
+            // cancellation of two large products.  Lagrange's identity gives the same value
+            // as a * r^2 - cross( d, oc )^2, which does not lose precision in floats.
+            const F cross = LANES::Sub( LANES::Mul( dx, ocy ), LANES::Mul( dy, ocx ) );
+            const F delta = LANES::Sub( LANES::Mul( a, radiusSquared ),
+                                        LANES::Mul( cross, cross ) );
+
+            const M valid = LANES::CmpGt( delta, epsilon );
+            const F sdelta = LANES::Sqrt( LANES::Max( delta, zero ) );
+            const F invA = LANES::Div( one, a );
+            const F minusB = LANES::Sub( zero, b );
+
+            const F t0 = LANES::Mul( LANES::Sub( minusB, sdelta ), invA );
+            const F z0 = LANES::Add( oz, LANES::Mul( t0, dz ) );
+            const M hit0 = LANES::And( LANES::And( valid, LANES::CmpLt( t0, tMax ) ),
+                                       LANES::And( LANES::CmpGe( z0, zMin ),
+                                                   LANES::CmpLe( z0, zMax ) ) );
+
+            const F t1 = LANES::Mul( LANES::Add( minusB, sdelta ), invA );
+            const F z1 = LANES::Add( oz, LANES::Mul( t1, dz ) );
+            const M hit1 = LANES::And( LANES::And( valid, LANES::CmpLt( t1, tMax ) ),
+                                       LANES::And( LANES::CmpGt( z1, zMin ),
+                                                   LANES::CmpLt( z1, zMax ) ) );
+
+            LANES::Store( aOutT + i, LANES::Select( hit0, t0, t1 ) );
+
+            hits |= (uint64_t) LANES::Bits( LANES::Or( hit0, hit1 ) ) << i;
+        }
+
+        return hits & rangeMask( aFirst, aLast );
+    }
+
+
+    static uint64_t IntersectRoundSegmentFaces( const RAYPACKET_SOA& aRays,
+                                                const RAYPACKET_ROUND_SEGMENT& aSegment,
+                                                const float* aTMax, unsigned int aFirst,
+                                                unsigned int aLast, float* aOutT,
+                                                uint64_t* aOutUndecided )
+    {
+        const F zero = LANES::Set1( 0.0f );
+        const F epsilon = LANES::Set1( FLT_EPSILON );
+        const F startX = LANES::Set1( aSegment.m_StartX );
+        const F startY = LANES::Set1( aSegment.m_StartY );
+        const F endX = LANES::Set1( aSegment.m_EndX );
+        const F endY = LANES::Set1( aSegment.m_EndY );
+        const F segX = LANES::Set1( aSegment.m_EndMinusStartX );
+        const F segY = LANES::Set1( aSegment.m_EndMinusStartY );
+        const F segDot = LANES::Set1( aSegment.m_DotEndMinusStart );
+        const F radiusSquared = LANES::Set1( aSegment.m_RadiusSquared );
+        const F zMin = LANES::Set1( aSegment.m_ZMin );
+        const F zMax = LANES::Set1( aSegment.m_ZMax );
+
+        uint64_t hits = 0;
+        uint64_t undecided = 0;
+
+        for( unsigned int i = firstBlock( aFirst ); i < aLast; i += WIDTH )
+        {
+            const F dx = LANES::Load( aRays.m_Dir[0] + i );
+            const F dy = LANES::Load( aRays.m_Dir[1] + i );
+            const F dz = LANES::Load( aRays.m_Dir[2] + i );
+
+            // The face seen by the ray: the top one when going down
+            const F zPlane = LANES::Select( LANES::CmpLt( dz, zero ), zMax, zMin );
+            const F tPlane = LANES::Mul( LANES::Sub( zPlane,
+                                                     LANES::Load( aRays.m_Origin[2] + i ) ),
+                                         LANES::Load( aRays.m_InvDir[2] + i ) );
+
+            const M reject = LANES::Or( LANES::CmpGe( tPlane, LANES::Load( aTMax + i ) ),
+                                        LANES::CmpLt( tPlane, epsilon ) );
+
+            const F px = LANES::Add( LANES::Load( aRays.m_Origin[0] + i ),
+                                     LANES::Mul( dx, tPlane ) );
+            const F py = LANES::Add( LANES::Load( aRays.m_Origin[1] + i ),
+                                     LANES::Mul( dy, tPlane ) );
+
+            // Distance to the segment, as RAYSEG2D::DistanceToPointSquared()
+            const F fromStartX = LANES::Sub( px, startX );
+            const F fromStartY = LANES::Sub( py, startY );
+            const F c1 = LANES::Add( LANES::Mul( fromStartX, segX ),
+                                     LANES::Mul( fromStartY, segY ) );
+
+            const F distStart = LANES::Add( LANES::Mul( fromStartX, fromStartX ),
+                                            LANES::Mul( fromStartY, fromStartY ) );
+
+            const F fromEndX = LANES::Sub( px, endX );
+            const F fromEndY = LANES::Sub( py, endY );
+            const F distEnd = LANES::Add( LANES::Mul( fromEndX, fromEndX ),
+                                          LANES::Mul( fromEndY, fromEndY ) );
+
+            const F b = LANES::Div( c1, segDot );
+            const F fromProjX = LANES::Sub( px, LANES::Add( startX, LANES::Mul( segX, b ) ) );
+            const F fromProjY = LANES::Sub( py, LANES::Add( startY, LANES::Mul( segY, b ) ) );
+            const F distProj = LANES::Add( LANES::Mul( fromProjX, fromProjX ),
+                                           LANES::Mul( fromProjY, fromProjY ) );
+
+            F distSquared = LANES::Select( LANES::CmpLe( segDot, c1 ), distEnd, distProj );
+            distSquared = LANES::Select( LANES::CmpLt( c1, epsilon ), distStart, distSquared );
+
+            const uint64_t rejectBits = LANES::Bits( reject );
+            const uint64_t insideBits = LANES::Bits( LANES::CmpLe( distSquared,
+                                                                   radiusSquared ) );
+
+            LANES::Store( aOutT + i, tPlane );
+
+            hits |= ( insideBits & ~rejectBits ) << i;
+            undecided |= ( ~insideBits & ~rejectBits & LANE_BITS ) << i;
+        }
+
+        const uint64_t range = rangeMask( aFirst, aLast );
+
+        *aOutUndecided = undecided & range;
+
+        return hits & range;
+    }
+
+
+    static constexpr RAYPACKET_KERNELS Kernels()
+    {
+        return { &IntersectBox, &IntersectTriangle, &IntersectCylinder,
+                 &IntersectRoundSegmentFaces };
+    }
+};
+
+#endif // RAYPACKET_SIMD_KERNELS_H
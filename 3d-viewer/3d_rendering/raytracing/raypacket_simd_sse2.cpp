@@ -0,0 +1,94 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file raypacket_simd_sse2.cpp
+ * @brief Packet kernels testing 4 rays at a time with SSE2.
+ */
+
+#include "raypacket_simd_kernels.h"
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+
+#include <emmintrin.h>
+
+
+namespace
+{
+
+struct SSE2_LANES
+{
+    typedef __m128 F;
+    typedef __m128 M;
+
+    static constexpr unsigned int WIDTH = 4;
+
+    static F    Load( const float* aSrc ) { return _mm_loadu_ps( aSrc ); }
+    static void Store( float* aDst, F aValue ) { _mm_storeu_ps( aDst, aValue ); }
+    static F    Set1( float aValue ) { return _mm_set1_ps( aValue ); }
+
+    static F Add( F a, F b ) { return _mm_add_ps( a, b ); }
+    static F Sub( F a, F b ) { return _mm_sub_ps( a, b ); }
+    static F Mul( F a, F b ) { return _mm_mul_ps( a, b ); }
+    static F Div( F a, F b ) { return _mm_div_ps( a, b ); }
+    static F Sqrt( F a ) { return _mm_sqrt_ps( a ); }
+    static F Min( F a, F b ) { return _mm_min_ps( a, b ); }
+    static F Max( F a, F b ) { return _mm_max_ps( a, b ); }
+
+    static M CmpLt( F a, F b ) { return _mm_cmplt_ps( a, b ); }
+    static M CmpLe( F a, F b ) { return _mm_cmple_ps( a, b ); }
+    static M CmpGt( F a, F b ) { return _mm_cmpgt_ps( a, b ); }
+    static M CmpGe( F a, F b ) { return _mm_cmpge_ps( a, b ); }
+    static M CmpUnord( F a, F b ) { return _mm_cmpunord_ps( a, b ); }
+
+    static M And( M a, M b ) { return _mm_and_ps( a, b ); }
+    static M Or( M a, M b ) { return _mm_or_ps( a, b ); }
+    static M AndNot( M aMask, M aRemove ) { return _mm_andnot_ps( aRemove, aMask ); }
+
+    static F Select( M aMask, F aIfSet, F aIfClear )
+    {
+        return _mm_or_ps( _mm_and_ps( aMask, aIfSet ), _mm_andnot_ps( aMask, aIfClear ) );
+    }
+
+    static unsigned int Bits( M aMask ) { return (unsigned int) _mm_movemask_ps( aMask ); }
+};
+
+
+constexpr RAYPACKET_KERNELS s_kernels = RAYPACKET_LANE_KERNELS<SSE2_LANES>::Kernels();
+
+} // namespace
+
+
+const RAYPACKET_KERNELS* RAYPACKET_KernelsSSE2()
+{
+    return &s_kernels;
+}
+
+#else
+
+const RAYPACKET_KERNELS* RAYPACKET_KernelsSSE2()
+{
+    return nullptr;
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include <atomic>
 #include <chrono>
 #include <climits>
+#include <future>
 #include <thread>
 
 #include "render_3d_raytrace.h"
@@ -37,6 +38,8 @@
 #include "3d_math.h"
 #include "../common_ogl/ogl_utils.h"
 #include <profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <thread_pool.h>
+#include <wx/image.h>
 #include <wx/log.h>
 
 
@@ -169,7 +172,7 @@ bool RENDER_3D_RAYTRACE::Redraw( bool aIsMoving, REPORTER* aStatusReporter,
     std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
 
     // Reload board if it was requested
-    if( m_reloadRequested )
+    if( m_reloadRequested || IsUpdateRequestPending() )
     {
         if( aStatusReporter )
             aStatusReporter->Report( _( "Loading..." ) );
@@ -342,6 +345,94 @@ void RENDER_3D_RAYTRACE::render( GLubyte* ptrPBO, REPORTER* aStatusReporter )
 }
 
 
+void RENDER_3D_RAYTRACE::RenderImage( const wxSize& aSize, wxImage& aImage,
+                                      REPORTER* aStatusReporter, REPORTER* aWarningReporter )
+{
+    if( m_reloadRequested || IsUpdateRequestPending() )
+        Reload( aStatusReporter, aWarningReporter, false );
+
+    m_windowSize = aSize;
+    m_camera.SetCurWindowSize( aSize );
+
+    // Trace whole packets and leave the extra pixels out of the image
+    m_realBufferSize.x = ( aSize.x + RAYPACKET_DIM - 1 ) & RAYPACKET_INVMASK;
+    m_realBufferSize.y = ( aSize.y + RAYPACKET_DIM - 1 ) & RAYPACKET_INVMASK;
+    m_xoffset = 0;
+    m_yoffset = 0;
+
+    initializeTracingBuffers();
+
+    std::vector<GLubyte> buffer( (size_t) m_realBufferSize.x * m_realBufferSize.y * 4 );
+
+    restartRenderState();
+
+    if( m_cameraLight )
+        m_cameraLight->SetDirection( -m_camera.GetDir() );
+
+    m_backgroundColorTop = ConvertSRGBToLinear( (SFVEC3F)m_boardAdapter.m_BgColorTop );
+    m_backgroundColorBottom = ConvertSRGBToLinear( (SFVEC3F)m_boardAdapter.m_BgColorBot );
+
+    if( aStatusReporter )
+        aStatusReporter->Report( _( "Rendering: tracing" ) );
+
+    // There is no display to update, so trace all the blocks in one go
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::atomic<size_t>            nextBlock( 0 );
+    std::vector<std::future<void>> returns;
+
+    for( size_t ii = 0; ii < tp.get_thread_count(); ++ii )
+    {
+        returns.emplace_back( tp.submit( [&]()
+                {
+                    for( size_t iBlock = nextBlock.fetch_add( 1 );
+                         iBlock < m_blockPositions.size();
+                         iBlock = nextBlock.fetch_add( 1 ) )
+                    {
+                        renderBlockTracing( buffer.data(), iBlock );
+                    }
+                } ) );
+    }
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
+
+    m_blockRenderProgressCount = m_blockPositions.size();
+
+    if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
+    {
+        postProcessShading( buffer.data(), aStatusReporter );
+        postProcessBlurFinish( buffer.data(), aStatusReporter );
+    }
+
+    m_renderState = RT_RENDER_STATE_FINISH;
+
+    // The buffer is stored bottom row first, as OpenGL draws it
+    aImage.Create( aSize.x, aSize.y, false );
+
+    unsigned char* rgb = aImage.GetData();
+
+    for( int y = 0; y < aSize.y; ++y )
+    {
+        const GLubyte* src = &buffer[( (size_t) ( aSize.y - 1 - y ) * m_realBufferSize.x ) * 4];
+
+        for( int x = 0; x < aSize.x; ++x, src += 4, rgb += 3 )
+        {
+            rgb[0] = src[0];
+            rgb[1] = src[1];
+            rgb[2] = src[2];
+        }
+    }
+
+    if( aStatusReporter )
+    {
+        // Calculation time in seconds
+        const double elapsed_time = (double)( GetRunningMicroSecs() - m_renderStartTime ) / 1e6;
+
+        aStatusReporter->Report( wxString::Format( _( "Rendering time %.3f s" ), elapsed_time ) );
+    }
+}
+
+
 void RENDER_3D_RAYTRACE::renderTracing( GLubyte* ptrPBO, REPORTER* aStatusReporter )
 {
     m_isPreview = false;
@@ -477,6 +568,19 @@ static void HITINFO_PACKET_init( HITINFO_PACKET* aHitPacket )
 }
 
 
+/**
+ * @return the object of the scene that was hit, which is the model instance when the hit
+ *         object is the triangle of a shared 3D model.
+ */
+static const OBJECT_3D* hitSceneObject( const HITINFO& aHitInfo )
+{
+    if( aHitInfo.pHitInstance && aHitInfo.pInstanceHitObject == aHitInfo.pHitObject )
+        return aHitInfo.pHitInstance;
+
+    return aHitInfo.pHitObject;
+}
+
+
 void RENDER_3D_RAYTRACE::renderRayPackets( const SFVEC3F* bgColorY, const RAY* aRayPkt,
                                            HITINFO_PACKET* aHitPacket, bool is_testShadow,
                                            SFVEC3F* aOutHitColor )
@@ -1406,9 +1510,10 @@ void RENDER_3D_RAYTRACE::renderPreview( GLubyte* ptrPBO )
                             bool hitted = false;
 
                             if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayLTC, hitInfoLTC );
+                                hitted = hitSceneObject( centerHitInfo )->Intersect( rayLTC,
+                                                                                     hitInfoLTC );
                             else if( hitPacket[ iLT ].m_hitresult )
-                                hitted = hitPacket[ iLT ].m_HitInfo.pHitObject->Intersect(
+                                hitted = hitSceneObject( hitPacket[ iLT ].m_HitInfo )->Intersect(
                                         rayLTC,
                                         hitInfoLTC );
 
@@ -1433,10 +1538,12 @@ void RENDER_3D_RAYTRACE::renderPreview( GLubyte* ptrPBO )
                             bool hitted = false;
 
                             if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayRTC, hitInfoRTC );
+                                hitted = hitSceneObject( centerHitInfo )->Intersect( rayRTC,
+                                                                                     hitInfoRTC );
                             else if( hitPacket[ iRT ].m_hitresult )
-                                hitted = hitPacket[ iRT ].m_HitInfo.pHitObject->Intersect( rayRTC,
-                                                                                           hitInfoRTC );
+                                hitted = hitSceneObject( hitPacket[ iRT ].m_HitInfo )->Intersect(
+                                        rayRTC,
+                                        hitInfoRTC );
 
                             if( hitted )
                                 cRTC = COLOR_RGB( shadeHit( bgColorY, rayRTC, hitInfoRTC, false,
@@ -1459,10 +1566,12 @@ void RENDER_3D_RAYTRACE::renderPreview( GLubyte* ptrPBO )
                             bool hitted = false;
 
                             if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayLBC, hitInfoLBC );
+                                hitted = hitSceneObject( centerHitInfo )->Intersect( rayLBC,
+                                                                                     hitInfoLBC );
                             else if( hitPacket[ iLB ].m_hitresult )
-                                hitted = hitPacket[ iLB ].m_HitInfo.pHitObject->Intersect( rayLBC,
-                                                                                           hitInfoLBC );
+                                hitted = hitSceneObject( hitPacket[ iLB ].m_HitInfo )->Intersect(
+                                        rayLBC,
+                                        hitInfoLBC );
 
                             if( hitted )
                                 cLBC = COLOR_RGB( shadeHit( bgColorY, rayLBC, hitInfoLBC, false,
@@ -1485,10 +1594,12 @@ void RENDER_3D_RAYTRACE::renderPreview( GLubyte* ptrPBO )
                             bool hitted = false;
 
                             if( hittedC )
-                                hitted = centerHitInfo.pHitObject->Intersect( rayRBC, hitInfoRBC );
+                                hitted = hitSceneObject( centerHitInfo )->Intersect( rayRBC,
+                                                                                     hitInfoRBC );
                             else if( hitPacket[ iRB ].m_hitresult )
-                                hitted = hitPacket[ iRB ].m_HitInfo.pHitObject->Intersect( rayRBC,
-                                                                                           hitInfoRBC );
+                                hitted = hitSceneObject( hitPacket[ iRB ].m_HitInfo )->Intersect(
+                                        rayRBC,
+                                        hitInfoRBC );
 
                             if( hitted )
                                 cRBC = COLOR_RGB( shadeHit( bgColorY, rayRBC, hitInfoRBC, false,
@@ -1895,6 +2006,13 @@ void RENDER_3D_RAYTRACE::initializeBlockPositions()
     m_xoffset = ( m_windowSize.x - m_realBufferSize.x ) / 2;
     m_yoffset = ( m_windowSize.y - m_realBufferSize.y ) / 2;
 
+    initializeTracingBuffers();
+    initPbo();
+}
+
+
+void RENDER_3D_RAYTRACE::initializeTracingBuffers()
+{
     m_postShaderSsao.UpdateSize( m_realBufferSize );
 
     // Calc block positions for regular rendering. Choose an 'inside out' style of rendering.
@@ -1919,8 +2037,6 @@ void RENDER_3D_RAYTRACE::initializeBlockPositions()
     // Create m_shader buffer
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
-
-    initPbo();
 }
 
 
@@ -1934,7 +2050,7 @@ BOARD_ITEM* RENDER_3D_RAYTRACE::IntersectBoardItem( const RAY& aRay )
         if( m_accelerator->Intersect( aRay, hitInfo ) )
         {
             if( hitInfo.pHitObject )
-                return hitInfo.pHitObject->GetBoardItem();
+                return hitSceneObject( hitInfo )->GetBoardItem();
         }
     }
 
@@ -32,9 +32,14 @@
 #include "light.h"
 #include "../post_shader_ssao.h"
 #include "material.h"
+#include "shapes3D/model_instance_3d.h"
 #include <plugins/3dapi/c3dmodel.h>
 
 #include <map>
+#include <memory>
+#include <tuple>
+
+class wxImage;
 
 /// Vector of materials
 typedef std::vector< BLINN_PHONG_MATERIAL > MODEL_MATERIALS;
@@ -42,6 +47,10 @@ typedef std::vector< BLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 /// Maps a S3DMODEL pointer with a created BLINN_PHONG_MATERIAL vector
 typedef std::map< const S3DMODEL* , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 
+/// Maps a S3DMODEL pointer, its opacity and if it is mirrored with its shared geometry
+typedef std::map< std::tuple<const S3DMODEL*, float, bool>,
+                  std::unique_ptr<MODEL_GEOMETRY_3D> > MAP_MODEL_GEOMETRY;
+
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
@@ -73,6 +82,18 @@ public:
 
     BOARD_ITEM *IntersectBoardItem( const RAY& aRay );
 
+    /**
+     * Render a full quality frame without OpenGL, for use without a display.
+     *
+     * The board is loaded first if a reload is pending.  All the blocks are traced on the
+     * thread pool.
+     *
+     * @param aSize is the size of the image in pixels.
+     * @param aImage receives the rendered image.
+     */
+    void RenderImage( const wxSize& aSize, wxImage& aImage, REPORTER* aStatusReporter,
+                      REPORTER* aWarningReporter );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
@@ -123,8 +144,23 @@ private:
 
     MODEL_MATERIALS* getModelMaterial( const S3DMODEL* a3DModel );
 
+    /**
+     * Get the triangles of \a a3DModel in the space of the model, creating them the first time.
+     *
+     * @param aMirrored is true for placements with a mirroring transformation, which need the
+     *                  triangles with the opposite winding.
+     */
+    const MODEL_GEOMETRY_3D& getModelGeometry( const S3DMODEL* a3DModel, float aFPOpacity,
+                                               bool aMirrored, bool aSkipMaterialInformation );
+
     void initializeBlockPositions();
 
+    /**
+     * Set up the blocks to trace and the post processing buffers for the current
+     * m_realBufferSize.
+     */
+    void initializeTracingBuffers();
+
     void render( GLubyte* ptrPBO, REPORTER* aStatusReporter );
     void renderPreview( GLubyte* ptrPBO );
 
@@ -209,6 +245,9 @@ private:
     /// Stores materials of the 3D models
     MAP_MODEL_MATERIALS m_modelMaterialMap;
 
+    /// Stores the geometry of the 3D models, shared by all their placements
+    MAP_MODEL_GEOMETRY m_modelGeometryMap;
+
     // Statistics
     unsigned int m_convertedDummyBlockCount;
     unsigned int m_converted2dRoundSegmentCount;
@@ -29,6 +29,7 @@
 
 #include "3d_fastmath.h"
 #include "cylinder_3d.h"
+#include "../raypacket_simd.h"
 
 
 CYLINDER::CYLINDER( SFVEC2F aCenterPoint, float aZmin, float aZmax, float aRadius )
@@ -98,20 +99,54 @@ bool CYLINDER::Intersect( const RAY& aRay, HITINFO& aHitInfo ) const
     }
 
     if( hitResult )
-    {
-        aHitInfo.m_HitPoint = aRay.at( aHitInfo.m_tHit );
+        fillHitInfo( aRay, aHitInfo.m_tHit, aHitInfo );
+
+    return hitResult;
+}
+
+
+void CYLINDER::fillHitInfo( const RAY& aRay, float aT, HITINFO& aHitInfo ) const
+{
+    aHitInfo.m_tHit = aT;
+    aHitInfo.m_HitPoint = aRay.at( aT );
+
+    const SFVEC2F hitPoint2D = SFVEC2F( aHitInfo.m_HitPoint.x, aHitInfo.m_HitPoint.y );
+
+    aHitInfo.m_HitNormal = SFVEC3F( -( hitPoint2D.x - m_center.x ) * m_inv_radius,
+                                    -( hitPoint2D.y - m_center.y ) * m_inv_radius, 0.0f );
 
-        const SFVEC2F hitPoint2D = SFVEC2F( aHitInfo.m_HitPoint.x, aHitInfo.m_HitPoint.y );
+    m_material->Generate( aHitInfo.m_HitNormal, aRay, aHitInfo );
 
-        aHitInfo.m_HitNormal = SFVEC3F( -( hitPoint2D.x - m_center.x ) * m_inv_radius,
-                                        -( hitPoint2D.y - m_center.y ) * m_inv_radius, 0.0f );
+    aHitInfo.pHitObject = this;
+}
+
+
+uint64_t CYLINDER::IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                                    unsigned int aLast, float* aTHit,
+                                    HITINFO_PACKET* aHitInfoPacket ) const
+{
+    RAYPACKET_CYLINDER cylinder;
+
+    cylinder.m_CenterX = m_center.x;
+    cylinder.m_CenterY = m_center.y;
+    cylinder.m_RadiusSquared = m_radius_squared;
+    cylinder.m_ZMin = m_bbox.Min().z;
+    cylinder.m_ZMax = m_bbox.Max().z;
 
-        m_material->Generate( aHitInfo.m_HitNormal, aRay, aHitInfo );
+    float t[RAYPACKET_RAYS_PER_PACKET];
 
-        aHitInfo.pHitObject = this;
+    const uint64_t hits = RAYPACKET_Kernels().IntersectCylinder( aRayPacket.m_soa, cylinder,
+                                                                 aTHit, aFirst, aLast, t );
+
+    for( uint64_t remaining = hits; remaining; remaining &= remaining - 1 )
+    {
+        const unsigned int i = RAYPACKET_FirstRay( remaining );
+
+        fillHitInfo( aRayPacket.m_ray[i], t[i], aHitInfoPacket[i].m_HitInfo );
+        aTHit[i] = t[i];
     }
 
-    return hitResult;
+    return hits;
 }
 
 
@@ -49,10 +49,16 @@ public:
 
     bool Intersect( const RAY& aRay, HITINFO& aHitInfo ) const override;
     bool IntersectP(const RAY& aRay, float aMaxDistance ) const override;
+    uint64_t IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                              unsigned int aLast, float* aTHit,
+                              HITINFO_PACKET* aHitInfoPacket ) const override;
     bool Intersects( const BBOX_3D& aBBox ) const override;
     SFVEC3F GetDiffuseColor( const HITINFO& aHitInfo ) const override;
 
 private:
+    /// Fill the hit information of \a aRay hitting the cylinder wall at \a aT.
+    void fillHitInfo( const RAY& aRay, float aT, HITINFO& aHitInfo ) const;
+
     SFVEC2F m_center;
     float   m_radius_squared;
     float   m_inv_radius;
@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file model_instance_3d.cpp
+ */
+
+#include "model_instance_3d.h"
+#include "triangle_3d.h"
+#include "../accelerators/bvh_pbrt.h"
+
+
+MODEL_GEOMETRY_3D::MODEL_GEOMETRY_3D() :
+        m_accelerator( nullptr )
+{
+}
+
+
+MODEL_GEOMETRY_3D::~MODEL_GEOMETRY_3D()
+{
+    delete m_accelerator;
+}
+
+
+void MODEL_GEOMETRY_3D::Add( TRIANGLE* aTriangle )
+{
+    // The material is applied by the instance, in world space
+    aTriangle->SetSkipNormalGenerator( true );
+
+    m_triangles.Add( aTriangle );
+}
+
+
+void MODEL_GEOMETRY_3D::AddVertices( const SFVEC3F* aVertices, unsigned int aCount )
+{
+    m_vertices.insert( m_vertices.end(), aVertices, aVertices + aCount );
+}
+
+
+void MODEL_GEOMETRY_3D::Build()
+{
+    delete m_accelerator;
+    m_accelerator = nullptr;
+
+    if( !IsEmpty() )
+        m_accelerator = new BVH_PBRT( m_triangles );
+}
+
+
+MODEL_INSTANCE_3D::MODEL_INSTANCE_3D( const MODEL_GEOMETRY_3D& aGeometry,
+                                      const glm::mat4& aModelMatrix ) :
+        OBJECT_3D( OBJECT_3D_TYPE::MODELINSTANCE ),
+        m_geometry( aGeometry )
+{
+    m_inverseMatrix = glm::inverse( aModelMatrix );
+    m_normalMatrix = glm::transpose( glm::inverse( glm::mat3( aModelMatrix ) ) );
+
+    // Transforming the vertices gives a tighter box than transforming the model box
+    m_bbox.Reset();
+
+    for( const SFVEC3F& vertex : aGeometry.GetVertices() )
+        m_bbox.Union( SFVEC3F( aModelMatrix * glm::vec4( vertex, 1.0f ) ) );
+
+    m_bbox.ScaleNextUp();
+    m_centroid = m_bbox.GetCenter();
+}
+
+
+RAY MODEL_INSTANCE_3D::toModel( const RAY& aRay ) const
+{
+    RAY modelRay;
+
+    // The direction is not normalized so a distance in the model is the same in the world
+    modelRay.Init( SFVEC3F( m_inverseMatrix * glm::vec4( aRay.m_Origin, 1.0f ) ),
+                   SFVEC3F( m_inverseMatrix * glm::vec4( aRay.m_Dir, 0.0f ) ) );
+
+    return modelRay;
+}
+
+
+bool MODEL_INSTANCE_3D::Intersect( const RAY& aRay, HITINFO& aHitInfo ) const
+{
+    if( !m_geometry.GetAccelerator() )
+        return false;
+
+    if( !m_geometry.GetAccelerator()->Intersect( toModel( aRay ), aHitInfo ) )
+        return false;
+
+    aHitInfo.m_HitPoint = aRay.at( aHitInfo.m_tHit );
+    aHitInfo.m_HitNormal = glm::normalize( m_normalMatrix * aHitInfo.m_HitNormal );
+
+    aHitInfo.pHitObject->GetMaterial()->Generate( aHitInfo.m_HitNormal, aRay, aHitInfo );
+
+    aHitInfo.pHitInstance = this;
+    aHitInfo.pInstanceHitObject = aHitInfo.pHitObject;
+
+    return true;
+}
+
+
+bool MODEL_INSTANCE_3D::IntersectP( const RAY& aRay, float aMaxDistance ) const
+{
+    if( !m_geometry.GetAccelerator() )
+        return false;
+
+    return m_geometry.GetAccelerator()->IntersectP( toModel( aRay ), aMaxDistance );
+}
+
+
+bool MODEL_INSTANCE_3D::Intersects( const BBOX_3D& aBBox ) const
+{
+    return m_bbox.Intersects( aBBox );
+}
+
+
+SFVEC3F MODEL_INSTANCE_3D::GetDiffuseColor( const HITINFO& aHitInfo ) const
+{
+    // Hits report the model triangle, not the instance
+    if( aHitInfo.pHitInstance == this && aHitInfo.pInstanceHitObject )
+        return aHitInfo.pInstanceHitObject->GetDiffuseColor( aHitInfo );
+
+    return SFVEC3F( 1.0f );
+}
@@ -0,0 +1,112 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file model_instance_3d.h
+ * @brief 3D model triangles shared by all the placements of the model in the scene.
+ */
+
+#ifndef _MODEL_INSTANCE_3D_H_
+#define _MODEL_INSTANCE_3D_H_
+
+#include "object_3d.h"
+#include "../accelerators/container_3d.h"
+#include <vector>
+
+class ACCELERATOR_3D;
+class TRIANGLE;
+
+
+/**
+ * The triangles of a 3D model in the space of the model, with their own acceleration
+ * structure.
+ *
+ * The geometry is built once per model and shared by all its MODEL_INSTANCE_3D.
+ */
+class MODEL_GEOMETRY_3D
+{
+public:
+    MODEL_GEOMETRY_3D();
+
+    ~MODEL_GEOMETRY_3D();
+
+    /**
+     * Add a triangle, the geometry takes the ownership of it.
+     */
+    void Add( TRIANGLE* aTriangle );
+
+    /**
+     * Add vertices used to compute the bounding box of the instances.
+     */
+    void AddVertices( const SFVEC3F* aVertices, unsigned int aCount );
+
+    /**
+     * Create the acceleration structure, once all the triangles are added.
+     */
+    void Build();
+
+    bool IsEmpty() const { return m_triangles.GetList().empty(); }
+
+    const ACCELERATOR_3D* GetAccelerator() const { return m_accelerator; }
+
+    const std::vector<SFVEC3F>& GetVertices() const { return m_vertices; }
+
+private:
+    CONTAINER_3D         m_triangles;
+    std::vector<SFVEC3F> m_vertices;
+    ACCELERATOR_3D*      m_accelerator;
+};
+
+
+/**
+ * A placement of a shared MODEL_GEOMETRY_3D in the scene.
+ *
+ * Rays are transformed to the space of the model to be traced in its geometry, the hits are
+ * transformed back to world space.  The hit object stays the model triangle so it provides
+ * the material and color, the instance is recorded in HITINFO::pHitInstance.
+ */
+class MODEL_INSTANCE_3D : public OBJECT_3D
+{
+public:
+    /**
+     * @param aGeometry is the geometry of the model, it must outlive the instance.
+     * @param aModelMatrix transforms the model to world space.
+     */
+    MODEL_INSTANCE_3D( const MODEL_GEOMETRY_3D& aGeometry, const glm::mat4& aModelMatrix );
+
+    bool Intersect( const RAY& aRay, HITINFO& aHitInfo ) const override;
+    bool IntersectP( const RAY& aRay, float aMaxDistance ) const override;
+    bool Intersects( const BBOX_3D& aBBox ) const override;
+    SFVEC3F GetDiffuseColor( const HITINFO& aHitInfo ) const override;
+
+private:
+    /// Transform \a aRay to the space of the model, keeping the distances along the ray.
+    RAY toModel( const RAY& aRay ) const;
+
+    const MODEL_GEOMETRY_3D& m_geometry;
+    glm::mat4                m_inverseMatrix;
+    glm::mat3                m_normalMatrix;
+};
+
+
+#endif // _MODEL_INSTANCE_3D_H_
@@ -48,6 +48,25 @@ OBJECT_3D::OBJECT_3D( OBJECT_3D_TYPE aObjType )
 }
 
 
+uint64_t OBJECT_3D::IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                                     unsigned int aLast, float* aTHit,
+                                     HITINFO_PACKET* aHitInfoPacket ) const
+{
+    uint64_t hits = 0;
+
+    for( unsigned int i = aFirst; i < aLast; ++i )
+    {
+        if( Intersect( aRayPacket.m_ray[i], aHitInfoPacket[i].m_HitInfo ) )
+        {
+            aTHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+            hits |= (uint64_t) 1 << i;
+        }
+    }
+
+    return hits;
+}
+
+
 /*
  * Lookup table for OBJECT_2D_TYPE printed names
  */
@@ -59,7 +78,8 @@ const std::map<OBJECT_3D_TYPE, const char*> objectTypeNames
     { OBJECT_3D_TYPE::LAYERITEM,  "OBJECT_3D_TYPE::LAYER_ITEM" },
     { OBJECT_3D_TYPE::XYPLANE,    "OBJECT_3D_TYPE::XY_PLANE" },
     { OBJECT_3D_TYPE::ROUNDSEG,   "OBJECT_3D_TYPE::ROUND_SEG" },
-    { OBJECT_3D_TYPE::TRIANGLE,   "OBJECT_3D_TYPE::TRIANGLE" }
+    { OBJECT_3D_TYPE::TRIANGLE,   "OBJECT_3D_TYPE::TRIANGLE" },
+    { OBJECT_3D_TYPE::MODELINSTANCE, "OBJECT_3D_TYPE::MODEL_INSTANCE" }
 };
 // clang-format on
 
@@ -43,6 +43,7 @@ enum class OBJECT_3D_TYPE
     XYPLANE,
     ROUNDSEG,
     TRIANGLE,
+    MODELINSTANCE,
     MAX
 };
 
@@ -89,6 +90,19 @@ public:
      */
     virtual bool IntersectP( const RAY& aRay, float aMaxDistance ) const = 0;
 
+    /**
+     * Intersect the rays \a aFirst to \a aLast - 1 of a packet with the object.
+     *
+     * The default implementation tests the rays one by one with Intersect().
+     *
+     * @param aTHit is the closest hit distance of each ray, updated with the new hits.
+     * @param aHitInfoPacket is the hit information of each ray, updated with the new hits.
+     * @return the mask of the rays hitting the object (bit i for ray i).
+     */
+    virtual uint64_t IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                                      unsigned int aLast, float* aTHit,
+                                      HITINFO_PACKET* aHitInfoPacket ) const;
+
     const BBOX_3D& GetBBox() const { return m_bbox; }
 
     const SFVEC3F& GetCentroid() const { return m_centroid; }
@@ -28,6 +28,7 @@
 
 #include "round_segment_3d.h"
 #include "../shapes2D/round_segment_2d.h"
+#include "../raypacket_simd.h"
 
 
 ROUND_SEGMENT::ROUND_SEGMENT( const ROUND_SEGMENT_2D& aSeg2D, float aZmin, float aZmax ) :
@@ -78,13 +79,7 @@ bool ROUND_SEGMENT::Intersect( const RAY& aRay, HITINFO& aHitInfo ) const
     {
         if( tPlane < aHitInfo.m_tHit )
         {
-            aHitInfo.m_tHit = tPlane;
-            aHitInfo.m_HitPoint = SFVEC3F( planeHitPoint2d.x, planeHitPoint2d.y,
-                                           aRay.m_Origin.z + aRay.m_Dir.z * tPlane );
-            aHitInfo.m_HitNormal = SFVEC3F( 0.0f, 0.0f, aRay.m_dirIsNeg[2] ? 1.0f : -1.0f );
-            aHitInfo.pHitObject = this;
-
-            m_material->Generate( aHitInfo.m_HitNormal, aRay, aHitInfo );
+            fillFaceHitInfo( aRay, tPlane, aHitInfo );
 
             return true;
         }
@@ -259,6 +254,66 @@ bool ROUND_SEGMENT::Intersect( const RAY& aRay, HITINFO& aHitInfo ) const
 }
 
 
+void ROUND_SEGMENT::fillFaceHitInfo( const RAY& aRay, float aT, HITINFO& aHitInfo ) const
+{
+    aHitInfo.m_tHit = aT;
+    aHitInfo.m_HitPoint = aRay.at( aT );
+    aHitInfo.m_HitNormal = SFVEC3F( 0.0f, 0.0f, aRay.m_dirIsNeg[2] ? 1.0f : -1.0f );
+    aHitInfo.pHitObject = this;
+
+    m_material->Generate( aHitInfo.m_HitNormal, aRay, aHitInfo );
+}
+
+
+uint64_t ROUND_SEGMENT::IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                                         unsigned int aLast, float* aTHit,
+                                         HITINFO_PACKET* aHitInfoPacket ) const
+{
+    RAYPACKET_ROUND_SEGMENT segment;
+
+    segment.m_StartX = m_segment.m_Start.x;
+    segment.m_StartY = m_segment.m_Start.y;
+    segment.m_EndX = m_segment.m_End.x;
+    segment.m_EndY = m_segment.m_End.y;
+    segment.m_EndMinusStartX = m_segment.m_End_minus_start.x;
+    segment.m_EndMinusStartY = m_segment.m_End_minus_start.y;
+    segment.m_DotEndMinusStart = m_segment.m_DOT_End_minus_start;
+    segment.m_RadiusSquared = m_radius_squared;
+    segment.m_ZMin = m_bbox.Min().z;
+    segment.m_ZMax = m_bbox.Max().z;
+
+    float    t[RAYPACKET_RAYS_PER_PACKET];
+    uint64_t undecided = 0;
+
+    // Most rays either miss the segment or hit its top or bottom face, the side walls and
+    // round ends are only tested for the others.
+    uint64_t hits = RAYPACKET_Kernels().IntersectRoundSegmentFaces( aRayPacket.m_soa, segment,
+                                                                    aTHit, aFirst, aLast, t,
+                                                                    &undecided );
+
+    for( uint64_t remaining = hits; remaining; remaining &= remaining - 1 )
+    {
+        const unsigned int i = RAYPACKET_FirstRay( remaining );
+
+        fillFaceHitInfo( aRayPacket.m_ray[i], t[i], aHitInfoPacket[i].m_HitInfo );
+        aTHit[i] = t[i];
+    }
+
+    for( ; undecided; undecided &= undecided - 1 )
+    {
+        const unsigned int i = RAYPACKET_FirstRay( undecided );
+
+        if( Intersect( aRayPacket.m_ray[i], aHitInfoPacket[i].m_HitInfo ) )
+        {
+            aTHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+            hits |= (uint64_t) 1 << i;
+        }
+    }
+
+    return hits;
+}
+
+
 bool ROUND_SEGMENT::IntersectP( const RAY& aRay, float aMaxDistance ) const
 {
     // Top / Bottom plane
@@ -42,10 +42,16 @@ public:
 
     bool Intersect( const RAY& aRay, HITINFO& aHitInfo ) const override;
     bool IntersectP( const RAY& aRay, float aMaxDistance ) const override;
+    uint64_t IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                              unsigned int aLast, float* aTHit,
+                              HITINFO_PACKET* aHitInfoPacket ) const override;
     bool Intersects( const BBOX_3D& aBBox ) const override;
     SFVEC3F GetDiffuseColor( const HITINFO& aHitInfo ) const override;
 
 private:
+    /// Fill the hit information of \a aRay hitting the top or bottom face at \a aT.
+    void fillFaceHitInfo( const RAY& aRay, float aT, HITINFO& aHitInfo ) const;
+
     RAYSEG2D m_segment;
 
     SFVEC3F  m_center_left;
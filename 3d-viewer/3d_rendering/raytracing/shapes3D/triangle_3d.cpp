@@ -29,6 +29,7 @@
 
 
 #include "triangle_3d.h"
+#include "../raypacket_simd.h"
 
 
 void TRIANGLE::pre_calc_const()
@@ -103,6 +104,8 @@ TRIANGLE::TRIANGLE( const SFVEC3F& aV1, const SFVEC3F& aV2, const SFVEC3F& aV3 )
     m_vertexColorRGBA[1] = 0xFFFFFFFF;
     m_vertexColorRGBA[2] = 0xFFFFFFFF;
 
+    m_skipNormalGenerator = false;
+
     pre_calc_const();
 }
 
@@ -119,6 +122,8 @@ TRIANGLE::TRIANGLE( const SFVEC3F& aV1, const SFVEC3F& aV2, const SFVEC3F& aV3,
     m_vertexColorRGBA[1] = 0xFFFFFFFF;
     m_vertexColorRGBA[2] = 0xFFFFFFFF;
 
+    m_skipNormalGenerator = false;
+
     pre_calc_const();
 
     m_normal[0] = aFaceNormal;
@@ -139,6 +144,8 @@ TRIANGLE::TRIANGLE( const SFVEC3F& aV1, const SFVEC3F& aV2, const SFVEC3F& aV3,
     m_vertexColorRGBA[1] = 0xFFFFFFFF;
     m_vertexColorRGBA[2] = 0xFFFFFFFF;
 
+    m_skipNormalGenerator = false;
+
     pre_calc_const();
 
     m_normal[0] = aN1;
@@ -236,20 +243,69 @@ bool TRIANGLE::Intersect( const RAY& aRay, HITINFO& aHitInfo ) const
     if( glm::dot( D, m_n ) > 0.0f )
         return false;
 
-    aHitInfo.m_tHit = t;
-    aHitInfo.m_HitPoint = aRay.at( t );
+    fillHitInfo( aRay, t, u, v, aHitInfo );
+
+    return true;
+#undef ku
+#undef kv
+}
+
+
+void TRIANGLE::fillHitInfo( const RAY& aRay, float aT, float aU, float aV,
+                            HITINFO& aHitInfo ) const
+{
+    aHitInfo.m_tHit = aT;
+    aHitInfo.m_HitPoint = aRay.at( aT );
 
     // interpolate vertex normals with UVW using Gouraud's shading
-    aHitInfo.m_HitNormal =
-            glm::normalize( ( 1.0f - u - v ) * m_normal[0] + u * m_normal[1] + v * m_normal[2] );
+    aHitInfo.m_HitNormal = glm::normalize( ( 1.0f - aU - aV ) * m_normal[0] + aU * m_normal[1]
+                                           + aV * m_normal[2] );
 
-    m_material->Generate( aHitInfo.m_HitNormal, aRay, aHitInfo );
+    if( !m_skipNormalGenerator )
+        m_material->Generate( aHitInfo.m_HitNormal, aRay, aHitInfo );
 
     aHitInfo.pHitObject = this;
+}
 
-    return true;
-#undef ku
-#undef kv
+
+uint64_t TRIANGLE::IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                                    unsigned int aLast, float* aTHit,
+                                    HITINFO_PACKET* aHitInfoPacket ) const
+{
+    RAYPACKET_TRIANGLE triangle;
+
+    triangle.m_K = m_k;
+    triangle.m_Ku = s_modulo[m_k + 1];
+    triangle.m_Kv = s_modulo[m_k + 2];
+    triangle.m_Nu = m_nu;
+    triangle.m_Nv = m_nv;
+    triangle.m_Nd = m_nd;
+    triangle.m_Bnu = m_bnu;
+    triangle.m_Bnv = m_bnv;
+    triangle.m_Cnu = m_cnu;
+    triangle.m_Cnv = m_cnv;
+    triangle.m_Au = m_vertex[0][triangle.m_Ku];
+    triangle.m_Av = m_vertex[0][triangle.m_Kv];
+    triangle.m_Normal[0] = m_n.x;
+    triangle.m_Normal[1] = m_n.y;
+    triangle.m_Normal[2] = m_n.z;
+
+    float t[RAYPACKET_RAYS_PER_PACKET];
+    float u[RAYPACKET_RAYS_PER_PACKET];
+    float v[RAYPACKET_RAYS_PER_PACKET];
+
+    const uint64_t hits = RAYPACKET_Kernels().IntersectTriangle( aRayPacket.m_soa, triangle,
+                                                                 aTHit, aFirst, aLast, t, u, v );
+
+    for( uint64_t remaining = hits; remaining; remaining &= remaining - 1 )
+    {
+        const unsigned int i = RAYPACKET_FirstRay( remaining );
+
+        fillHitInfo( aRayPacket.m_ray[i], t[i], u[i], v[i], aHitInfoPacket[i].m_HitInfo );
+        aTHit[i] = t[i];
+    }
+
+    return hits;
 }
 
 
@@ -61,14 +61,26 @@ public:
 
     void SetUV( const SFVEC2F& aUV1, const SFVEC2F& aUV2, const SFVEC2F& aUV3 );
 
+    /**
+     * Leave the material normal generation to the caller.  Used by triangles in the space of
+     * a model, the generator must only run once the hit is known in world space.
+     */
+    void SetSkipNormalGenerator( bool aSkip ) { m_skipNormalGenerator = aSkip; }
+
     bool Intersect( const RAY& aRay, HITINFO& aHitInfo ) const override;
     bool IntersectP(const RAY& aRay, float aMaxDistance ) const override;
+    uint64_t IntersectPacket( const RAYPACKET& aRayPacket, unsigned int aFirst,
+                              unsigned int aLast, float* aTHit,
+                              HITINFO_PACKET* aHitInfoPacket ) const override;
     bool Intersects( const BBOX_3D& aBBox ) const override;
     SFVEC3F GetDiffuseColor( const HITINFO& aHitInfo ) const override;
 
 private:
     void pre_calc_const();
 
+    /// Fill the hit information of \a aRay hitting the triangle at \a aT, \a aU, \a aV.
+    void fillHitInfo( const RAY& aRay, float aT, float aU, float aV, HITINFO& aHitInfo ) const;
+
     SFVEC3F m_normal[3];                // 36
     SFVEC3F m_vertex[3];                // 36
     SFVEC3F m_n;                        // 12
@@ -78,7 +90,8 @@ private:
     unsigned int m_k;                   // 4
     float m_bnu, m_bnv;                 // 8
     float m_cnu, m_cnv;                 // 8
-                                        // 152 bytes (max 160 == 5 * 32)
+    bool m_skipNormalGenerator;         // 1
+                                        // 153 bytes (max 160 == 5 * 32)
 };
 
 #endif // _TRIANGLE_H_
@@ -67,7 +67,28 @@ public:
     /**
      * @todo This must be reviewed to add flags to improve specific render.
      */
-    void ReloadRequest() { m_reloadRequested = true; }
+    void ReloadRequest()
+    {
+        m_reloadRequested = true;
+        m_pendingChanges.Clear();
+    }
+
+    /**
+     * Request an update of the scene after some board items changed.
+     *
+     * Only the layers touched by the changes are rebuilt on the next redraw.  A pending
+     * ReloadRequest() takes precedence.
+     */
+    void UpdateRequest( const BOARD_3D_CHANGES& aChanges )
+    {
+        if( !m_reloadRequested )
+            m_pendingChanges.Merge( aChanges );
+    }
+
+    /**
+     * Query if there is a pending update request.
+     */
+    bool IsUpdateRequestPending() const { return m_pendingChanges.HasChanges(); }
 
     /**
      * Query if there is a pending reload request.
@@ -112,6 +133,9 @@ protected:
     ///< @todo This must be reviewed in order to flag change types.
     bool m_reloadRequested;
 
+    ///< Board changes to apply on the next redraw, see UpdateRequest().
+    BOARD_3D_CHANGES m_pendingChanges;
+
     ///< The window size that this camera is working.
     wxSize m_windowSize;
 
@@ -93,7 +93,8 @@ EDA_3D_VIEWER_FRAME::EDA_3D_VIEWER_FRAME( KIWAY* aKiway, PCB_BASE_FRAME* aParent
         m_mainToolBar( nullptr ), m_canvas( nullptr ), m_currentCamera( m_trackBallCamera ),
         m_viewportsLabel( nullptr ),
         m_cbViewports( nullptr ),
-        m_trackBallCamera( 2 * RANGE_SCALE_3D ), m_spaceMouse( nullptr )
+        m_trackBallCamera( 2 * RANGE_SCALE_3D ), m_listenedBoard( nullptr ),
+        m_spaceMouse( nullptr )
 {
     wxLogTrace( m_logTrace, wxT( "EDA_3D_VIEWER_FRAME::EDA_3D_VIEWER_FRAME %s" ), aTitle );
 
@@ -188,6 +189,14 @@ EDA_3D_VIEWER_FRAME::EDA_3D_VIEWER_FRAME( KIWAY* aKiway, PCB_BASE_FRAME* aParent
     m_cbViewports->Connect( wxEVT_UPDATE_UI,
                             wxUpdateUIEventHandler( EDA_3D_VIEWER_FRAME::onUpdateViewportsCb ),
                             nullptr, this );
+
+    m_listenedBoard = GetBoard();
+
+    if( m_listenedBoard )
+        m_listenedBoard->AddListener( this );
+
+    Parent()->Connect( BOARD_CHANGED, wxCommandEventHandler( EDA_3D_VIEWER_FRAME::onBoardChanged ),
+                       nullptr, this );
 }
 
 
@@ -202,12 +211,18 @@ EDA_3D_VIEWER_FRAME::~EDA_3D_VIEWER_FRAME()
 
     Prj().GetProjectFile().m_Viewports3D = GetUserViewports();
 
+    // The frame can be destroyed without a close event
+    unlistenBoard();
+
     m_cbViewports->Disconnect( wxEVT_COMMAND_CHOICE_SELECTED,
                                wxCommandEventHandler( EDA_3D_VIEWER_FRAME::onViewportChanged ),
                                nullptr, this );
     m_cbViewports->Disconnect( wxEVT_UPDATE_UI,
                                wxUpdateUIEventHandler( EDA_3D_VIEWER_FRAME::onUpdateViewportsCb ),
                                nullptr, this );
+    Parent()->Disconnect( BOARD_CHANGED,
+                          wxCommandEventHandler( EDA_3D_VIEWER_FRAME::onBoardChanged ),
+                          nullptr, this );
 
     m_canvas->SetEventDispatcher( nullptr );
 
@@ -347,7 +362,78 @@ void EDA_3D_VIEWER_FRAME::ReloadRequest()
 {
     // This will schedule a request to load later
     if( m_canvas )
-        m_canvas->ReloadRequest( GetBoard(), Prj().Get3DCacheManager() );
+    {
+        // Board commits notify their items before asking for a reload.  A request without
+        // any notified change comes from an edit we know nothing about (board setup, layer
+        // stackup, display options...) and needs a full rebuild.
+        if( m_boardChanges.HasChanges() && GetBoard() == m_boardAdapter.GetBoard() )
+            m_canvas->UpdateRequest( m_boardChanges );
+        else
+            m_canvas->ReloadRequest( GetBoard(), Prj().Get3DCacheManager() );
+    }
+
+    m_boardChanges.Clear();
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    m_boardChanges.AddItem( aItem );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        m_boardChanges.AddItem( item );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    m_boardChanges.AddItem( aItem );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        m_boardChanges.AddItem( item );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    m_boardChanges.AddItem( aItem );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        m_boardChanges.AddItem( item );
+}
+
+
+void EDA_3D_VIEWER_FRAME::onBoardChanged( wxCommandEvent& aEvent )
+{
+    // The previous board has already been deleted by the parent frame
+    m_listenedBoard = GetBoard();
+
+    if( m_listenedBoard )
+        m_listenedBoard->AddListener( this );
+
+    m_boardChanges.Clear();
+    aEvent.Skip();
+}
+
+
+void EDA_3D_VIEWER_FRAME::unlistenBoard()
+{
+    if( m_listenedBoard && m_listenedBoard == GetBoard() )
+        m_listenedBoard->RemoveListener( this );
+
+    m_listenedBoard = nullptr;
 }
 
 
@@ -391,6 +477,8 @@ void EDA_3D_VIEWER_FRAME::OnCloseWindow( wxCloseEvent &event )
 {
     wxLogTrace( m_logTrace, wxT( "EDA_3D_VIEWER_FRAME::OnCloseWindow" ) );
 
+    unlistenBoard();
+
     if( m_canvas )
         m_canvas->Close();
 
@@ -61,7 +61,8 @@ enum EDA_3D_VIEWER_STATUSBAR
 /**
  * Create and handle a window for the 3d viewer connected to a Kiway and a pcbboard
  */
-class EDA_3D_VIEWER_FRAME : public EDA_3D_BOARD_HOLDER, public KIWAY_PLAYER
+class EDA_3D_VIEWER_FRAME : public EDA_3D_BOARD_HOLDER, public KIWAY_PLAYER,
+                            public BOARD_LISTENER
 {
 public:
     EDA_3D_VIEWER_FRAME( KIWAY* aKiway, PCB_BASE_FRAME* aParent, const wxString& aTitle,
@@ -82,11 +83,13 @@ public:
      * one to prepare changes and request for 3D rebuild only when all changes are committed.
      * This is made because the 3D rebuild can take a long time, and this rebuild cannot
      * always made after each change, for calculation time reason.
+     *
+     * Board items reported through the #BOARD_LISTENER interface since the last request are
+     * used to rebuild only the affected layers.  A request without any reported change
+     * rebuilds the whole scene.
      */
     void ReloadRequest();
 
-    // !TODO: review this function: it need a way to tell what changed,
-    // to only reload/rebuild things that have really changed
     /**
      * Reload and refresh (rebuild) the 3D scene.
      *
@@ -137,6 +140,18 @@ private:
 
     void OnCloseWindow( wxCloseEvent& event );
 
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+
+    /// Move the board listener to the new board when the parent frame changes its board.
+    void onBoardChanged( wxCommandEvent& aEvent );
+
+    void unlistenBoard();
+
     bool TryBefore( wxEvent& aEvent ) override;
 
     void Process_Special_Functions( wxCommandEvent& event );
@@ -184,6 +199,9 @@ private:
     CAMERA&                        m_currentCamera;
     TRACK_BALL                     m_trackBallCamera;
 
+    BOARD*                         m_listenedBoard;
+    BOARD_3D_CHANGES               m_boardChanges;   ///< Edits since the last reload request
+
     bool                           m_disable_ray_tracing;
 
     NL_3D_VIEWER_PLUGIN*           m_spaceMouse;
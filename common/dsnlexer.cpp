@@ -28,6 +28,11 @@
 #include <cstdio>
 #include <cstdlib>         // bsearch()
 #include <cctype>
+#include <clocale>
+
+#if defined( __APPLE__ )
+#include <xlocale.h>        // strtod_l()
+#endif
 
 #include <dsnlexer.h>
 #include <wx/translation.h>
@@ -828,11 +833,23 @@ double DSNLEXER::parseDouble()
     // GCC older than 11 "supports" C++17 without supporting the C++17 std::from_chars for doubles
     // clang is similar
 
+    // Parse with an explicit "C" locale so the result doesn't depend on the process-wide
+    // locale (and so on LOCALE_IO, which is not thread safe).
+#ifdef _WIN32
+    static _locale_t c_locale = _create_locale( LC_NUMERIC, "C" );
+#else
+    static locale_t c_locale = newlocale( LC_NUMERIC_MASK, "C", (locale_t) 0 );
+#endif
+
     char* tmp;
 
     errno = 0;
 
-    double fval = strtod( CurText(), &tmp );
+#ifdef _WIN32
+    double fval = _strtod_l( CurText(), &tmp, c_locale );
+#else
+    double fval = strtod_l( CurText(), &tmp, c_locale );
+#endif
 
     if( errno )
     {
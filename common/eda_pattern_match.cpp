@@ -346,9 +346,9 @@ int EDA_PATTERN_MATCH_RELATIONAL::FindOne( const wxString& aCandidate ) const
 }
 
 
-wxRegEx EDA_PATTERN_MATCH_RELATIONAL::m_regex_description(
+thread_local wxRegEx EDA_PATTERN_MATCH_RELATIONAL::m_regex_description(
         R"((\w+)[=:]([-+]?[\d.]+)(\w*))", wxRE_ADVANCED );
-wxRegEx EDA_PATTERN_MATCH_RELATIONAL::m_regex_search(
+thread_local wxRegEx EDA_PATTERN_MATCH_RELATIONAL::m_regex_search(
         R"(^(\w+)(<|<=|=|>=|>)([-+]?[\d.]*)(\w*)$)", wxRE_ADVANCED );
 const std::map<wxString, double> EDA_PATTERN_MATCH_RELATIONAL::m_units = {
     { "p",  1e-12 },
@@ -136,7 +136,100 @@ std::string EDA_UNIT_UTILS::FormatAngle( const EDA_ANGLE& aAngle )
 }
 
 
-std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+/**
+ * Return the number of decimal places needed to represent one internal unit in millimetres,
+ * or -1 if the scale is not an exact power of ten that the integer formatter can handle.
+ */
+static int iuDecimalPlaces( const EDA_IU_SCALE& aIuScale )
+{
+    double scale = 1.0;
+
+    for( int places = 0; places <= 10; ++places )
+    {
+        if( scale == aIuScale.IU_PER_MM )
+            return places;
+
+        scale *= 10.0;
+    }
+
+    return -1;
+}
+
+
+/**
+ * Write \a aValue / 10^aPlaces as a plain decimal number with trailing fractional zeros
+ * removed.  This gives the same text as the "{:.10g}" / "{:.10f}" formatting previously
+ * used for file output, but without going through floating point.
+ *
+ * @param aBuf must have room for at least 24 characters.
+ * @return the number of characters written (no terminating nul is written).
+ */
+static int formatIUDecimal( char* aBuf, int64_t aValue, int aPlaces )
+{
+    char  digits[24];
+    int   count = 0;
+    char* out = aBuf;
+
+    if( aValue < 0 )
+    {
+        *out++ = '-';
+        aValue = -aValue;
+    }
+
+    uint64_t mag = static_cast<uint64_t>( aValue );
+
+    // Drop trailing zeros of the fractional part up front
+    while( aPlaces > 0 && mag != 0 && mag % 10 == 0 )
+    {
+        mag /= 10;
+        aPlaces--;
+    }
+
+    if( mag == 0 )
+    {
+        aBuf[0] = '0';
+        return 1;
+    }
+
+    do
+    {
+        digits[count++] = static_cast<char>( '0' + mag % 10 );
+        mag /= 10;
+    } while( mag != 0 );
+
+    if( count <= aPlaces )
+    {
+        *out++ = '0';
+        *out++ = '.';
+
+        for( int i = count; i < aPlaces; ++i )
+            *out++ = '0';
+
+        while( count > 0 )
+            *out++ = digits[--count];
+    }
+    else
+    {
+        while( count > aPlaces )
+            *out++ = digits[--count];
+
+        if( aPlaces > 0 )
+        {
+            *out++ = '.';
+
+            while( count > 0 )
+                *out++ = digits[--count];
+        }
+    }
+
+    return static_cast<int>( out - aBuf );
+}
+
+
+/**
+ * Floating point version of the formatter, kept for scales which are not a power of ten.
+ */
+static std::string formatIUGeneric( const EDA_IU_SCALE& aIuScale, int aValue )
 {
     std::string buf;
     double engUnits = aValue;
@@ -162,26 +255,57 @@ std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, i
 }
 
 
+std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    int places = iuDecimalPlaces( aIuScale );
+
+    if( places < 0 )
+        return formatIUGeneric( aIuScale, aValue );
+
+    char buf[24];
+    int  len = formatIUDecimal( buf, aValue, places );
+
+    return std::string( buf, len );
+}
+
+
+/**
+ * Format a pair of coordinates separated by a single space into one string.
+ */
+static std::string formatIUPair( const EDA_IU_SCALE& aIuScale, int aX, int aY )
+{
+    int places = iuDecimalPlaces( aIuScale );
+
+    if( places < 0 )
+        return formatIUGeneric( aIuScale, aX ) + " " + formatIUGeneric( aIuScale, aY );
+
+    char buf[48];
+    int  len = formatIUDecimal( buf, aX, places );
+
+    buf[len++] = ' ';
+    len += formatIUDecimal( buf + len, aY, places );
+
+    return std::string( buf, len );
+}
+
+
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                  const wxPoint&      aPoint )
 {
-    return FormatInternalUnits( aIuScale, aPoint.x ) + " "
-           + FormatInternalUnits( aIuScale, aPoint.y );
+    return formatIUPair( aIuScale, aPoint.x, aPoint.y );
 }
 
 
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                  const VECTOR2I&     aPoint )
 {
-    return FormatInternalUnits( aIuScale, aPoint.x ) + " "
-           + FormatInternalUnits( aIuScale, aPoint.y );
+    return formatIUPair( aIuScale, aPoint.x, aPoint.y );
 }
 
 
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, const wxSize& aSize )
 {
-    return FormatInternalUnits( aIuScale, aSize.GetWidth() ) + " "
-           + FormatInternalUnits( aIuScale, aSize.GetHeight() );
+    return formatIUPair( aIuScale, aSize.GetWidth(), aSize.GetHeight() );
 }
 
 #define IU_TO_MM( x, scale ) ( x / scale.IU_PER_MM )
@@ -24,6 +24,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <mutex>
 #include <wx/font.h>
 #include <string_utils.h>
 #include <gal/graphics_abstraction_layer.h>
@@ -47,6 +48,9 @@ FONT* FONT::s_defaultFont = nullptr;
 
 std::map< std::tuple<wxString, bool, bool>, FONT*> FONT::s_fontMap;
 
+// Fonts are looked up by file parsers which may run on worker threads.
+static std::recursive_mutex s_fontMutex;
+
 
 FONT::FONT()
 {
@@ -55,6 +59,8 @@ FONT::FONT()
 
 FONT* FONT::getDefaultFont()
 {
+    std::lock_guard<std::recursive_mutex> lock( s_fontMutex );
+
     if( !s_defaultFont )
         s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
 
@@ -67,7 +73,8 @@ FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic )
     if( aFontName.empty() || aFontName.StartsWith( KICAD_FONT_NAME ) )
         return getDefaultFont();
 
-    std::tuple<wxString, bool, bool> key = { aFontName, aBold, aItalic };
+    std::lock_guard<std::recursive_mutex> lock( s_fontMutex );
+    std::tuple<wxString, bool, bool>      key = { aFontName, aBold, aItalic };
 
     FONT* font = s_fontMap[key];
 
@@ -28,16 +28,26 @@
  * @brief Functions for file management
  */
 
+#include <cstdio>
+
 #include <wx/mimetype.h>
 #include <wx/filename.h>
 #include <wx/dir.h>
 
+#ifdef _WIN32
+#include <io.h>         // _commit()
+#else
+#include <unistd.h>     // fsync()
+#endif
+
 #include <pgm_base.h>
 #include <confirm.h>
 #include <core/arraydim.h>
 #include <gestfich.h>
 #include <string_utils.h>
 #include <launch_ext.h>
+#include <ki_exception.h>
+#include <thread_pool.h>
 
 void QuoteString( wxString& string )
 {
@@ -226,6 +236,84 @@ void KiCopyFile( const wxString& aSrcPath, const wxString& aDestPath, wxString&
 }
 
 
+void KiWriteFileAtomically( const wxString& aFileName, const std::string& aContents )
+{
+    wxFileName target( aFileName );
+
+    // The temporary file must live on the same file system as the target for the final
+    // rename to be atomic.
+    wxString tempFile = wxFileName::CreateTempFileName( target.GetPathWithSep() + wxT( "~" )
+                                                        + target.GetName() );
+
+    if( tempFile.IsEmpty() )
+        THROW_IO_ERROR( wxString::Format( _( "Cannot create temporary file in '%s'." ),
+                                          target.GetPath() ) );
+
+    FILE* fp = wxFopen( tempFile, wxT( "wb" ) );
+
+    if( !fp )
+    {
+        wxRemoveFile( tempFile );
+        THROW_IO_ERROR( wxString::Format( _( "Cannot open temporary file '%s'." ), tempFile ) );
+    }
+
+    bool ok = aContents.empty() || fwrite( aContents.data(), aContents.size(), 1, fp ) == 1;
+
+    ok = ok && fflush( fp ) == 0;
+
+#ifdef _WIN32
+    ok = ok && _commit( _fileno( fp ) ) == 0;
+#else
+    ok = ok && fsync( fileno( fp ) ) == 0;
+#endif
+
+    ok = ( fclose( fp ) == 0 ) && ok;
+
+    if( !ok )
+    {
+        wxRemoveFile( tempFile );
+        THROW_IO_ERROR( wxString::Format( _( "Error writing temporary file '%s'." ), tempFile ) );
+    }
+
+    if( !wxRenameFile( tempFile, aFileName, true ) )
+    {
+        wxRemoveFile( tempFile );
+        THROW_IO_ERROR( wxString::Format( _( "Failed to rename temporary file '%s'." ),
+                                          tempFile ) );
+    }
+}
+
+
+std::future<wxString> KiWriteFileAtomicallyAsync( const wxString& aFileName, std::string aContents,
+                                                  std::function<void()> aOnComplete )
+{
+    thread_pool& tp = GetKiCadThreadPool();
+
+    // Take a deep copy of the file name; wxString is not safe to share between threads
+    wxString fileName( aFileName.wc_str() );
+
+    return tp.submit(
+            [fileName, contents = std::move( aContents ), aOnComplete]() -> wxString
+            {
+                wxString error;
+
+                try
+                {
+                    KiWriteFileAtomically( fileName, contents );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    error = ioe.What();
+                }
+
+                if( aOnComplete )
+                    aOnComplete();
+
+                return error;
+            } );
+}
+
+
 wxString QuoteFullPath( wxFileName& fn, wxPathFormat format )
 {
     return wxT( "\"" ) + fn.GetFullPath( format ) + wxT( "\"" );
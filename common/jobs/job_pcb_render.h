@@ -0,0 +1,84 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_PCB_RENDER_H
+#define JOB_PCB_RENDER_H
+
+#include <wx/string.h>
+#include "job.h"
+
+class JOB_PCB_RENDER : public JOB
+{
+public:
+    JOB_PCB_RENDER( bool aIsCli ) :
+            JOB( "render", aIsCli ),
+            m_filename(),
+            m_outputFile(),
+            m_width( 1600 ),
+            m_height( 900 ),
+            m_zoom( 1.0 ),
+            m_rotateX( 0.0 ),
+            m_rotateY( 0.0 ),
+            m_rotateZ( 0.0 ),
+            m_perspective( false ),
+            m_floor( false )
+    {
+        m_side = SIDE::TOP;
+        m_quality = QUALITY::BASIC;
+    }
+
+    wxString m_filename;
+    wxString m_outputFile;
+
+    int m_width;
+    int m_height;
+
+    enum class SIDE
+    {
+        TOP,
+        BOTTOM,
+        LEFT,
+        RIGHT,
+        FRONT,
+        BACK
+    };
+
+    SIDE m_side;
+
+    double m_zoom;
+
+    ///< Extra rotation applied after the side view, in degrees
+    double m_rotateX;
+    double m_rotateY;
+    double m_rotateZ;
+
+    bool m_perspective;
+
+    enum class QUALITY
+    {
+        BASIC,      ///< Shadows only
+        HIGH        ///< Shadows, reflections, refractions, post processing and anti-aliasing
+    };
+
+    QUALITY m_quality;
+
+    bool m_floor;
+};
+
+#endif
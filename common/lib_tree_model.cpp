@@ -22,11 +22,14 @@
 #include <lib_tree_model.h>
 
 #include <algorithm>
+#include <atomic>
 #include <eda_pattern_match.h>
 #include <lib_tree_item.h>
 #include <utility>
 #include <pgm_base.h>
 #include <string_utils.h>
+#include <thread_pool.h>
+#include <wx/tokenzr.h>
 
 // Each node gets this lowest score initially, without any matches applied.
 // Matches will then increase this score depending on match quality.  This way,
@@ -50,6 +53,33 @@ static int matchPosScore(int aPosition, int aMaximum)
 }
 
 
+// Returns true if the regex, wildcard and substring matchers all match the same strings for
+// aTerm: exactly those containing aTerm.  The relational matcher needs one of '<', '=' or '>'.
+static bool isPlainSearchTerm( const wxString& aTerm )
+{
+    static const wxString specialChars = wxT( ".*+?^${}()|[]\\<=>" );
+
+    if( aTerm.IsEmpty() )
+        return false;
+
+    for( wxUniChar c : aTerm )
+    {
+        if( specialChars.Find( c ) != wxNOT_FOUND )
+            return false;
+    }
+
+    return true;
+}
+
+
+static uint64_t trigramKey( const wxString& aString, size_t aPos )
+{
+    return ( (uint64_t) aString[aPos].GetValue() << 42 )
+           | ( (uint64_t) aString[aPos + 1].GetValue() << 21 )
+           | (uint64_t) aString[aPos + 2].GetValue();
+}
+
+
 void LIB_TREE_NODE::ResetScore()
 {
     for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
@@ -230,17 +260,23 @@ void LIB_TREE_NODE_LIB_ID::Update( LIB_TREE_ITEM* aItem )
 }
 
 
-void LIB_TREE_NODE_LIB_ID::UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxString& aLib )
+void LIB_TREE_NODE_LIB_ID::Normalize()
 {
-    if( m_Score <= 0 )
-        return; // Leaf nodes without scores are out of the game.
-
     if( !m_Normalized )
     {
         m_MatchName = UnescapeString( m_MatchName ).Lower();
         m_SearchText = m_SearchText.Lower();
         m_Normalized = true;
     }
+}
+
+
+void LIB_TREE_NODE_LIB_ID::UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxString& aLib )
+{
+    if( m_Score <= 0 )
+        return; // Leaf nodes without scores are out of the game.
+
+    Normalize();
 
     if( !aLib.IsEmpty() && m_Parent->m_MatchName != aLib )
     {
@@ -311,6 +347,128 @@ LIB_TREE_NODE_LIB_ID& LIB_TREE_NODE_LIB::AddItem( LIB_TREE_ITEM* aItem )
 }
 
 
+void LIB_TREE_NODE_LIB::buildSearchIndex()
+{
+    std::map<wxString, std::vector<LIB_TREE_NODE*>> tokens;
+
+    m_searchIndexBuilt = false;
+    m_searchTokens.clear();
+    m_searchTokenNodes.clear();
+    m_searchTrigrams.clear();
+
+    for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
+    {
+        if( child->m_Type != LIBID )
+            return;
+
+        static_cast<LIB_TREE_NODE_LIB_ID*>( child.get() )->Normalize();
+
+        for( const wxString* text : { &child->m_MatchName, &child->m_SearchText } )
+        {
+            wxStringTokenizer tokenizer( *text );
+
+            while( tokenizer.HasMoreTokens() )
+            {
+                std::vector<LIB_TREE_NODE*>& nodes = tokens[ tokenizer.GetNextToken() ];
+
+                if( nodes.empty() || nodes.back() != child.get() )
+                    nodes.push_back( child.get() );
+            }
+        }
+    }
+
+    m_searchTokens.reserve( tokens.size() );
+    m_searchTokenNodes.reserve( tokens.size() );
+
+    for( std::pair<const wxString, std::vector<LIB_TREE_NODE*>>& token : tokens )
+    {
+        int tokenIdx = (int) m_searchTokens.size();
+
+        m_searchTokens.push_back( token.first );
+        m_searchTokenNodes.push_back( std::move( token.second ) );
+
+        for( size_t ii = 0; ii + 2 < token.first.length(); ++ii )
+        {
+            std::vector<int>& tokenList = m_searchTrigrams[ trigramKey( token.first, ii ) ];
+
+            if( tokenList.empty() || tokenList.back() != tokenIdx )
+                tokenList.push_back( tokenIdx );
+        }
+    }
+
+    m_searchIndexedCount = m_Children.size();
+    m_searchIndexBuilt = true;
+}
+
+
+bool LIB_TREE_NODE_LIB::isSearchIndexValid() const
+{
+    if( !m_searchIndexBuilt || m_searchIndexedCount != m_Children.size() )
+        return false;
+
+    for( const std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
+    {
+        if( !child->m_Normalized )
+            return false;
+    }
+
+    return true;
+}
+
+
+bool LIB_TREE_NODE_LIB::findSearchCandidates( const wxString& aTerm,
+                                              std::unordered_set<LIB_TREE_NODE*>& aCandidates )
+{
+    // A match of the library name makes every child a candidate
+    if( !isPlainSearchTerm( aTerm ) || m_MatchName.Contains( aTerm ) )
+        return false;
+
+    if( !isSearchIndexValid() )
+        buildSearchIndex();
+
+    if( !m_searchIndexBuilt )
+        return false;
+
+    auto addToken =
+            [&]( int aTokenIdx )
+            {
+                if( m_searchTokens[aTokenIdx].Contains( aTerm ) )
+                {
+                    aCandidates.insert( m_searchTokenNodes[aTokenIdx].begin(),
+                                        m_searchTokenNodes[aTokenIdx].end() );
+                }
+            };
+
+    if( aTerm.length() < 3 )
+    {
+        for( int ii = 0; ii < (int) m_searchTokens.size(); ++ii )
+            addToken( ii );
+
+        return true;
+    }
+
+    // Every token containing the term contains all its trigrams, so only the tokens
+    // having its rarest trigram need to be checked
+    const std::vector<int>* rarest = nullptr;
+
+    for( size_t ii = 0; ii + 2 < aTerm.length(); ++ii )
+    {
+        auto it = m_searchTrigrams.find( trigramKey( aTerm, ii ) );
+
+        if( it == m_searchTrigrams.end() )
+            return true;
+
+        if( !rarest || it->second.size() < rarest->size() )
+            rarest = &it->second;
+    }
+
+    for( int tokenIdx : *rarest )
+        addToken( tokenIdx );
+
+    return true;
+}
+
+
 void LIB_TREE_NODE_LIB::UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxString& aLib )
 {
     m_Score = 0;
@@ -319,9 +477,23 @@ void LIB_TREE_NODE_LIB::UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxStr
 
     if( m_Children.size() )
     {
+        std::unordered_set<LIB_TREE_NODE*> candidates;
+        bool                               useCandidates = false;
+
+        // Children of another library than aLib and children which cannot match the term
+        // would get a zero score anyway
+        if( aLib.IsEmpty() || m_MatchName == aLib )
+            useCandidates = findSearchCandidates( aMatcher.GetPattern(), candidates );
+        else
+            useCandidates = true;
+
         for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
         {
-            child->UpdateScore( aMatcher, aLib );
+            if( useCandidates && !candidates.count( child.get() ) )
+                child->m_Score = 0;
+            else
+                child->UpdateScore( aMatcher, aLib );
+
             m_Score = std::max( m_Score, child->m_Score );
         }
     }
@@ -370,7 +542,46 @@ LIB_TREE_NODE_LIB& LIB_TREE_NODE_ROOT::AddLib( wxString const& aName, wxString c
 
 void LIB_TREE_NODE_ROOT::UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxString& aLib )
 {
-    for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
-        child->UpdateScore( aMatcher, aLib );
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       num_threads = std::min<size_t>( tp.get_thread_count(), m_Children.size() );
+
+    if( num_threads <= 1 )
+    {
+        for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
+            child->UpdateScore( aMatcher, aLib );
+
+        return;
+    }
+
+    // Matchers keep the state of their last match, so each thread needs its own.  They are
+    // built here because building a matcher is not thread safe.
+    std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>> matchers;
+
+    for( size_t ii = 0; ii < num_threads; ++ii )
+    {
+        matchers.push_back( std::make_unique<EDA_COMBINED_MATCHER>( aMatcher.GetPattern(),
+                                                                     CTX_LIBITEM ) );
+    }
+
+    std::atomic<size_t>              next( 0 );
+    std::vector<std::future<size_t>> returns;
+
+    auto score_lambda =
+            [&]( EDA_COMBINED_MATCHER* aThreadMatcher ) -> size_t
+            {
+                for( size_t ii = next.fetch_add( 1 ); ii < m_Children.size();
+                     ii = next.fetch_add( 1 ) )
+                {
+                    m_Children[ii]->UpdateScore( *aThreadMatcher, aLib );
+                }
+
+                return 1;
+            };
+
+    for( std::unique_ptr<EDA_COMBINED_MATCHER>& matcher : matchers )
+        returns.emplace_back( tp.submit( score_lambda, matcher.get() ) );
+
+    for( std::future<size_t>& ret : returns )
+        ret.wait();
 }
 
@@ -29,6 +29,7 @@
 #include <math/util.h>
 #include <numeric>
 #include <sstream>
+#include <string_view>
 #include <utf.h>
 #include <wx/log.h>
 #include <wx/translation.h>
@@ -193,48 +194,63 @@ std::map<wxString, wxString> ALTIUM_PARSER::ReadProperties()
                        "malformed or missing." ) );
     }
 
-    // we use std::string because std::string can handle NULL-bytes
+    // we use std::string_view because it can handle NULL-bytes
     // wxString would end the string at the first NULL-byte
-    std::string str = std::string( m_pos, length - ( hasNullByte ? 1 : 0 ) );
+    std::string_view str( m_pos, length - ( hasNullByte ? 1 : 0 ) );
     m_pos += length;
 
-    std::size_t token_end = 0;
+    std::size_t token_start = str.find( '|' );
 
-    while( token_end < str.size() && token_end != std::string::npos )
+    while( token_start != std::string_view::npos )
     {
-        std::size_t token_start = str.find( '|', token_end );
+        std::size_t token_end = str.find( '|', token_start + 1 );
         std::size_t token_equal = str.find( '=', token_start );
-        token_end = str.find( '|', token_start + 1 );
+
+        if( token_end == std::string_view::npos )
+            token_end = str.size();
 
         if( token_equal >= token_end )
         {
-            continue; // this looks like an error: skip the entry. Also matches on std::string::npos
+            // this looks like an error: skip the entry
+            token_start = token_end < str.size() ? token_end : std::string_view::npos;
+            continue;
         }
 
-        if( token_end == std::string::npos )
+        std::string_view keyS = str.substr( token_start + 1, token_equal - token_start - 1 );
+        std::string_view valueS = str.substr( token_equal + 1, token_end - token_equal - 1 );
+
+        // Strings end at an embedded NULL-byte, as wxString would
+        keyS = keyS.substr( 0, keyS.find( '\0' ) );
+        valueS = valueS.substr( 0, valueS.find( '\0' ) );
+
+        token_start = token_end < str.size() ? token_end : std::string_view::npos;
+
+        auto keyIt = m_propertyKeys.find( keyS );
+
+        if( keyIt == m_propertyKeys.end() )
         {
-            token_end = str.size() + 1; // this is the correct offset
+            // Keys are ASCII, but are converted as the values for safety
+            wxString key( keyS.data(), wxConvISO8859_1, keyS.size() );
+
+            // Altium stores keys either in Upper, or in CamelCase. Lets unify it.
+            key.Trim( false ).Trim( true ).MakeUpper();
+            keyIt = m_propertyKeys.emplace( std::string( keyS ), key ).first;
         }
 
-        std::string keyS   = str.substr( token_start + 1, token_equal - token_start - 1 );
-        std::string valueS = str.substr( token_equal + 1, token_end - token_equal - 1 );
+        const wxString& canonicalKey = keyIt->second;
 
-        // convert the strings to wxStrings, since we use them everywhere
-        // value can have non-ASCII characters, so we convert them from LATIN1/ISO8859-1
-        wxString key( keyS.c_str(), wxConvISO8859_1 );
-        // Altium stores keys either in Upper, or in CamelCase. Lets unify it.
-        wxString canonicalKey = key.Trim( false ).Trim( true ).MakeUpper();
         // If the key starts with '%UTF8%' we have to parse the value using UTF8
+        // value can have non-ASCII characters, so we convert them from LATIN1/ISO8859-1
         wxString value;
 
         if( canonicalKey.StartsWith( "%UTF8%" ) )
-            value = wxString( valueS.c_str(), wxConvUTF8 );
+            value = wxString( valueS.data(), wxConvUTF8, valueS.size() );
         else
-            value = wxString( valueS.c_str(), wxConvISO8859_1 );
+            value = wxString( valueS.data(), wxConvISO8859_1, valueS.size() );
 
         // Breathless hack because I haven't a clue what the story is here (but this character
         // appears in a lot of radial dimensions and is rendered by Altium as a space).
-        value.Replace( wxT( "ÿ" ), wxT( " " ) );
+        value.Replace( wxT( "ÿ" ), wxT( "\u00A0" ) );
 
         if( canonicalKey == wxT( "DESIGNATOR" )
                 || canonicalKey == wxT( "NAME" )
@@ -243,7 +259,7 @@ std::map<wxString, wxString> ALTIUM_PARSER::ReadProperties()
             value = AltiumPropertyToKiCadString( value.Trim() );
         }
 
-        kv.insert( { canonicalKey, value.Trim() } );
+        kv.emplace( canonicalKey, value.Trim() );
     }
 
     return kv;
@@ -279,9 +295,17 @@ double ALTIUM_PARSER::ReadDouble( const std::map<wxString, wxString>& aProps, co
     if( value == aProps.end() )
         return aDefault;
 
-    // Locale independent str -> double conversation
-    std::istringstream istr( (const char*) value->second.mb_str() );
-    istr.imbue( std::locale::classic() );
+    // Locale independent str -> double conversation.  The stream is reused, as its creation
+    // costs more than the conversion.
+    thread_local std::istringstream istr = []()
+            {
+                std::istringstream stream;
+                stream.imbue( std::locale::classic() );
+                return stream;
+            }();
+
+    istr.clear();
+    istr.str( (const char*) value->second.mb_str() );
 
     double doubleValue;
     istr >> doubleValue;
@@ -329,10 +353,16 @@ int32_t ALTIUM_PARSER::ReadKicadUnit( const std::map<wxString, wxString>& aProps
 wxString ALTIUM_PARSER::ReadString( const std::map<wxString, wxString>& aProps,
                                     const wxString& aKey, const wxString& aDefault )
 {
-    const auto& utf8Value = aProps.find( wxString( "%UTF8%" ) + aKey );
+    // Most records have no %UTF8% key, check it without building the prefixed key
+    auto firstPrefixed = aProps.lower_bound( wxT( "%" ) );
 
-    if( utf8Value != aProps.end() )
-        return utf8Value->second;
+    if( firstPrefixed != aProps.end() && firstPrefixed->first.StartsWith( wxT( "%" ) ) )
+    {
+        const auto& utf8Value = aProps.find( wxString( "%UTF8%" ) + aKey );
+
+        if( utf8Value != aProps.end() )
+            return utf8Value->second;
+    }
 
     const auto& value = aProps.find( aKey );
 
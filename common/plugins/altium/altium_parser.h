@@ -28,6 +28,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <string>
 
 #include <wx/gdicmn.h>
 #include <math/vector2d.h>
@@ -206,6 +207,12 @@ public:
         return length;
     }
 
+    /**
+     * Read a property list record, as a length followed by "|KEY=VALUE" pairs.
+     *
+     * Keys are returned upper case.  The list is tokenized in place in the stream and the
+     * keys, which repeat in every record of a stream, are only converted once per parser.
+     */
     std::map<wxString, wxString> ReadProperties();
 
     static int32_t ConvertToKicadUnit( const double aValue );
@@ -273,6 +280,9 @@ private:
     char* m_pos;           // current read pointer
     char* m_subrecord_end; // pointer which points to next subrecord start
     bool  m_error;
+
+    /// Canonical property keys, indexed by their raw text in the stream
+    std::map<std::string, wxString, std::less<>> m_propertyKeys;
 };
 
 
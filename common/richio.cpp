@@ -23,7 +23,9 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <ignore.h>
@@ -390,8 +392,121 @@ const char* OUTPUTFORMATTER::GetQuoteChar( const char* wrapee ) const
 }
 
 
+/**
+ * Return true if \a aFmt only uses the %s, %d, %c and %% conversions without any flags,
+ * width, precision or length modifiers.  These make up nearly all of the s-expression
+ * output and can be expanded without going through vsnprintf().
+ */
+static bool isSimpleFormat( const char* aFmt )
+{
+    for( const char* p = aFmt; *p; ++p )
+    {
+        if( *p != '%' )
+            continue;
+
+        ++p;
+
+        if( *p != 's' && *p != 'd' && *p != 'c' && *p != '%' )
+            return false;
+    }
+
+    return true;
+}
+
+
+int OUTPUTFORMATTER::fastvprint( const char* fmt, va_list ap )
+{
+    size_t len = 0;
+
+    auto reserve =
+            [&]( size_t aExtra )
+            {
+                if( len + aExtra > m_buffer.size() )
+                    m_buffer.resize( std::max( m_buffer.size() * 2, len + aExtra ) );
+            };
+
+    for( const char* p = fmt; *p; ++p )
+    {
+        if( *p != '%' )
+        {
+            const char* start = p;
+
+            while( p[1] && p[1] != '%' )
+                ++p;
+
+            size_t count = p - start + 1;
+
+            reserve( count );
+            memcpy( &m_buffer[len], start, count );
+            len += count;
+            continue;
+        }
+
+        switch( *++p )
+        {
+        case 's':
+        {
+            const char* str = va_arg( ap, const char* );
+
+            if( !str )
+                str = "(null)";
+
+            size_t count = strlen( str );
+
+            reserve( count );
+            memcpy( &m_buffer[len], str, count );
+            len += count;
+            break;
+        }
+
+        case 'd':
+        {
+            char     digits[12];
+            int      count = 0;
+            int      value = va_arg( ap, int );
+            unsigned mag = value < 0 ? 0U - (unsigned) value : (unsigned) value;
+
+            do
+            {
+                digits[count++] = (char) ( '0' + mag % 10 );
+                mag /= 10;
+            } while( mag );
+
+            reserve( count + 1 );
+
+            if( value < 0 )
+                m_buffer[len++] = '-';
+
+            while( count )
+                m_buffer[len++] = digits[--count];
+
+            break;
+        }
+
+        case 'c':
+            reserve( 1 );
+            m_buffer[len++] = (char) va_arg( ap, int );
+            break;
+
+        default:    // "%%"
+            reserve( 1 );
+            m_buffer[len++] = '%';
+            break;
+        }
+    }
+
+    if( len > 0 )
+        write( &m_buffer[0], (int) len );
+
+    return (int) len;
+}
+
+
 int OUTPUTFORMATTER::vprint( const char* fmt, va_list ap )
 {
+    if( isSimpleFormat( fmt ) )
+        return fastvprint( fmt, ap );
+
     // This function can call vsnprintf twice.
     // But internally, vsnprintf retrieves arguments from the va_list identified by arg as if
     // va_arg was used on it, and thus the state of the va_list is likely to be altered by the call.
@@ -416,18 +531,6 @@ int OUTPUTFORMATTER::vprint( const char* fmt, va_list ap )
 }
 
 
-int OUTPUTFORMATTER::sprint( const char* fmt, ... )
-{
-    va_list args;
-
-    va_start( args, fmt );
-    int ret = vprint( fmt, args);
-    va_end( args );
-
-    return ret;
-}
-
-
 int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 {
 #define NESTWIDTH           2   ///< how many spaces per nestLevel
@@ -439,12 +542,20 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
     int result = 0;
     int total  = 0;
 
-    for( int i = 0; i < nestLevel; ++i )
+    if( nestLevel > 0 )
     {
-        // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        static const char spaces[] = "                                                                ";
+        int               remaining = nestLevel * NESTWIDTH;
 
-        total += result;
+        while( remaining > 0 )
+        {
+            // no error checking needed, an exception indicates an error.
+            result = std::min( remaining, (int) sizeof( spaces ) - 1 );
+            write( spaces, result );
+
+            remaining -= result;
+            total += result;
+        }
     }
 
     // no error checking needed, an exception indicates an error.
@@ -539,6 +650,10 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName, const wxC
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    // Board and schematic files are written in many small pieces; a large stdio buffer keeps
+    // the number of actual write calls low.
+    setvbuf( m_fp, nullptr, _IOFBF, FILE_OUTPUTFMTBUFZ );
 }
 
 
@@ -809,7 +809,7 @@ int SCH_REFERENCE_LIST::CheckAnnotation( ANNOTATION_ERROR_HANDLER aHandler )
 }
 
 
-SCH_REFERENCE::SCH_REFERENCE( SCH_SYMBOL* aSymbol, LIB_SYMBOL* aLibSymbol,
+SCH_REFERENCE::SCH_REFERENCE( SCH_SYMBOL* aSymbol, const LIB_SYMBOL* aLibSymbol,
                               const SCH_SHEET_PATH& aSheetPath )
 {
     wxASSERT( aSymbol != nullptr );
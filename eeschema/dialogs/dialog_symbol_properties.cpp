@@ -679,10 +679,17 @@ bool DIALOG_SYMBOL_PROPERTIES::TransferDataFromWindow()
     case 2: m_symbol->SetOrientation( SYM_MIRROR_Y ); break;
     }
 
-    if( m_part )
+    if( m_part && ( m_part->ShowPinNames() != m_ShowPinNameButt->GetValue()
+                    || m_part->ShowPinNumbers() != m_ShowPinNumButt->GetValue() ) )
     {
-        m_part->SetShowPinNames( m_ShowPinNameButt->GetValue() );
-        m_part->SetShowPinNumbers( m_ShowPinNumButt->GetValue() );
+        // The library symbol is shared with other symbols and with the undo copy, so change
+        // a copy of it.
+        LIB_SYMBOL* libSymbol = new LIB_SYMBOL( *m_part );
+
+        libSymbol->SetShowPinNames( m_ShowPinNameButt->GetValue() );
+        libSymbol->SetShowPinNumbers( m_ShowPinNumButt->GetValue() );
+        m_symbol->SetLibSymbol( libSymbol );
+        m_part = libSymbol;
     }
 
     // Restore m_Flag modified by SetUnit() and other change settings from the dialog
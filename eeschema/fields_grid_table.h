@@ -120,7 +120,7 @@ private:
     WX_GRID*        m_grid;
     KICAD_T         m_parentType;
     int             m_mandatoryFieldCount;
-    LIB_SYMBOL*     m_part;
+    const LIB_SYMBOL* m_part;
     wxString        m_symbolNetlist;
     wxString        m_curdir;
 
@@ -30,6 +30,7 @@
 #include <dialog_migrate_buses.h>
 #include <dialog_symbol_remap.h>
 #include <eeschema_settings.h>
+#include <gestfich.h>
 #include <id.h>
 #include <kiface_base.h>
 #include <kiplatform/app.h>
@@ -43,12 +44,14 @@
 #include <sch_bus_entry.h>
 #include <sch_edit_frame.h>
 #include <sch_plugins/legacy/sch_legacy_plugin.h>
+#include <sch_plugins/kicad/sch_sexpr_plugin.h>
 #include <sch_file_versions.h>
 #include <sch_line.h>
 #include <sch_sheet.h>
 #include <sch_sheet_path.h>
 #include <schematic.h>
 #include <settings/settings_manager.h>
+#include <thread_pool.h>
 #include <sim/sim_plot_frame.h>
 #include <tool/actions.h>
 #include <tool/tool_manager.h>
@@ -735,7 +738,10 @@ bool SCH_EDIT_FRAME::saveSchematicFile( SCH_SHEET* aSheet, const wxString& aSave
 
     if( success )
     {
-        // Delete auto save file.
+        // Delete auto save file.  Let any auto save still being written finish first so it
+        // doesn't recreate the file afterwards.
+        waitForAutoSave();
+
         wxFileName autoSaveFileName = schematicFileName;
         autoSaveFileName.SetName( GetAutoSaveFilePrefix() + schematicFileName.GetName() );
 
@@ -1118,6 +1124,10 @@ bool SCH_EDIT_FRAME::doAutoSave()
     if( !IsContentModified() )
         return true;
 
+    // Still writing the previous snapshot; try again later
+    if( m_autoSaveResult.valid() )
+        return false;
+
     bool autoSaveOk = true;
 
     if( fn.GetPath().IsEmpty() )
@@ -1133,6 +1143,10 @@ bool SCH_EDIT_FRAME::doAutoSave()
 
     wxString title = GetTitle();    // Save frame title, that can be modified by the save process
 
+    // Serialize the modified sheets into memory.  These are the snapshots that get written out;
+    // the schematic itself is free to change again as soon as we return to the event loop.
+    std::vector<std::pair<wxString, std::string>> snapshots;
+
     for( size_t i = 0; i < screens.GetCount(); i++ )
     {
         // Only create auto save files for the schematics that have been modified.
@@ -1144,32 +1158,122 @@ bool SCH_EDIT_FRAME::doAutoSave()
         // Auto save file name is the normal file name prefixed with GetAutoSavePrefix().
         fn.SetName( GetAutoSaveFilePrefix() + fn.GetName() );
 
-        if( saveSchematicFile( screens.GetSheet( i ), fn.GetFullPath() ) )
+        if( SCH_IO_MGR::GuessPluginTypeFromSchPath( fn.GetFullPath() ) != SCH_IO_MGR::SCH_KICAD )
         {
-            // This was only an auto-save, not a real save.  Reset the modified flag.
-            screens.GetScreen( i )->SetContentModified();
+            // Other formats can only be written straight to a file.
+            if( saveSchematicFile( screens.GetSheet( i ), fn.GetFullPath() ) )
+            {
+                // This was only an auto-save, not a real save.  Reset the modified flag.
+                screens.GetScreen( i )->SetContentModified();
+            }
+            else
+            {
+                autoSaveOk = false;
+            }
+
+            continue;
         }
-        else
+
+        wxLogTrace( traceAutoSave,
+                    wxT( "Creating auto save file <" ) + fn.GetFullPath() + wxT( ">" ) );
+
+        STRING_FORMATTER snapshot;
+
+        try
         {
+            SCH_SEXPR_PLUGIN pi;
+            pi.FormatSchematic( screens.GetSheet( i ), &Schematic(), &snapshot );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxLogTrace( traceAutoSave, wxT( "Auto save failed: " ) + ioe.What() );
             autoSaveOk = false;
+            continue;
         }
+
+        snapshots.emplace_back( fn.GetFullPath(), snapshot.GetString() );
     }
 
-    if( autoSaveOk && updateAutoSaveFile() )
+    SetTitle( title );
+
+    if( !autoSaveOk || !updateAutoSaveFile() )
+        return false;
+
+    // Edits made from now on need another auto save
+    m_autoSaveRequired = false;
+    m_autoSavePending = false;
+
+    if( snapshots.empty() )
     {
-        m_autoSaveRequired = false;
-        m_autoSavePending = false;
+        onAutoSaveWritten();
+        return true;
+    }
 
-        if( !Kiface().IsSingle()
-                && GetSettingsManager()->GetCommonSettings()->m_Backup.backup_on_autosave )
-        {
-            GetSettingsManager()->TriggerBackupIfNeeded( NULL_REPORTER::GetInstance() );
-        }
+    SetStatusText( _( "Auto saving schematic..." ), 0 );
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         files = std::make_shared<decltype( snapshots )>( std::move( snapshots ) );
+
+    m_autoSaveResult = tp.submit(
+            [this, files]() -> wxString
+            {
+                wxString errors;
+
+                for( const std::pair<wxString, std::string>& snapshot : *files )
+                {
+                    try
+                    {
+                        KiWriteFileAtomically( snapshot.first, snapshot.second );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        errors += ioe.What() + wxT( "\n" );
+                    }
+                }
+
+                CallAfter( [this]()
+                           {
+                               onAutoSaveWritten();
+                           } );
+
+                return errors;
+            } );
+
+    return true;
+}
+
+
+void SCH_EDIT_FRAME::onAutoSaveWritten()
+{
+    wxString error;
+
+    if( m_autoSaveResult.valid() )
+        error = m_autoSaveResult.get();
+
+    if( !error.IsEmpty() )
+    {
+        wxLogTrace( traceAutoSave, wxT( "Auto save failed: " ) + error );
+        SetStatusText( _( "Auto save failed." ), 0 );
+
+        // Make sure the next idle cycle schedules another attempt
+        m_autoSaveRequired = true;
+        return;
     }
 
-    SetTitle( title );
+    SetStatusText( _( "Auto save complete." ), 0 );
 
-    return autoSaveOk;
+    if( !Kiface().IsSingle()
+            && GetSettingsManager()->GetCommonSettings()->m_Backup.backup_on_autosave )
+    {
+        GetSettingsManager()->TriggerBackupIfNeeded( NULL_REPORTER::GetInstance() );
+    }
+}
+
+
+void SCH_EDIT_FRAME::waitForAutoSave()
+{
+    if( m_autoSaveResult.valid() )
+        m_autoSaveResult.wait();
 }
 
 
@@ -1111,6 +1111,23 @@ void LIB_SYMBOL::GetFields( std::vector<LIB_FIELD>& aList )
 }
 
 
+void LIB_SYMBOL::GetFields( std::vector<const LIB_FIELD*>& aList ) const
+{
+    // Grab the MANDATORY_FIELDS first, in expected order given by enum MANDATORY_FIELD_T
+    for( int id = 0; id < MANDATORY_FIELDS; ++id )
+        aList.push_back( GetFieldById( id ) );
+
+    // Now grab all the rest of fields.
+    for( const LIB_ITEM& item : m_drawings[ LIB_FIELD_T ] )
+    {
+        const LIB_FIELD* field = static_cast<const LIB_FIELD*>( &item );
+
+        if( !field->IsMandatory() )
+            aList.push_back( field );
+    }
+}
+
+
 LIB_FIELD* LIB_SYMBOL::GetFieldById( int aId ) const
 {
     for( const LIB_ITEM& item : m_drawings[ LIB_FIELD_T ] )
@@ -144,6 +144,11 @@ public:
     void SetDescription( const wxString& aDescription ) { m_description = aDescription; }
 
     wxString GetDescription() override
+    {
+        return static_cast<const LIB_SYMBOL*>( this )->GetDescription();
+    }
+
+    wxString GetDescription() const
     {
         if( m_description.IsEmpty() && IsAlias() )
         {
@@ -270,6 +275,7 @@ public:
      */
     void GetFields( std::vector<LIB_FIELD*>& aList );
     void GetFields( std::vector<LIB_FIELD>& aList );
+    void GetFields( std::vector<const LIB_FIELD*>& aList ) const;
 
     /**
      * Add a field.  Takes ownership of the pointer.
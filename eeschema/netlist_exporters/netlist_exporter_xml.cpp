@@ -357,7 +357,7 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
                 xproperty->AddAttribute( wxT( "name" ), wxT( "dnp" ) );
             }
 
-            if( const std::unique_ptr<LIB_SYMBOL>& part = symbol->GetLibSymbolRef() )
+            if( std::shared_ptr<const LIB_SYMBOL> part = symbol->GetLibSymbolRef() )
             {
                 if( part->GetDescription().size() )
                 {
@@ -539,11 +539,11 @@ XNODE* NETLIST_EXPORTER_XML::makeLibParts()
     XNODE*                  xlibparts = node( wxT( "libparts" ) );   // auto_ptr
 
     LIB_PINS                pinList;
-    std::vector<LIB_FIELD*> fieldList;
+    std::vector<const LIB_FIELD*> fieldList;
 
     m_libraries.clear();
 
-    for( LIB_SYMBOL* lcomp : m_libParts )
+    for( const LIB_SYMBOL* lcomp : m_libParts )
     {
         wxString libNickname = lcomp->GetLibId().GetLibNickname();;
 
@@ -560,8 +560,10 @@ XNODE* NETLIST_EXPORTER_XML::makeLibParts()
         if( !lcomp->GetDescription().IsEmpty() )
             xlibpart->AddChild( node( wxT( "description" ), lcomp->GetDescription() ) );
 
-        if( !lcomp->GetDatasheetField().GetText().IsEmpty() )
-            xlibpart->AddChild( node( wxT( "docs" ),  lcomp->GetDatasheetField().GetText() ) );
+        const LIB_FIELD* datasheet = lcomp->GetFieldById( DATASHEET_FIELD );
+
+        if( !datasheet->GetText().IsEmpty() )
+            xlibpart->AddChild( node( wxT( "docs" ),  datasheet->GetText() ) );
 
         // Write the footprint list
         if( lcomp->GetFPFilters().GetCount() )
@@ -284,6 +284,9 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
 SCH_EDIT_FRAME::~SCH_EDIT_FRAME()
 {
+    // The auto save worker calls back into this frame when it finishes
+    waitForAutoSave();
+
     m_hierarchy->Disconnect( wxEVT_SIZE,
                              wxSizeEventHandler( SCH_EDIT_FRAME::OnResizeHierarchyNavigator ),
                              NULL, this );
@@ -27,6 +27,7 @@
 #define  SCH_EDIT_FRAME_H
 
 #include <stddef.h>
+#include <future>
 #include <vector>
 #include <wx/cmndata.h>
 #include <wx/event.h>
@@ -837,6 +838,16 @@ protected:
      */
     bool doAutoSave() override;
 
+    /**
+     * Called on the GUI thread once the background auto save write has finished.
+     */
+    void onAutoSaveWritten();
+
+    /**
+     * Block until any auto save being written in the background has finished.
+     */
+    void waitForAutoSave();
+
     /**
      * Send the KiCad netlist over to CVPCB.
      */
@@ -936,6 +947,8 @@ private:
     HIERARCHY_NAVIG_PANEL*  m_hierarchy;
 
 	bool m_syncingPcbToSchSelection; // Recursion guard when synchronizing selection from PCB
+
+    std::future<wxString> m_autoSaveResult;    ///< Pending background auto save write
 };
 
 
@@ -58,6 +58,7 @@
 #include "sch_sexpr_lib_plugin_cache.h"
 #include "sch_sexpr_plugin_common.h"
 #include <symbol_lib_table.h>  // for PropPowerSymsOnly definition.
+#include <thread_pool.h>
 #include <ee_selection.h>
 #include <string_utils.h>
 #include <wx_filename.h>       // for ::ResolvePossibleSymlinks()
@@ -81,6 +82,7 @@ SCH_SEXPR_PLUGIN::SCH_SEXPR_PLUGIN() :
 
 SCH_SEXPR_PLUGIN::~SCH_SEXPR_PLUGIN()
 {
+    clearPrefetchedSheets();
     delete m_cache;
 }
 
@@ -151,7 +153,20 @@ SCH_SHEET* SCH_SEXPR_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
 
         newSheet->SetFileName( relPath.GetFullPath() );
         m_rootSheet = newSheet.get();
-        loadHierarchy( SCH_SHEET_PATH(), newSheet.get() );
+
+        try
+        {
+            loadHierarchy( SCH_SHEET_PATH(), newSheet.get() );
+        }
+        catch( ... )
+        {
+            // The sub-sheet parsers reference the root sheet so they must be done before
+            // it gets deleted.
+            clearPrefetchedSheets();
+            throw;
+        }
+
+        clearPrefetchedSheets();
 
         // If we got here, the schematic loaded successfully.
         sheet = newSheet.release();
@@ -162,7 +177,18 @@ SCH_SHEET* SCH_SEXPR_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
         wxCHECK_MSG( aSchematic->IsValid(), nullptr, "Can't append to a schematic with no root!" );
         m_rootSheet = &aSchematic->Root();
         sheet = aAppendToMe;
-        loadHierarchy( SCH_SHEET_PATH(), sheet );
+
+        try
+        {
+            loadHierarchy( SCH_SHEET_PATH(), sheet );
+        }
+        catch( ... )
+        {
+            clearPrefetchedSheets();
+            throw;
+        }
+
+        clearPrefetchedSheets();
     }
 
     wxASSERT( m_currentPath.size() == 1 );  // only the project path should remain
@@ -230,12 +256,56 @@ void SCH_SEXPR_PLUGIN::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SC
         }
         else
         {
-            aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+            auto prefetched = m_prefetchedSheets.find( fileName.GetFullPath() );
 
             try
             {
-                loadFile( fileName.GetFullPath(), aSheet );
+                if( prefetched != m_prefetchedSheets.end() && aSheet != m_rootSheet )
+                {
+                    PREFETCHED_SHEET sheetData = std::move( prefetched->second );
+                    m_prefetchedSheets.erase( prefetched );
+
+                    bool cancelled = false;
+
+                    if( m_progressReporter )
+                    {
+                        m_progressReporter->Report( wxString::Format( _( "Loading %s..." ),
+                                                                      fileName.GetFullPath() ) );
+                        cancelled = !m_progressReporter->KeepRefreshing();
+                    }
+
+                    // The scratch sheet must outlive its parser so always wait for it.
+                    wxString error = sheetData.m_result.get();
+
+                    if( cancelled )
+                    {
+                        aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+                        aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+                        THROW_IO_ERROR( ( "Open cancelled by user." ) );
+                    }
+
+                    // Take over the screen parsed into the scratch sheet.
+                    aSheet->SetScreen( sheetData.m_sheet->GetScreen() );
+                    sheetData.m_sheet->SetScreen( nullptr );
+
+                    for( SCH_ITEM* item : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
+                        item->SetParent( aSheet );
+
+                    if( !error.IsEmpty() )
+                    {
+                        if( !m_error.IsEmpty() )
+                            m_error += "\n";
+
+                        m_error += error;
+                    }
+                }
+                else
+                {
+                    aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+                    aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+
+                    loadFile( fileName.GetFullPath(), aSheet );
+                }
             }
             catch( const IO_ERROR& ioe )
             {
@@ -261,6 +331,9 @@ void SCH_SEXPR_PLUGIN::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SC
                 aSheet->GetScreen()->SetFileExists( false );
             }
 
+            // Sub-sheet files are parsed in the background while the hierarchy is walked.
+            prefetchSheets( aSheet->GetScreen() );
+
             SCH_SHEET_PATH currentSheetPath = aParentSheetPath;
             currentSheetPath.push_back( aSheet );
 
@@ -307,6 +380,80 @@ void SCH_SEXPR_PLUGIN::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
 }
 
 
+void SCH_SEXPR_PLUGIN::prefetchSheets( SCH_SCREEN* aScreen )
+{
+    thread_pool& tp = GetKiCadThreadPool();
+
+    if( tp.get_thread_count() < 2 )
+        return;
+
+    for( SCH_ITEM* item : aScreen->Items().OfType( SCH_SHEET_T ) )
+    {
+        SCH_SHEET* sheet = static_cast<SCH_SHEET*>( item );
+        wxFileName fileName = sheet->GetFileName();
+
+        if( !fileName.IsAbsolute() )
+            fileName.MakeAbsolute( m_currentPath.top() );
+
+        wxString fullPath = fileName.GetFullPath();
+
+        if( fullPath.IsEmpty() || !fileName.FileExists()
+                || m_prefetchedSheets.count( fullPath ) )
+        {
+            continue;
+        }
+
+        // Screens already in the hierarchy (including all ancestors) will be shared rather
+        // than loaded so there is nothing to parse.
+        SCH_SCREEN* existing = nullptr;
+        m_rootSheet->SearchHierarchy( fullPath, &existing );
+
+        if( existing )
+            continue;
+
+        PREFETCHED_SHEET& prefetched = m_prefetchedSheets[fullPath];
+
+        prefetched.m_sheet = std::make_unique<SCH_SHEET>( m_schematic );
+        prefetched.m_sheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+        prefetched.m_sheet->GetScreen()->SetFileName( fullPath );
+
+        SCH_SHEET* scratchSheet = prefetched.m_sheet.get();
+        SCH_SHEET* rootSheet = m_rootSheet;
+        bool       appending = m_appending;
+
+        prefetched.m_result = tp.submit(
+                [fullPath, scratchSheet, rootSheet, appending]() -> wxString
+                {
+                    try
+                    {
+                        FILE_LINE_READER reader( fullPath );
+                        SCH_SEXPR_PARSER parser( &reader, nullptr, 0, rootSheet, appending );
+
+                        parser.ParseSchematic( scratchSheet );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        return ioe.What();
+                    }
+
+                    return wxEmptyString;
+                } );
+    }
+}
+
+
+void SCH_SEXPR_PLUGIN::clearPrefetchedSheets()
+{
+    for( std::pair<const wxString, PREFETCHED_SHEET>& entry : m_prefetchedSheets )
+    {
+        if( entry.second.m_result.valid() )
+            entry.second.m_result.wait();
+    }
+
+    m_prefetchedSheets.clear();
+}
+
+
 void SCH_SEXPR_PLUGIN::LoadContent( LINE_READER& aReader, SCH_SHEET* aSheet, int aFileVersion )
 {
     wxCHECK( aSheet, /* void */ );
@@ -324,10 +471,6 @@ void SCH_SEXPR_PLUGIN::Save( const wxString& aFileName, SCH_SHEET* aSheet, SCHEM
     wxCHECK_RET( aSheet != nullptr, "NULL SCH_SHEET object." );
     wxCHECK_RET( !aFileName.IsEmpty(), "No schematic file name defined." );
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale, to write floating point values.
-
-    init( aSchematic, aProperties );
-
     wxFileName fn = aFileName;
 
     // File names should be absolute.  Don't assume everything relative to the project path
@@ -336,14 +479,28 @@ void SCH_SEXPR_PLUGIN::Save( const wxString& aFileName, SCH_SHEET* aSheet, SCHEM
 
     FILE_OUTPUTFORMATTER formatter( fn.GetFullPath() );
 
-    m_out = &formatter;     // no ownership
-
-    Format( aSheet );
+    FormatSchematic( aSheet, aSchematic, &formatter, aProperties );
 
     aSheet->GetScreen()->SetFileExists( true );
 }
 
 
+void SCH_SEXPR_PLUGIN::FormatSchematic( SCH_SHEET* aSheet, SCHEMATIC* aSchematic,
+                                        OUTPUTFORMATTER* aFormatter,
+                                        const STRING_UTF8_MAP* aProperties )
+{
+    wxCHECK_RET( aSheet != nullptr, "NULL SCH_SHEET object." );
+
+    LOCALE_IO   toggle;     // toggles on, then off, the C locale, to write floating point values.
+
+    init( aSchematic, aProperties );
+
+    m_out = aFormatter;     // no ownership
+
+    Format( aSheet );
+}
+
+
 void SCH_SEXPR_PLUGIN::Format( SCH_SHEET* aSheet )
 {
     wxCHECK_RET( aSheet != nullptr, "NULL SCH_SHEET* object." );
@@ -23,6 +23,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
+#include <map>
 #include <memory>
 #include <sch_io_mgr.h>
 #include <sch_file_versions.h>
@@ -105,6 +107,17 @@ public:
     void Save( const wxString& aFileName, SCH_SHEET* aSheet, SCHEMATIC* aSchematic,
                const STRING_UTF8_MAP* aProperties = nullptr ) override;
 
+    /**
+     * Output \a aSheet as a complete schematic file to \a aFormatter.
+     *
+     * Unlike Save(), this does not create any file, so it can be used to take an in-memory
+     * snapshot of the sheet.
+     *
+     * @throw IO_ERROR on write error.
+     */
+    void FormatSchematic( SCH_SHEET* aSheet, SCHEMATIC* aSchematic, OUTPUTFORMATTER* aFormatter,
+                          const STRING_UTF8_MAP* aProperties = nullptr );
+
     void Format( SCH_SHEET* aSheet );
 
     void Format( EE_SELECTION* aSelection, SCH_SHEET_PATH* aSelectionPath,
@@ -145,6 +158,19 @@ private:
     void loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SCH_SHEET* aSheet );
     void loadFile( const wxString& aFileName, SCH_SHEET* aSheet );
 
+    /**
+     * Start parsing the files of the sub-sheets of \a aScreen on the thread pool.
+     *
+     * Each file is parsed into a scratch sheet which #loadHierarchy() adopts when it reaches
+     * the sheet in the normal, serial walk of the hierarchy.  Shared screen detection and the
+     * ancestor loop checks are still done by the serial walk so parsing a file that ends up
+     * not being used is harmless.
+     */
+    void prefetchSheets( SCH_SCREEN* aScreen );
+
+    /// Wait for any outstanding sub-sheet parsing and free the unused results.
+    void clearPrefetchedSheets();
+
     void saveSymbol( SCH_SYMBOL* aSymbol, const SCHEMATIC& aSchematic, int aNestLevel,
                      bool aForClipboard );
     void saveField( SCH_FIELD* aField, int aNestLevel );
@@ -178,6 +204,15 @@ protected:
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
     SCH_SEXPR_PLUGIN_CACHE* m_cache;
 
+    struct PREFETCHED_SHEET
+    {
+        std::unique_ptr<SCH_SHEET> m_sheet;   ///< Scratch sheet owning the parsed screen.
+        std::future<wxString>      m_result;  ///< Parser error message or empty on success.
+    };
+
+    /// Sub-sheet files being parsed ahead of the hierarchy walk, keyed by absolute file name.
+    std::map<wxString, PREFETCHED_SHEET> m_prefetchedSheets;
+
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aProperties = nullptr );
 };
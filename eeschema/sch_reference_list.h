@@ -88,11 +88,12 @@ public:
         m_sheetNum        = 0;
     }
 
-    SCH_REFERENCE( SCH_SYMBOL* aSymbol, LIB_SYMBOL* aLibSymbol, const SCH_SHEET_PATH& aSheetPath );
+    SCH_REFERENCE( SCH_SYMBOL* aSymbol, const LIB_SYMBOL* aLibSymbol,
+                   const SCH_SHEET_PATH& aSheetPath );
 
     SCH_SYMBOL* GetSymbol() const           { return m_rootSymbol; }
 
-    LIB_SYMBOL* GetLibPart() const          { return m_libPart; }
+    const LIB_SYMBOL* GetLibPart() const    { return m_libPart; }
 
     const SCH_SHEET_PATH& GetSheetPath() const { return m_sheetPath; }
 
@@ -219,7 +220,7 @@ private:
     /// Symbol reference prefix, without number (for IC1, this is IC) )
     wxString        m_ref;               // it's private, use the accessors please
     SCH_SYMBOL*     m_rootSymbol;        ///< The symbol associated the reference object.
-    LIB_SYMBOL*     m_libPart;           ///< The source symbol from a library.
+    const LIB_SYMBOL* m_libPart;         ///< The source symbol from a library.
     VECTOR2I        m_symbolPos;         ///< The physical position of the symbol in schematic
                                          ///< used to annotate by X or Y position
     int             m_unit;              ///< The unit number for symbol with multiple parts
@@ -100,6 +100,27 @@ void SCH_SCREEN::clearLibSymbols()
         delete libSymbol.second;
 
     m_libSymbols.clear();
+    m_sharedLibSymbols.clear();
+}
+
+
+std::shared_ptr<LIB_SYMBOL> SCH_SCREEN::getSharedLibSymbol( const wxString& aName )
+{
+    auto sharedIt = m_sharedLibSymbols.find( aName );
+
+    if( sharedIt != m_sharedLibSymbols.end() )
+        return sharedIt->second;
+
+    auto it = m_libSymbols.find( aName );
+
+    if( it == m_libSymbols.end() || !it->second )
+        return nullptr;
+
+    // Internal library symbols are already flattened so just make a copy.
+    std::shared_ptr<LIB_SYMBOL> libSymbol = std::make_shared<LIB_SYMBOL>( *it->second );
+
+    m_sharedLibSymbols[aName] = libSymbol;
+    return libSymbol;
 }
 
 
@@ -149,16 +170,16 @@ void SCH_SCREEN::Append( SCH_ITEM* aItem )
         {
             SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( aItem );
 
-            if( symbol->GetLibSymbolRef() )
+            if( std::shared_ptr<const LIB_SYMBOL> libSymbol = symbol->GetLibSymbolRef() )
             {
-                symbol->GetLibSymbolRef()->GetDrawItems().sort();
-
                 auto it = m_libSymbols.find( symbol->GetSchSymbolLibraryName() );
 
                 if( it == m_libSymbols.end() || !it->second )
                 {
-                    m_libSymbols[symbol->GetSchSymbolLibraryName()] =
-                            new LIB_SYMBOL( *symbol->GetLibSymbolRef() );
+                    LIB_SYMBOL* newLibSymbol = new LIB_SYMBOL( *libSymbol );
+
+                    newLibSymbol->GetDrawItems().sort();
+                    m_libSymbols[symbol->GetSchSymbolLibraryName()] = newLibSymbol;
                 }
                 else
                 {
@@ -167,10 +188,24 @@ void SCH_SCREEN::Append( SCH_ITEM* aItem )
                     // must be created for the library symbol list to prevent all of the
                     // other schematic symbols referencing that library symbol from changing.
                     LIB_SYMBOL* foundSymbol = it->second;
+                    auto        sharedIt = m_sharedLibSymbols.find( it->first );
 
                     foundSymbol->GetDrawItems().sort();
 
-                    if( *foundSymbol != *symbol->GetLibSymbolRef() )
+                    // Symbols sharing the screen copy of the library symbol are up to date.
+                    // Otherwise compare a sorted copy, the symbol's library symbol may be
+                    // shared with other symbols and must not be changed.
+                    bool changed = false;
+
+                    if( sharedIt == m_sharedLibSymbols.end() || sharedIt->second != libSymbol )
+                    {
+                        LIB_SYMBOL sortedSymbol( *libSymbol );
+
+                        sortedSymbol.GetDrawItems().sort();
+                        changed = *foundSymbol != sortedSymbol;
+                    }
+
+                    if( changed )
                     {
                         int cnt = 1;
                         wxString newName;
@@ -189,7 +224,7 @@ void SCH_SCREEN::Append( SCH_ITEM* aItem )
                         // in the schematic.
                         symbol->SetSchSymbolLibraryName( newName );
 
-                        LIB_SYMBOL* newLibSymbol = new LIB_SYMBOL( *symbol->GetLibSymbolRef() );
+                        LIB_SYMBOL* newLibSymbol = new LIB_SYMBOL( *libSymbol );
                         LIB_ID newLibId( wxEmptyString, newName );
 
                         newLibSymbol->SetLibId( newLibId );
@@ -293,6 +328,7 @@ bool SCH_SCREEN::Remove( SCH_ITEM* aItem )
 
             if( it != m_libSymbols.end() )
             {
+                m_sharedLibSymbols.erase( it->first );
                 delete it->second;
                 m_libSymbols.erase( it );
             }
@@ -881,8 +917,7 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
                 aReporter->ReportTail( msg, RPT_SEVERITY_INFO );
             }
 
-            // Internal library symbols are already flattened so just make a copy.
-            symbol->SetLibSymbol( new LIB_SYMBOL( *it->second ) );
+            symbol->SetSharedLibSymbol( getSharedLibSymbol( it->first ) );
             continue;
         }
 
@@ -961,8 +996,7 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
             libSymbol = tmp->Flatten();
             libSymbol->SetParent();
 
-            m_libSymbols.insert( { symbol->GetSchSymbolLibraryName(),
-                                   new LIB_SYMBOL( *libSymbol.get() ) } );
+            m_libSymbols.insert( { symbol->GetSchSymbolLibraryName(), libSymbol.release() } );
 
             if( aReporter )
             {
@@ -984,7 +1018,8 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
             }
         }
 
-        symbol->SetLibSymbol( libSymbol.release() );
+        // All the symbols linked to the same library symbol share it
+        symbol->SetSharedLibSymbol( getSharedLibSymbol( symbol->GetSchSymbolLibraryName() ) );
     }
 
     // Changing the symbol may adjust the bbox of the symbol.  This re-inserts the
@@ -1006,14 +1041,7 @@ void SCH_SCREEN::UpdateLocalLibSymbolLinks()
         // Changing the symbol may adjust the bbox of the symbol; remove and reinsert it afterwards.
         m_rtree.remove( symbol );
 
-        auto it = m_libSymbols.find( symbol->GetSchSymbolLibraryName() );
-
-        LIB_SYMBOL* libSymbol = nullptr;
-
-        if( it != m_libSymbols.end() )
-            libSymbol = new LIB_SYMBOL( *it->second );
-
-        symbol->SetLibSymbol( libSymbol );
+        symbol->SetSharedLibSymbol( getSharedLibSymbol( symbol->GetSchSymbolLibraryName() ) );
 
         m_rtree.insert( symbol );
     }
@@ -1185,20 +1213,25 @@ LIB_PIN* SCH_SCREEN::GetPin( const VECTOR2I& aPosition, SCH_SYMBOL** aSymbol,
             if( !candidate->GetLibSymbolRef() )
                 continue;
 
-            for( pin = candidate->GetLibSymbolRef()->GetNextPin(); pin;
-                 pin = candidate->GetLibSymbolRef()->GetNextPin( pin ) )
+            LIB_PINS libPins;
+            candidate->GetLibSymbolRef()->GetPins( libPins );
+
+            for( LIB_PIN* libPin : libPins )
             {
                 // Skip items not used for this part.
-                if( candidate->GetUnit() && pin->GetUnit() &&
-                    ( pin->GetUnit() != candidate->GetUnit() ) )
+                if( candidate->GetUnit() && libPin->GetUnit() &&
+                    ( libPin->GetUnit() != candidate->GetUnit() ) )
                     continue;
 
-                if( candidate->GetConvert() && pin->GetConvert() &&
-                    ( pin->GetConvert() != candidate->GetConvert() ) )
+                if( candidate->GetConvert() && libPin->GetConvert() &&
+                    ( libPin->GetConvert() != candidate->GetConvert() ) )
                     continue;
 
-                if( candidate->GetPinPhysicalPosition( pin ) == aPosition )
+                if( candidate->GetPinPhysicalPosition( libPin ) == aPosition )
+                {
+                    pin = libPin;
                     break;
+                }
             }
 
             if( pin )
@@ -1413,6 +1446,7 @@ void SCH_SCREEN::AddLibSymbol( LIB_SYMBOL* aLibSymbol )
         m_libSymbols.erase( it );
     }
 
+    m_sharedLibSymbols.erase( libSymbolName );
     m_libSymbols[libSymbolName] = aLibSymbol;
 }
 
@@ -532,6 +532,14 @@ private:
 
     void clearLibSymbols();
 
+    /**
+     * Return the library symbol \a aName of the library symbol map, shared by all the
+     * schematic symbols of this screen linked to it.
+     *
+     * @return the shared library symbol or nullptr if \a aName is not in the map.
+     */
+    std::shared_ptr<LIB_SYMBOL> getSharedLibSymbol( const wxString& aName );
+
     wxString    m_fileName;                 // File used to load the screen.
     int         m_fileFormatVersionAtLoad;
     int         m_refCount;                 // Number of sheets referencing this screen.
@@ -568,6 +576,9 @@ private:
     /// Library symbols required for this schematic.
     std::map<wxString, LIB_SYMBOL*> m_libSymbols;
 
+    /// Copies of m_libSymbols shared by the schematic symbols, created on demand.
+    std::map<wxString, std::shared_ptr<LIB_SYMBOL>> m_sharedLibSymbols;
+
     /**
      * The list of symbol instances loaded from the schematic file.
      *
@@ -180,8 +180,9 @@ SCH_SYMBOL::SCH_SYMBOL( const SCH_SYMBOL& aSymbol ) :
     m_onBoard     = aSymbol.m_onBoard;
     m_DNP         = aSymbol.m_DNP;
 
+    // The library symbol is never modified once set, so the copy can share it
     if( aSymbol.m_part )
-        SetLibSymbol( new LIB_SYMBOL( *aSymbol.m_part.get() ) );
+        SetSharedLibSymbol( aSymbol.m_part );
 
     const_cast<KIID&>( m_Uuid ) = aSymbol.m_Uuid;
 
@@ -307,6 +308,17 @@ void SCH_SYMBOL::SetLibSymbol( LIB_SYMBOL* aLibSymbol )
 }
 
 
+void SCH_SYMBOL::SetSharedLibSymbol( const std::shared_ptr<LIB_SYMBOL>& aLibSymbol )
+{
+    std::shared_ptr<LIB_SYMBOL> libSymbol = aLibSymbol;
+
+    wxCHECK2( !libSymbol || libSymbol->IsRoot(), libSymbol.reset() );
+
+    m_part = libSymbol;
+    UpdatePins();
+}
+
+
 wxString SCH_SYMBOL::GetDescription() const
 {
     if( m_part )
@@ -1127,10 +1139,8 @@ void SCH_SYMBOL::SwapData( SCH_ITEM* aItem )
 
     std::swap( m_lib_id, symbol->m_lib_id );
 
-    LIB_SYMBOL* libSymbol = symbol->m_part.release();
-    symbol->m_part.reset( m_part.release() );
+    m_part.swap( symbol->m_part );
     symbol->UpdatePins();
-    m_part.reset( libSymbol );
     UpdatePins();
 
     std::swap( m_pos, symbol->m_pos );
@@ -2040,9 +2050,7 @@ SCH_SYMBOL& SCH_SYMBOL::operator=( const SCH_ITEM& aItem )
 
         m_lib_id    = c->m_lib_id;
 
-        LIB_SYMBOL* libSymbol = c->m_part ? new LIB_SYMBOL( *c->m_part.get() ) : nullptr;
-
-        m_part.reset( libSymbol );
+        m_part      = c->m_part;    // shared, library symbols are never modified once set
         m_pos       = c->m_pos;
         m_unit      = c->m_unit;
         m_convert   = c->m_convert;
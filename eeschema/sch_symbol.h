@@ -186,8 +186,11 @@ public:
     wxString GetSchSymbolLibraryName() const;
     bool UseLibIdLookup() const { return m_schLibSymbolName.IsEmpty(); }
 
-    std::unique_ptr< LIB_SYMBOL >& GetLibSymbolRef() { return m_part; }
-    const std::unique_ptr< LIB_SYMBOL >& GetLibSymbolRef() const { return m_part; }
+    /**
+     * @return the flattened library symbol, which may be shared with other schematic symbols.
+     *         To change it, set a modified copy with SetLibSymbol().
+     */
+    std::shared_ptr< const LIB_SYMBOL > GetLibSymbolRef() const { return m_part; }
 
     /**
      * Set this schematic symbol library symbol reference to \a aLibSymbol
@@ -199,14 +202,26 @@ public:
      * symbol will be cleared.  The new file format will no longer require a cache
      * library so all library symbols must be valid.
      *
-     * @note This is the only way to publicly set the library symbol for a schematic
-     *       symbol except for the ctors that take a LIB_SYMBOL reference.  All previous
-     *       public resolvers have been deprecated.
+     * @note This and SetSharedLibSymbol() are the only ways to publicly set the library
+     *       symbol for a schematic symbol except for the ctors that take a LIB_SYMBOL
+     *       reference.  All previous public resolvers have been deprecated.
      *
      * @param aLibSymbol is the library symbol to associate with this schematic symbol.
      */
     void SetLibSymbol( LIB_SYMBOL* aLibSymbol );
 
+    /**
+     * Set this schematic symbol library symbol reference to \a aLibSymbol, shared with the
+     * other schematic symbols using the same library symbol.
+     *
+     * The symbols sharing a library symbol only differ by their own unit, body style, fields
+     * and pins, so the library symbol must not be modified once shared.  Use SetLibSymbol()
+     * with a new copy to change it.
+     *
+     * @param aLibSymbol is the library symbol to associate with this schematic symbol.
+     */
+    void SetSharedLibSymbol( const std::shared_ptr<LIB_SYMBOL>& aLibSymbol );
+
     /**
      * @return the associated LIB_SYMBOL's description field (or wxEmptyString).
      */
@@ -783,8 +798,9 @@ private:
     TRANSFORM                              m_transform; ///< The rotation/mirror transformation.
     std::vector<SCH_FIELD>                 m_fields;    ///< Variable length list of fields.
 
-    std::unique_ptr< LIB_SYMBOL >          m_part;      ///< a flattened copy of the LIB_SYMBOL
-                                                        ///<   from the PROJECT's libraries.
+    std::shared_ptr< LIB_SYMBOL >          m_part;      ///< a flattened copy of the LIB_SYMBOL
+                                                        ///<   from the PROJECT's libraries,
+                                                        ///<   shared by the symbols using it.
     std::vector<std::unique_ptr<SCH_PIN>>  m_pins;      ///< a SCH_PIN for every LIB_PIN (all units)
     std::unordered_map<LIB_PIN*, unsigned> m_pinMap;    ///< library pin pointer : SCH_PIN's index
 
@@ -755,13 +755,13 @@ int SCH_EDITOR_CONTROL::ExportSymbolsToLibrary( const TOOL_EVENT& aEvent )
     SCH_REFERENCE_LIST symbols;
     m_frame->Schematic().GetSheets().GetSymbols( symbols, false );
 
-    std::map<LIB_ID, LIB_SYMBOL*> libSymbols;
+    std::map<LIB_ID, const LIB_SYMBOL*> libSymbols;
     std::map<LIB_ID, std::vector<SCH_SYMBOL*>> symbolMap;
 
     for( size_t i = 0; i < symbols.GetCount(); ++i )
     {
         SCH_SYMBOL* symbol = symbols[i].GetSymbol();
-        LIB_SYMBOL* libSymbol = symbol->GetLibSymbolRef().get();
+        const LIB_SYMBOL* libSymbol = symbol->GetLibSymbolRef().get();
         LIB_ID id = libSymbol->GetLibId();
 
         if( libSymbols.count( id ) )
@@ -827,9 +827,9 @@ int SCH_EDITOR_CONTROL::ExportSymbolsToLibrary( const TOOL_EVENT& aEvent )
     wxFileName dest = row->GetFullURI( true );
     dest.Normalize( FN_NORMALIZE_FLAGS | wxPATH_NORM_ENV_VARS );
 
-    for( const std::pair<const LIB_ID, LIB_SYMBOL*>& it : libSymbols )
+    for( const std::pair<const LIB_ID, const LIB_SYMBOL*>& it : libSymbols )
     {
-        LIB_SYMBOL* origSym = it.second;
+        const LIB_SYMBOL* origSym = it.second;
         LIB_SYMBOL* newSym = origSym->Flatten().release();
 
         pi->SaveSymbol( dest.GetFullPath(), newSym );
@@ -168,8 +168,9 @@ protected:
     RELATION m_relation;
     double   m_value;
 
-    static wxRegEx m_regex_description;
-    static wxRegEx m_regex_search;
+    // wxRegEx keeps the state of its last match, so each thread gets its own copy
+    static thread_local wxRegEx m_regex_description;
+    static thread_local wxRegEx m_regex_search;
     static const std::map<wxString, double> m_units;
 };
 
@@ -40,6 +40,7 @@
 #include <font/font.h>
 #include <font/glyph.h>
 #include <font/outline_decomposer.h>
+#include <mutex>
 
 namespace KIFONT
 {
@@ -127,6 +128,10 @@ private:
     FT_Face           m_face;
     const int         m_faceSize;
 
+    // FreeType faces are not thread safe; serializes text shaping so several threads (for
+    // instance the 3D viewer layer builder) can use the same font
+    mutable std::recursive_mutex m_faceLock;
+
     // cache for glyphs converted to straight segments
     // key is glyph index (FT_GlyphSlot field glyph_index)
     std::map<unsigned int, GLYPH_POINTS_LIST> m_contourCache;
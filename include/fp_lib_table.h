@@ -192,6 +192,15 @@ public:
      */
     const FOOTPRINT* GetEnumeratedFootprint( const wxString& aNickname,
                                              const wxString& aFootprintName );
+
+    /**
+     * Fetch the description, keywords and pad counts of a footprint for use after
+     * #FootprintEnumerate(), without loading the footprint where the plugin allows it.
+     *
+     * @return false if the footprint could not be found.
+     */
+    bool GetFootprintSummary( const wxString& aNickname, const wxString& aFootprintName,
+                              FOOTPRINT_SUMMARY& aSummary );
     /**
      * The set of return values from FootprintSave() below.
      */
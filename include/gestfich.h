@@ -25,6 +25,10 @@
 #ifndef GESTFICH_H
 #define GESTFICH_H
 
+#include <functional>
+#include <future>
+#include <string>
+
 #include <wx/filename.h>
 #include <wx/process.h>
 
@@ -55,6 +59,28 @@ void OpenFile( const wxString& file );
  */
 void KiCopyFile( const wxString& aSrcPath, const wxString& aDestPath, wxString& aErrors );
 
+/**
+ * Replace the contents of \a aFileName with \a aContents so that the file is either completely
+ * rewritten or left untouched.
+ *
+ * The data is written to a temporary file in the same directory, flushed to disk and then
+ * renamed over the target file.  This does not touch any GUI objects so it can safely be called
+ * from a worker thread.
+ *
+ * @throw IO_ERROR if the file cannot be written.
+ */
+void KiWriteFileAtomically( const wxString& aFileName, const std::string& aContents );
+
+/**
+ * Run KiWriteFileAtomically() on the KiCad thread pool.
+ *
+ * @param aOnComplete is an optional function called from the worker thread once the file has
+ *                    been written (or failed to be written).
+ * @return a future holding an empty string on success or the error message on failure.
+ */
+std::future<wxString> KiWriteFileAtomicallyAsync( const wxString& aFileName, std::string aContents,
+                                                  std::function<void()> aOnComplete = nullptr );
+
 /**
  * Call the executable file \a aEditorName with the parameter \a aFileName.
  */
@@ -22,9 +22,12 @@
 #ifndef LIB_TREE_MODEL_H
 #define LIB_TREE_MODEL_H
 
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <wx/string.h>
 #include <lib_tree_item.h>
 
@@ -215,6 +218,12 @@ public:
      */
     virtual void UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxString& aLib ) override;
 
+    /**
+     * Convert the match name and search text to the form used by the search (lower case,
+     * unescaped).  Does nothing if they are already normalized.
+     */
+    void Normalize();
+
 protected:
     /**
      * Add a new unit to the component and return it.
@@ -255,6 +264,41 @@ public:
     LIB_TREE_NODE_LIB_ID& AddItem( LIB_TREE_ITEM* aItem );
 
     virtual void UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxString& aLib ) override;
+
+protected:
+    /**
+     * Build the search index of the children.  Children are normalized as a side effect.
+     */
+    void buildSearchIndex();
+
+    /**
+     * @return true if the search index matches the current children.  Children added or
+     * updated since the index was built are not normalized yet, which invalidates the index.
+     */
+    bool isSearchIndexValid() const;
+
+    /**
+     * Find the children which can match a search term, using the search index.
+     *
+     * @param aTerm         the (lower case) search term
+     * @param aCandidates   receives the children which can match \a aTerm
+     * @return false if the index cannot be used for this term, in which case every child
+     *         is a candidate
+     */
+    bool findSearchCandidates( const wxString& aTerm,
+                               std::unordered_set<LIB_TREE_NODE*>& aCandidates );
+
+    /*
+     * The search index is built from the whitespace separated tokens of the children's
+     * normalized match names and search texts.  A search term contains no whitespace, so a
+     * child can match a plain (not regex, wildcard or relational) term only if one of its
+     * tokens contains the term.  Tokens are found from the trigrams of the term.
+     */
+    bool                                           m_searchIndexBuilt = false;
+    size_t                                         m_searchIndexedCount = 0;
+    std::vector<wxString>                          m_searchTokens;
+    std::vector<std::vector<LIB_TREE_NODE*>>       m_searchTokenNodes;
+    std::unordered_map<uint64_t, std::vector<int>> m_searchTrigrams;
 };
 
 
@@ -281,6 +325,9 @@ public:
      */
     LIB_TREE_NODE_LIB& AddLib( wxString const& aName, wxString const& aDesc );
 
+    /**
+     * Score the libraries in parallel.  Each thread uses its own copy of \a aMatcher.
+     */
     virtual void UpdateScore( EDA_COMBINED_MATCHER& aMatcher, const wxString& aLib ) override;
 };
 
@@ -290,6 +290,7 @@ protected:
 
 
 #define OUTPUTFMTBUFZ    500        ///< default buffer size for any OUTPUT_FORMATTER
+#define FILE_OUTPUTFMTBUFZ ( 1024 * 1024 ) ///< stdio buffer size for FILE_OUTPUTFORMATTER
 
 /**
  * An interface used to output 8 bit text in a convenient way.
@@ -400,9 +401,13 @@ private:
     std::vector<char>   m_buffer;
     char                quoteChar[2];
 
-    int sprint( const char* fmt, ... );
     int vprint( const char* fmt, va_list ap );
 
+    /**
+     * Expand a format string using only %s, %d, %c and %% without calling vsnprintf().
+     */
+    int fastvprint( const char* fmt, va_list ap );
+
 };
 
 
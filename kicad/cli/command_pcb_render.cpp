@@ -0,0 +1,182 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_render.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_pcb_render.h"
+#include <kiface_base.h>
+#include <wx/crt.h>
+#include <wx/tokenzr.h>
+
+#include <macros.h>
+
+#define ARG_OUTPUT "--output"
+#define ARG_INPUT "input"
+#define ARG_WIDTH "--width"
+#define ARG_HEIGHT "--height"
+#define ARG_SIDE "--side"
+#define ARG_ZOOM "--zoom"
+#define ARG_ROTATE "--rotate"
+#define ARG_PERSPECTIVE "--perspective"
+#define ARG_QUALITY "--quality"
+#define ARG_FLOOR "--floor"
+
+
+CLI::PCB_RENDER_COMMAND::PCB_RENDER_COMMAND() : COMMAND( "render" )
+{
+    m_argParser.add_argument( "-o", ARG_OUTPUT )
+            .default_value( std::string() )
+            .help( "output PNG file name" );
+
+    m_argParser.add_argument( "-w", ARG_WIDTH )
+            .default_value( 1600 )
+            .scan<'i', int>()
+            .help( "image width in pixels" );
+
+    m_argParser.add_argument( ARG_HEIGHT )
+            .default_value( 900 )
+            .scan<'i', int>()
+            .help( "image height in pixels" );
+
+    m_argParser.add_argument( ARG_SIDE )
+            .default_value( std::string( "top" ) )
+            .help( "valid options: top,bottom,left,right,front,back" );
+
+    m_argParser.add_argument( ARG_ZOOM )
+            .default_value( 1.0 )
+            .scan<'g', double>()
+            .help( "camera zoom factor" );
+
+    m_argParser.add_argument( ARG_ROTATE )
+            .default_value( std::string() )
+            .help( "extra camera rotation in degrees around X, Y and Z, ex. -45,0,45" );
+
+    m_argParser.add_argument( ARG_PERSPECTIVE )
+            .help( "Use a perspective projection instead of an orthographic one" )
+            .implicit_value( true )
+            .default_value( false );
+
+    m_argParser.add_argument( ARG_QUALITY )
+            .default_value( std::string( "basic" ) )
+            .help( "valid options: basic,high" );
+
+    m_argParser.add_argument( ARG_FLOOR )
+            .help( "Render the floor under the board" )
+            .implicit_value( true )
+            .default_value( false );
+
+    m_argParser.add_argument( ARG_INPUT ).help( "input file" );
+}
+
+
+int CLI::PCB_RENDER_COMMAND::Perform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_RENDER> renderJob( new JOB_PCB_RENDER( true ) );
+
+    renderJob->m_filename = FROM_UTF8( m_argParser.get<std::string>( ARG_INPUT ).c_str() );
+    renderJob->m_outputFile = FROM_UTF8( m_argParser.get<std::string>( ARG_OUTPUT ).c_str() );
+    renderJob->m_width = m_argParser.get<int>( ARG_WIDTH );
+    renderJob->m_height = m_argParser.get<int>( ARG_HEIGHT );
+    renderJob->m_zoom = m_argParser.get<double>( ARG_ZOOM );
+    renderJob->m_perspective = m_argParser.get<bool>( ARG_PERSPECTIVE );
+    renderJob->m_floor = m_argParser.get<bool>( ARG_FLOOR );
+
+    if( !wxFile::Exists( renderJob->m_filename ) )
+    {
+        wxFprintf( stderr, _( "Board file does not exist or is not accessible\n" ) );
+        return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    if( renderJob->m_width <= 0 || renderJob->m_height <= 0 )
+    {
+        wxFprintf( stderr, _( "Invalid image size\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    if( renderJob->m_zoom <= 0.0 )
+    {
+        wxFprintf( stderr, _( "Invalid zoom\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString side = FROM_UTF8( m_argParser.get<std::string>( ARG_SIDE ).c_str() );
+
+    if( side == wxS( "top" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::TOP;
+    else if( side == wxS( "bottom" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::BOTTOM;
+    else if( side == wxS( "left" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::LEFT;
+    else if( side == wxS( "right" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::RIGHT;
+    else if( side == wxS( "front" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::FRONT;
+    else if( side == wxS( "back" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::BACK;
+    else
+    {
+        wxFprintf( stderr, _( "Invalid side\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString quality = FROM_UTF8( m_argParser.get<std::string>( ARG_QUALITY ).c_str() );
+
+    if( quality == wxS( "basic" ) )
+    {
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::BASIC;
+    }
+    else if( quality == wxS( "high" ) )
+    {
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::HIGH;
+    }
+    else
+    {
+        wxFprintf( stderr, _( "Invalid quality\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString rotate = FROM_UTF8( m_argParser.get<std::string>( ARG_ROTATE ).c_str() );
+
+    if( !rotate.IsEmpty() )
+    {
+        wxStringTokenizer tokens( rotate, wxS( "," ) );
+        double*           angles[] = { &renderJob->m_rotateX, &renderJob->m_rotateY,
+                                       &renderJob->m_rotateZ };
+
+        for( double* angle : angles )
+        {
+            if( !tokens.HasMoreTokens() || !tokens.GetNextToken().Trim( true ).Trim( false )
+                                                    .ToCDouble( angle ) )
+            {
+                wxFprintf( stderr, _( "Invalid rotation\n" ) );
+                return EXIT_CODES::ERR_ARGS;
+            }
+        }
+
+        if( tokens.HasMoreTokens() )
+        {
+            wxFprintf( stderr, _( "Invalid rotation\n" ) );
+            return EXIT_CODES::ERR_ARGS;
+        }
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, renderJob.get() );
+
+    return exitCode;
+}
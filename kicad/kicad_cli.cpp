@@ -48,6 +48,7 @@
 
 #include "cli/command_pcb.h"
 #include "cli/command_pcb_export.h"
+#include "cli/command_pcb_render.h"
 #include "cli/command_export_pcb_drill.h"
 #include "cli/command_export_pcb_dxf.h"
 #include "cli/command_export_pcb_gerber.h"
@@ -116,6 +117,7 @@ static CLI::EXPORT_PCB_PDF_COMMAND     exportPcbPdfCmd{};
 static CLI::EXPORT_PCB_POS_COMMAND     exportPcbPosCmd{};
 static CLI::EXPORT_PCB_GERBER_COMMAND  exportPcbGerberCmd{};
 static CLI::EXPORT_PCB_COMMAND         exportPcbCmd{};
+static CLI::PCB_RENDER_COMMAND         pcbRenderCmd{};
 static CLI::PCB_COMMAND                pcbCmd{};
 static CLI::EXPORT_SCH_COMMAND         exportSchCmd{};
 static CLI::SCH_COMMAND                schCmd{};
@@ -138,7 +140,8 @@ static std::vector<COMMAND_ENTRY> commandStack = {
                     &exportPcbStepCmd,
                     &exportPcbSvgCmd
                 }
-            }
+            },
+            { &pcbRenderCmd }
         }
     },
     {
@@ -879,6 +879,39 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
         wxFAIL_MSG( wxT( "BOARD::Remove() needs more ::Type() support" ) );
     }
 
+    detachRemovedItem( aBoardItem );
+
+    if( aRemoveMode != REMOVE_MODE::BULK )
+        InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, aBoardItem );
+}
+
+
+std::vector<BOARD_ITEM*> BOARD::RemoveTracks( const std::function<bool( PCB_TRACK* )>& aPredicate )
+{
+    std::vector<BOARD_ITEM*> removed;
+
+    alg::delete_if( m_tracks,
+                    [&]( PCB_TRACK* aTrack )
+                    {
+                        if( !aPredicate( aTrack ) )
+                            return false;
+
+                        removed.push_back( aTrack );
+                        return true;
+                    } );
+
+    for( BOARD_ITEM* item : removed )
+        detachRemovedItem( item );
+
+    if( !removed.empty() )
+        FinalizeBulkRemove( removed );
+
+    return removed;
+}
+
+
+void BOARD::detachRemovedItem( BOARD_ITEM* aBoardItem )
+{
     aBoardItem->SetFlags( STRUCT_DELETED );
 
     PCB_GROUP* parentGroup = aBoardItem->GetParentGroup();
@@ -887,9 +920,6 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
         parentGroup->RemoveItem( aBoardItem );
 
     m_connectivity->Remove( aBoardItem );
-
-    if( aRemoveMode != REMOVE_MODE::BULK )
-        InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, aBoardItem );
 }
 
 
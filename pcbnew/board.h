@@ -35,6 +35,7 @@
 #include <pcb_plot_params.h>
 #include <title_block.h>
 #include <tools/pcb_selection.h>
+#include <functional>
 #include <mutex>
 #include <list>
 
@@ -384,6 +385,16 @@ public:
      */
     void FinalizeBulkRemove( std::vector<BOARD_ITEM*>& aRemovedItems );
 
+    /**
+     * Remove all the tracks, arcs and vias matching \a aPredicate in a single pass.
+     *
+     * This is the same as a bulk Remove() of each of them followed by FinalizeBulkRemove(),
+     * without the cost of finding each item in the track list.
+     *
+     * @return the removed items, which are now owned by the caller.
+     */
+    std::vector<BOARD_ITEM*> RemoveTracks( const std::function<bool( PCB_TRACK* )>& aPredicate );
+
     void CacheTriangulation( PROGRESS_REPORTER* aReporter = nullptr,
                              const std::vector<ZONE*>& aZones = {} );
 
@@ -1165,6 +1176,12 @@ private:
             ( l->*aFunc )( std::forward<Args>( args )... );
     }
 
+    /**
+     * Detach \a aBoardItem, already taken out of its board container, from its group and from
+     * the connectivity.
+     */
+    void detachRemovedItem( BOARD_ITEM* aBoardItem );
+
     friend class PCB_EDIT_FRAME;
 
     /// What is this board being used for
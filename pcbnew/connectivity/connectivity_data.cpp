@@ -70,6 +70,7 @@ CONNECTIVITY_DATA::~CONNECTIVITY_DATA()
 bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 {
     m_connAlgo->Add( aItem );
+    m_fromToCache->Invalidate();
     return true;
 }
 
@@ -77,6 +78,7 @@ bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 bool CONNECTIVITY_DATA::Remove( BOARD_ITEM* aItem )
 {
     m_connAlgo->Remove( aItem );
+    m_fromToCache->Invalidate();
     return true;
 }
 
@@ -85,6 +87,7 @@ bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 {
     m_connAlgo->Remove( aItem );
     m_connAlgo->Add( aItem );
+    m_fromToCache->Invalidate();
     return true;
 }
 
@@ -108,6 +111,7 @@ void CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_connAlgo->Build( aBoard, aReporter );
+    m_fromToCache->Invalidate();
 
     m_netclassMap.clear();
 
@@ -145,6 +149,10 @@ void CONNECTIVITY_DATA::Build( const std::vector<BOARD_ITEM*>& aItems )
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_connAlgo->LocalBuild( aItems );
 
+    // Not created yet when called from the constructor
+    if( m_fromToCache )
+        m_fromToCache->Invalidate();
+
     RecalculateRatsnest();
 }
 
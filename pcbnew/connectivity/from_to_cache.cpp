@@ -17,6 +17,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <reporter.h>
@@ -33,11 +34,14 @@
 void FROM_TO_CACHE::buildEndpointList( )
 {
     m_ftEndpoints.clear();
+    m_padEndpoints.clear();
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
         for( PAD* pad : footprint->Pads() )
         {
+            m_padEndpoints[ pad ] = m_ftEndpoints.size();
+
             FT_ENDPOINT ent;
             ent.name = footprint->GetReference() + wxT( "-" ) + pad->GetNumber();
             ent.parent = pad;
@@ -50,73 +54,173 @@ void FROM_TO_CACHE::buildEndpointList( )
 }
 
 
-enum PATH_STATUS {
-    PS_OK = 0,
-    PS_MULTIPLE_PATHS = -1,
-    PS_NO_PATH = -2
-};
+uint64_t FROM_TO_CACHE::bridgeKey( int a, int b )
+{
+    if( a > b )
+        std::swap( a, b );
+
+    return ( static_cast<uint64_t>( a ) << 32 ) | static_cast<uint32_t>( b );
+}
 
 
-static bool isVertexVisited( CN_ITEM* v, const std::vector<CN_ITEM*>& path )
+void FROM_TO_CACHE::buildGraph( CN_CONNECTIVITY_ALGO* aAlgo )
 {
-    for( CN_ITEM* u : path )
+    m_graph = std::make_unique<CN_GRAPH>();
+
+    CN_GRAPH& g = *m_graph;
+
+    for( CN_ITEM* item : aAlgo->ItemList() )
     {
-        if ( u == v )
-            return true;
+        g.m_index[ item ] = static_cast<int>( g.m_nodes.size() );
+        g.m_nodes.push_back( item );
     }
 
-    return false;
-}
+    g.m_offsets.reserve( g.m_nodes.size() + 1 );
 
+    for( CN_ITEM* item : g.m_nodes )
+    {
+        g.m_offsets.push_back( static_cast<int>( g.m_adjacency.size() ) );
 
-static PATH_STATUS uniquePathBetweenNodes( CN_ITEM* u, CN_ITEM* v, std::vector<CN_ITEM*>& outPath )
-{
-    using Path = std::vector<CN_ITEM*>;
-    std::deque<Path> Q;
+        for( CN_ITEM* connected : item->ConnectedItems() )
+        {
+            auto it = g.m_index.find( connected );
 
-    Path pInit;
-    bool pathFound = false;
-    pInit.push_back( u );
-    Q.push_back( pInit );
+            if( it != g.m_index.end() )
+                g.m_adjacency.push_back( it->second );
+        }
+    }
+
+    g.m_offsets.push_back( static_cast<int>( g.m_adjacency.size() ) );
 
-    while( Q.size() )
+    // Find the bridges (edges whose removal disconnects the graph) with an iterative version of
+    // Tarjan's algorithm.  A path between two items is the only one iff all its edges are
+    // bridges.
+    struct FRAME
     {
-        Path path = Q.front();
-        Q.pop_front();
-        CN_ITEM* last = path.back();
+        int node;
+        int parent;
+        int edge;
+    };
 
-        if( last == v )
-        {
-            outPath = path;
+    const int        count = static_cast<int>( g.m_nodes.size() );
+    std::vector<int> discovery( count, -1 );
+    std::vector<int> low( count, 0 );
+    int              time = 0;
+
+    for( int root = 0; root < count; ++root )
+    {
+        if( discovery[root] >= 0 )
+            continue;
 
-            if( pathFound )
-                return PS_MULTIPLE_PATHS;
+        std::vector<FRAME> stack;
 
-            pathFound = true;
-        }
+        discovery[root] = low[root] = time++;
+        stack.push_back( { root, -1, g.m_offsets[root] } );
 
-        for( CN_ITEM* ci : last->ConnectedItems() )
+        while( !stack.empty() )
         {
-            bool vertexVisited = isVertexVisited( ci, path );
+            FRAME& frame = stack.back();
+            int    node = frame.node;
+
+            if( frame.edge < g.m_offsets[node + 1] )
+            {
+                int next = g.m_adjacency[ frame.edge++ ];
+
+                if( next == frame.parent || next == node )
+                    continue;
 
-            for( std::vector<CN_ITEM*>& p : Q )
-                if( isVertexVisited( ci, p ) )
+                if( discovery[next] < 0 )
                 {
-                    vertexVisited = true;
-                    break;
+                    discovery[next] = low[next] = time++;
+                    stack.push_back( { next, node, g.m_offsets[next] } );
                 }
+                else
+                {
+                    low[node] = std::min( low[node], discovery[next] );
+                }
+            }
+            else
+            {
+                int parent = frame.parent;
+
+                stack.pop_back();
+
+                if( parent >= 0 )
+                {
+                    low[parent] = std::min( low[parent], low[node] );
+
+                    if( low[node] > discovery[parent] )
+                        g.m_bridges.insert( bridgeKey( parent, node ) );
+                }
+            }
+        }
+    }
+
+    g.m_stamp.assign( count, 0 );
+    g.m_parent.assign( count, -1 );
+}
+
+
+FROM_TO_CACHE::PATH_STATUS FROM_TO_CACHE::uniquePathBetweenNodes( CN_ITEM* u, CN_ITEM* v,
+                                                                  std::vector<CN_ITEM*>& outPath )
+{
+    CN_GRAPH& g = *m_graph;
+    auto      uIt = g.m_index.find( u );
+    auto      vIt = g.m_index.find( v );
+
+    if( uIt == g.m_index.end() || vIt == g.m_index.end() )
+        return PS_NO_PATH;
+
+    int      source = uIt->second;
+    int      target = vIt->second;
+    unsigned stamp = ++g.m_searchStamp;
+
+    std::vector<int> queue;
+    size_t           head = 0;
 
-            if( !vertexVisited )
+    g.m_stamp[source] = stamp;
+    g.m_parent[source] = -1;
+    queue.push_back( source );
+
+    while( head < queue.size() )
+    {
+        int node = queue[head++];
+
+        if( node == target )
+            break;
+
+        for( int ii = g.m_offsets[node]; ii < g.m_offsets[node + 1]; ++ii )
+        {
+            int next = g.m_adjacency[ii];
+
+            if( g.m_stamp[next] != stamp )
             {
-                Path newpath( path );
-                newpath.push_back( ci );
-                Q.push_back( newpath );
+                g.m_stamp[next] = stamp;
+                g.m_parent[next] = node;
+                queue.push_back( next );
             }
         }
     }
 
-    return pathFound ? PS_OK : PS_NO_PATH;
-};
+    if( g.m_stamp[target] != stamp )
+        return PS_NO_PATH;
+
+    bool unique = true;
+
+    outPath.clear();
+
+    for( int node = target; node >= 0; node = g.m_parent[node] )
+    {
+        outPath.push_back( g.m_nodes[node] );
+
+        if( g.m_parent[node] >= 0 && !g.m_bridges.count( bridgeKey( g.m_parent[node], node ) ) )
+            unique = false;
+    }
+
+    std::reverse( outPath.begin(), outPath.end() );
+
+    return unique ? PS_OK : PS_MULTIPLE_PATHS;
+}
 
 
 int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo )
@@ -161,27 +265,32 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
             wxString toName = pad->GetParent()->GetReference() + wxT( "-" ) + pad->GetNumber();
 
 
-            for( const FT_ENDPOINT& endpoint : m_ftEndpoints )
+            auto padEndpoints = m_padEndpoints.find( pad );
+
+            if( padEndpoints == m_padEndpoints.end() )
+                continue;
+
+            // Each pad has two consecutive endpoints: "REF-NUM" and "REF"
+            for( size_t ii = padEndpoints->second; ii < padEndpoints->second + 2; ++ii )
             {
-                if( pad == endpoint.parent )
+                const FT_ENDPOINT& endpoint = m_ftEndpoints[ii];
+
+                if( WildCompareString( aTo, endpoint.name, false ) )
                 {
-                    if( WildCompareString( aTo, endpoint.name, false ) )
+                    count++;
+                    toPad = endpoint.parent;
+
+                    path.to = toPad;
+                    path.fromName = fromName;
+                    path.toName = toName;
+                    path.fromWildcard = aFrom;
+                    path.toWildcard = aTo;
+
+                    if( count >= 2 )
                     {
-                        count++;
-                        toPad = endpoint.parent;
-
-                        path.to = toPad;
-                        path.fromName = fromName;
-                        path.toName = toName;
-                        path.fromWildcard = aFrom;
-                        path.toWildcard = aTo;
-
-                        if( count >= 2 )
-                        {
-                            // fixme: report this somewhere?
-                            //printf("Multiple targets found, aborting...\n");
-                            path.to = nullptr;
-                        }
+                        // fixme: report this somewhere?
+                        //printf("Multiple targets found, aborting...\n");
+                        path.to = nullptr;
                     }
                 }
             }
@@ -190,6 +299,11 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
 
     int newPaths = 0;
 
+    if( !m_graph )
+        buildGraph( cnAlgo.get() );
+
+    std::unordered_set<BOARD_CONNECTED_ITEM*>& fromToItems = m_fromToItems[ { aFrom, aTo } ];
+
     for( FT_PATH& path : paths )
     {
         if( !path.from || !path.to )
@@ -215,6 +329,7 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
         for( const auto item : upath )
         {
             path.pathItems.insert( item->Parent() );
+            fromToItems.insert( item->Parent() );
         }
 
         m_ftPaths.push_back(path);
@@ -228,49 +343,50 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
 
 bool  FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo )
 {
-    int nFromTosFound = 0;
-
     if( !m_board )
         return false;
 
-    //printf("Check %d cached paths [%p]\n", m_ftPaths.size(), aItem );
-    for( int attempt = 0; attempt < 2; attempt++ )
-    {
-        // item already belongs to path
-        for( FT_PATH& ftPath : m_ftPaths )
-        {
-            if( aFrom == ftPath.fromWildcard && aTo == ftPath.toWildcard )
-            {
-                nFromTosFound++;
+    // Rule expressions may be evaluated from several DRC threads at once
+    std::lock_guard<std::mutex> lock( m_lock );
 
-                if( ftPath.pathItems.count( aItem ) )
-                {
-        //            printf("Found cached path for %p [%s->%s]\n", aItem, (const char *)ftPath.fromName, (const char *) ftPath.toName );
-                    return true;
-                }
-            }
-        }
+    auto it = m_fromToItems.find( { aFrom, aTo } );
 
-        if( !nFromTosFound )
-            cacheFromToPaths( aFrom, aTo );
-        else
-            return false;
+    if( it == m_fromToItems.end() )
+    {
+        cacheFromToPaths( aFrom, aTo );
+        it = m_fromToItems.find( { aFrom, aTo } );
     }
 
-    return false;
+    return it->second.count( aItem ) > 0;
 }
 
 
 void FROM_TO_CACHE::Rebuild( BOARD* aBoard )
 {
+    std::lock_guard<std::mutex> lock( m_lock );
+
     m_board = aBoard;
     buildEndpointList();
     m_ftPaths.clear();
+    m_fromToItems.clear();
+    m_graph.reset();
+}
+
+
+void FROM_TO_CACHE::Invalidate()
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    m_ftPaths.clear();
+    m_fromToItems.clear();
+    m_graph.reset();
 }
 
 
 FROM_TO_CACHE::FT_PATH* FROM_TO_CACHE::QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems )
 {
+    std::lock_guard<std::mutex> lock( m_lock );
+
     for( FT_PATH& ftPath : m_ftPaths )
     {
         if ( ftPath.pathItems == aItems )
@@ -20,10 +20,20 @@
 #ifndef FROM_TO_CACHE_H
 #define FROM_TO_CACHE_H
 
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 class PAD;
 class BOARD_CONNECTED_ITEM;
+class CN_ITEM;
+class CN_CONNECTIVITY_ALGO;
 
 class FROM_TO_CACHE
 {
@@ -56,17 +66,68 @@ public:
     }
 
     void Rebuild( BOARD* aBoard );
+
+    /**
+     * Forget the paths found so far, they hold connectivity items which are freed when the
+     * connectivity changes.
+     */
+    void Invalidate();
     bool IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo );
 
     FT_PATH* QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems );
 
 private:
+    enum PATH_STATUS
+    {
+        PS_OK = 0,
+        PS_MULTIPLE_PATHS = -1,
+        PS_NO_PATH = -2
+    };
+
+    /**
+     * The connectivity graph in compressed sparse row form, plus its bridges.  Built on the
+     * first path search after #Rebuild() or #Invalidate() and shared by the following ones.
+     */
+    struct CN_GRAPH
+    {
+        std::unordered_map<const CN_ITEM*, int> m_index;
+        std::vector<CN_ITEM*>                   m_nodes;
+        std::vector<int>                        m_offsets;    ///< Start of each node's edges.
+        std::vector<int>                        m_adjacency;
+        std::unordered_set<uint64_t>            m_bridges;    ///< Keyed by bridgeKey().
+
+        // Search scratch space, valid for nodes whose stamp matches m_searchStamp.
+        std::vector<unsigned>                   m_stamp;
+        std::vector<int>                        m_parent;
+        unsigned                                m_searchStamp = 0;
+    };
+
     int cacheFromToPaths( const wxString& aFrom, const wxString& aTo );
     void buildEndpointList();
 
+    void buildGraph( CN_CONNECTIVITY_ALGO* aAlgo );
+
+    /**
+     * Find the path between two items with a breadth-first search.  The path is unique if
+     * every edge on it is a bridge of the connectivity graph.
+     */
+    PATH_STATUS uniquePathBetweenNodes( CN_ITEM* u, CN_ITEM* v, std::vector<CN_ITEM*>& outPath );
+
+    static uint64_t bridgeKey( int a, int b );
+
 private:
     std::vector<FT_ENDPOINT> m_ftEndpoints;
-    std::vector<FT_PATH>     m_ftPaths;
+    std::deque<FT_PATH>      m_ftPaths;     ///< deque: QueryFromToPath() returns pointers
+
+    /// Index of the first of the (consecutive) m_ftEndpoints entries for each pad.
+    std::unordered_map<const PAD*, size_t> m_padEndpoints;
+
+    /// For each (from, to) wildcard pair searched so far, the items on its paths.
+    std::map<std::pair<wxString, wxString>,
+             std::unordered_set<BOARD_CONNECTED_ITEM*>> m_fromToItems;
+
+    std::unique_ptr<CN_GRAPH> m_graph;
+    std::mutex                m_lock;
 
     BOARD*                   m_board;
 };
@@ -0,0 +1,130 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+
+#include <drc/drc_courtyard_index.h>
+#include <footprint.h>
+
+
+static void insertBox( RTree<size_t, int, 2, double>& aTree, const BOX2I& aBox, size_t aIndex )
+{
+    const int min[2] = { aBox.GetX(), aBox.GetY() };
+    const int max[2] = { aBox.GetRight(), aBox.GetBottom() };
+
+    aTree.Insert( min, max, aIndex );
+}
+
+
+void DRC_COURTYARD_INDEX::Clear()
+{
+    m_footprints.clear();
+    m_frontCourtyards.RemoveAll();
+    m_backCourtyards.RemoveAll();
+    m_boundingBoxes.RemoveAll();
+}
+
+
+void DRC_COURTYARD_INDEX::Build( const std::vector<FOOTPRINT*>& aFootprints )
+{
+    Clear();
+
+    m_footprints = aFootprints;
+
+    for( size_t ii = 0; ii < m_footprints.size(); ++ii )
+    {
+        FOOTPRINT*            footprint = m_footprints[ii];
+        const SHAPE_POLY_SET& front = footprint->GetCourtyard( F_CrtYd );
+        const SHAPE_POLY_SET& back = footprint->GetCourtyard( B_CrtYd );
+
+        if( front.OutlineCount() > 0 )
+            insertBox( m_frontCourtyards, front.BBoxFromCaches(), ii );
+
+        if( back.OutlineCount() > 0 )
+            insertBox( m_backCourtyards, back.BBoxFromCaches(), ii );
+
+        insertBox( m_boundingBoxes, footprint->GetBoundingBox(), ii );
+    }
+}
+
+
+void DRC_COURTYARD_INDEX::search( const INDEX_RTREE& aTree, const BOX2I& aBox,
+                                  std::vector<size_t>& aResults ) const
+{
+    const int min[2] = { aBox.GetX(), aBox.GetY() };
+    const int max[2] = { aBox.GetRight(), aBox.GetBottom() };
+
+    auto visitor =
+            [&]( const size_t& aIndex ) -> bool
+            {
+                aResults.push_back( aIndex );
+                return true;
+            };
+
+    aTree.Search( min, max, visitor );
+}
+
+
+std::vector<size_t> DRC_COURTYARD_INDEX::QueryCandidates( const FOOTPRINT* aFootprint,
+                                                         int aClearance ) const
+{
+    const SHAPE_POLY_SET& front = aFootprint->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& back = aFootprint->GetCourtyard( B_CrtYd );
+    BOX2I                 bbox = aFootprint->GetBoundingBox();
+    std::vector<size_t>   results;
+
+    // Courtyard-to-courtyard, and other pads against our courtyards
+    if( front.OutlineCount() > 0 )
+    {
+        BOX2I worstCaseBBox = front.BBoxFromCaches();
+        worstCaseBBox.Inflate( aClearance );
+
+        search( m_frontCourtyards, worstCaseBBox, results );
+        search( m_boundingBoxes, worstCaseBBox, results );
+    }
+
+    if( back.OutlineCount() > 0 )
+    {
+        BOX2I worstCaseBBox = back.BBoxFromCaches();
+        worstCaseBBox.Inflate( aClearance );
+
+        search( m_backCourtyards, worstCaseBBox, results );
+        search( m_boundingBoxes, worstCaseBBox, results );
+    }
+
+    // Our pads against other courtyards
+    search( m_frontCourtyards, bbox, results );
+    search( m_backCourtyards, bbox, results );
+
+    std::sort( results.begin(), results.end() );
+    results.erase( std::unique( results.begin(), results.end() ), results.end() );
+
+    results.erase( std::remove_if( results.begin(), results.end(),
+                                   [&]( size_t aIndex )
+                                   {
+                                       return m_footprints[ aIndex ] == aFootprint;
+                                   } ),
+                   results.end() );
+
+    return results;
+}
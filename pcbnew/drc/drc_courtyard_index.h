@@ -0,0 +1,81 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef DRC_COURTYARD_INDEX_H
+#define DRC_COURTYARD_INDEX_H
+
+#include <vector>
+
+#include <geometry/rtree.h>
+#include <math/box2.h>
+
+class FOOTPRINT;
+
+
+/**
+ * Spatial index of footprint courtyards and bounding boxes, used to find the footprint pairs
+ * worth testing for courtyard overlaps and for pad holes inside courtyards.
+ *
+ * Each side's courtyards get their own R-tree; a third one holds the footprint bounding boxes.
+ * The footprints' courtyard caches must be built before they are indexed.  Queries are const
+ * and may be run from several threads at once.
+ */
+class DRC_COURTYARD_INDEX
+{
+public:
+    DRC_COURTYARD_INDEX() {}
+
+    void Clear();
+
+    /**
+     * Index \a aFootprints, replacing any previous content.  Indices returned by
+     * #QueryCandidates() refer to positions in this list.
+     */
+    void Build( const std::vector<FOOTPRINT*>& aFootprints );
+
+    size_t Size() const { return m_footprints.size(); }
+
+    FOOTPRINT* GetFootprint( size_t aIndex ) const { return m_footprints[ aIndex ]; }
+
+    /**
+     * Find the indexed footprints which might have a courtyard within \a aClearance of the
+     * courtyards of \a aFootprint, a courtyard touching its bounding box, or a bounding box
+     * touching one of its courtyards.
+     *
+     * @return the candidates' indices in ascending order.  \a aFootprint itself is excluded.
+     */
+    std::vector<size_t> QueryCandidates( const FOOTPRINT* aFootprint, int aClearance ) const;
+
+private:
+    typedef RTree<size_t, int, 2, double> INDEX_RTREE;
+
+    void search( const INDEX_RTREE& aTree, const BOX2I& aBox,
+                 std::vector<size_t>& aResults ) const;
+
+    std::vector<FOOTPRINT*> m_footprints;
+    INDEX_RTREE             m_frontCourtyards;
+    INDEX_RTREE             m_backCourtyards;
+    INDEX_RTREE             m_boundingBoxes;
+};
+
+#endif // DRC_COURTYARD_INDEX_H
@@ -30,124 +30,141 @@
 #include <geometry/shape_segment.h>
 #include <footprint.h>
 
-void DRC_INTERACTIVE_COURTYARD_CLEARANCE::testCourtyardClearances()
+void DRC_INTERACTIVE_COURTYARD_CLEARANCE::testFootprintPair( FOOTPRINT* fpA, FOOTPRINT* fpB )
 {
-    for( FOOTPRINT* fpA: m_board->Footprints() )
+    const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
+
+    if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0 )
+         // No courtyards defined and no hole testing against other footprint's courtyards
+        return;
+
+    BOX2I frontBBox = frontA.BBoxFromCaches();
+    BOX2I backBBox = backA.BBoxFromCaches();
+
+    frontBBox.Inflate( m_largestCourtyardClearance );
+    backBBox.Inflate( m_largestCourtyardClearance );
+
+    BOX2I                 fpABBox = fpA->GetBoundingBox();
+    BOX2I                 fpBBBox = fpB->GetBoundingBox();
+    const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
+    DRC_CONSTRAINT        constraint;
+    int                   clearance;
+    int                   actual;
+    VECTOR2I              pos;
+
+    if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
+            && frontBBox.Intersects( frontB.BBoxFromCaches() ) )
     {
-        if( fpA->IsSelected() )
-            continue;
+        // Currently, do not use DRC engine for calculation time reasons
+        // constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
+        // constraint.GetValue().Min();
+        clearance = 0;
 
-        const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
-        const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
-
-        if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0 )
-             // No courtyards defined and no hole testing against other footprint's courtyards
-            continue;
-
-        BOX2I frontBBox = frontA.BBoxFromCaches();
-        BOX2I backBBox = backA.BBoxFromCaches();
-
-        frontBBox.Inflate( m_largestCourtyardClearance );
-        backBBox.Inflate( m_largestCourtyardClearance );
+        if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
+        {
+            m_itemsInConflict.insert( fpA );
+            m_itemsInConflict.insert( fpB );
+         }
+    }
 
-        BOX2I fpABBox = fpA->GetBoundingBox();
+    if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
+            && backBBox.Intersects( backB.BBoxFromCaches() ) )
+    {
+        // Currently, do not use DRC engine for calculation time reasons
+        // constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
+        // constraint.GetValue().Min();
+        clearance = 0;
 
-        for( FOOTPRINT* fpB : m_FpInMove )
+        if( backA.Collide( &backB, clearance, &actual, &pos ) )
         {
-            fpB->BuildCourtyardCaches();
-            BOX2I                 fpBBBox = fpB->GetBoundingBox();
-            const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
-            const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
-            DRC_CONSTRAINT        constraint;
-            int                   clearance;
-            int                   actual;
-            VECTOR2I              pos;
-
-            if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
-                    && frontBBox.Intersects( frontB.BBoxFromCaches() ) )
-            {
-                // Currently, do not use DRC engine for calculation time reasons
-                // constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
-                // constraint.GetValue().Min();
-                clearance = 0;
-
-                if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
-                {
-                    m_itemsInConflict.insert( fpA );
-                    m_itemsInConflict.insert( fpB );
-                 }
-            }
+            m_itemsInConflict.insert( fpA );
+            m_itemsInConflict.insert( fpB );
+        }
+    }
 
-            if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
-                    && backBBox.Intersects( backB.BBoxFromCaches() ) )
+    // Now test if a pad hole of some other footprint is inside the courtyard area
+    // of the moved footprint
+    auto testPadAgainstCourtyards =
+            [&]( const PAD* pad, FOOTPRINT* footprint ) -> bool
             {
-                // Currently, do not use DRC engine for calculation time reasons
-                // constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
-                // constraint.GetValue().Min();
-                clearance = 0;
-
-                if( backA.Collide( &backB, clearance, &actual, &pos ) )
+                if( pad->HasHole() )
                 {
-                    m_itemsInConflict.insert( fpA );
-                    m_itemsInConflict.insert( fpB );
+                    std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
+                    const SHAPE_POLY_SET& front = footprint->GetCourtyard( F_CrtYd );
+                    const SHAPE_POLY_SET& back = footprint->GetCourtyard( B_CrtYd );
+
+                    if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
+                        return true;
+                    else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
+                        return true;
                 }
-            }
-
-            // Now test if a pad hole of some other footprint is inside the courtyard area
-            // of the moved footprint
-            auto testPadAgainstCourtyards =
-                    [&]( const PAD* pad, FOOTPRINT* footprint ) -> bool
-                    {
-                        if( pad->HasHole() )
-                        {
-                            std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
-                            const SHAPE_POLY_SET& front = footprint->GetCourtyard( F_CrtYd );
-                            const SHAPE_POLY_SET& back = footprint->GetCourtyard( B_CrtYd );
-
-                            if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
-                                return true;
-                            else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
-                                return true;
-                        }
 
-                        return false;
-                    };
+                return false;
+            };
 
-            bool skipNextCmp = false;
+    bool skipNextCmp = false;
 
-            if( ( frontA.OutlineCount() > 0 && frontA.BBoxFromCaches().Intersects( fpBBBox ) )
-                || ( backA.OutlineCount() > 0 && backA.BBoxFromCaches().Intersects( fpBBBox ) ) )
+    if( ( frontA.OutlineCount() > 0 && frontA.BBoxFromCaches().Intersects( fpBBBox ) )
+        || ( backA.OutlineCount() > 0 && backA.BBoxFromCaches().Intersects( fpBBBox ) ) )
+    {
+        for( const PAD* padB : fpB->Pads() )
+        {
+            if( testPadAgainstCourtyards( padB, fpA ) )
             {
-                for( const PAD* padB : fpB->Pads() )
-                {
-                    if( testPadAgainstCourtyards( padB, fpA ) )
-                    {
-                        m_itemsInConflict.insert( fpA );
-                        m_itemsInConflict.insert( fpB );
-                        skipNextCmp = true;
-                        break;
-                    }
-                }
+                m_itemsInConflict.insert( fpA );
+                m_itemsInConflict.insert( fpB );
+                skipNextCmp = true;
+                break;
             }
+        }
+    }
 
-            if( skipNextCmp )
-                continue;       // fpA and fpB are already in list
+    if( skipNextCmp )
+        return;         // fpA and fpB are already in list
 
-            if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpABBox ) )
-                || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpABBox ) ) )
+    if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpABBox ) )
+        || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpABBox ) ) )
+    {
+        for( const PAD* padA : fpA->Pads() )
+        {
+            if( testPadAgainstCourtyards( padA, fpB ) )
             {
-                for( const PAD* padA : fpA->Pads() )
-                {
-                    if( testPadAgainstCourtyards( padA, fpB ) )
-                    {
-                        m_itemsInConflict.insert( fpA );
-                        m_itemsInConflict.insert( fpB );
-                        break;
-                    }
-                }
+                m_itemsInConflict.insert( fpA );
+                m_itemsInConflict.insert( fpB );
+                break;
             }
         }
     }
+}
+
+
+void DRC_INTERACTIVE_COURTYARD_CLEARANCE::testCourtyardClearances()
+{
+    // Footprints which aren't being moved don't change during the move, so they are only
+    // indexed once (or again if the list of moved footprints changes).
+    if( m_indexedMoveCount != m_FpInMove.size() )
+    {
+        std::vector<FOOTPRINT*> staticFootprints;
+
+        for( FOOTPRINT* fp : m_board->Footprints() )
+        {
+            if( !fp->IsSelected() && !alg::contains( m_FpInMove, fp ) )
+                staticFootprints.push_back( fp );
+        }
+
+        m_index.Build( staticFootprints );
+        m_indexedMoveCount = m_FpInMove.size();
+    }
+
+    for( FOOTPRINT* fpB : m_FpInMove )
+    {
+        fpB->BuildCourtyardCaches();
+
+        for( size_t ii : m_index.QueryCandidates( fpB, m_largestCourtyardClearance ) )
+            testFootprintPair( m_index.GetFootprint( ii ), fpB );
+    }
 
     for( ZONE* zone : m_board->Zones() )
     {
@@ -196,6 +213,8 @@ void DRC_INTERACTIVE_COURTYARD_CLEARANCE::testCourtyardClearances()
 void DRC_INTERACTIVE_COURTYARD_CLEARANCE::Init( BOARD* aBoard )
 {
     m_board = aBoard;
+    m_index.Clear();
+    m_indexedMoveCount = std::numeric_limits<size_t>::max();
 
     // Update courtyard data and clear the COURTYARD_CONFLICT flag
     for( FOOTPRINT* fp: m_board->Footprints() )
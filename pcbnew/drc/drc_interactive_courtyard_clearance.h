@@ -26,6 +26,8 @@
 #ifndef DRC_INTERACTIVE_COURTYARD_CLEARANCE_H
 #define DRC_INTERACTIVE_COURTYARD_CLEARANCE_H
 
+#include <limits>
+#include <drc/drc_courtyard_index.h>
 #include <drc/drc_test_provider_clearance_base.h>
 
 
@@ -34,7 +36,8 @@ class DRC_INTERACTIVE_COURTYARD_CLEARANCE : public DRC_TEST_PROVIDER_CLEARANCE_B
 public:
     DRC_INTERACTIVE_COURTYARD_CLEARANCE( const std::shared_ptr<DRC_ENGINE>& aDRCEngine ) :
             DRC_TEST_PROVIDER_CLEARANCE_BASE(),
-            m_largestCourtyardClearance( 0 )
+            m_largestCourtyardClearance( 0 ),
+            m_indexedMoveCount( std::numeric_limits<size_t>::max() )
     {
         m_isRuleDriven = false;
         SetDRCEngine( aDRCEngine.get() );
@@ -65,6 +68,8 @@ public:
     std::vector<FOOTPRINT*>   m_FpInMove;             // The list of moved footprints
 
 private:
+    void testFootprintPair( FOOTPRINT* fpA, FOOTPRINT* fpB );
+
     void testCourtyardClearances();
 
 private:
@@ -72,6 +77,9 @@ private:
 
     std::set<BOARD_ITEM*>     m_itemsInConflict;      // The list of items in conflict
     std::vector<BOARD_ITEM*>  m_lastItemsInConflict;  // The list of items last highlighted
+
+    DRC_COURTYARD_INDEX       m_index;                // The footprints which are not moving
+    size_t                    m_indexedMoveCount;     // m_FpInMove size when m_index was built
 };
 
 #endif // DRC_INTERACTIVE_COURTYARD_CLEARANCE_H
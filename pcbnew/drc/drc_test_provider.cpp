@@ -83,6 +83,13 @@ void DRC_TEST_PROVIDER::reportViolation( std::shared_ptr<DRC_ITEM>& item,
 }
 
 
+void DRC_TEST_PROVIDER::reportViolations( VIOLATIONS& aViolations )
+{
+    for( PENDING_VIOLATION& violation : aViolations )
+        reportViolation( violation.m_item, violation.m_pos, violation.m_layer );
+}
+
+
 bool DRC_TEST_PROVIDER::reportProgress( int aCount, int aSize, int aDelta )
 {
     if( ( aCount % aDelta ) == 0 || aCount == aSize -  1 )
@@ -100,12 +100,23 @@ public:
     virtual const wxString GetDescription() const;
 
 protected:
+    /// A violation found on a worker thread, to be reported later in a deterministic order.
+    struct PENDING_VIOLATION
+    {
+        std::shared_ptr<DRC_ITEM> m_item;
+        VECTOR2I                  m_pos;
+        int                       m_layer;
+    };
+
+    typedef std::vector<PENDING_VIOLATION> VIOLATIONS;
+
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, LSET aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
 
     virtual void reportAux( wxString fmt, ... );
     virtual void reportViolation( std::shared_ptr<DRC_ITEM>& item, const VECTOR2I& aMarkerPos,
                                   int aMarkerLayer );
+    void reportViolations( VIOLATIONS& aViolations );
     virtual bool reportProgress( int aCount, int aSize, int aDelta );
     virtual bool reportPhase( const wxString& aStageName );
 
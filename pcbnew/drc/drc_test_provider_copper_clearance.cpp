@@ -21,6 +21,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <common.h>
 #include <math_for_graphics.h>
 #include <board_design_settings.h>
@@ -28,6 +29,7 @@
 #include <pcb_shape.h>
 #include <pad.h>
 #include <pcb_track.h>
+#include <thread_pool.h>
 #include <zone.h>
 
 #include <geometry/seg.h>
@@ -79,18 +81,69 @@ public:
     }
 
 private:
+    /**
+     * A filter or visitor call made by DRC_RTREE::QueryColliding() on a worker thread.  The
+     * serial pass replays these to apply the order-dependent pair bookkeeping.
+     */
+    struct QUERY_STEP
+    {
+        QUERY_STEP( BOARD_ITEM* aOther, bool aIsVisit ) :
+                m_other( aOther ),
+                m_isVisit( aIsVisit )
+        {}
+
+        BOARD_ITEM* m_other;
+        bool        m_isVisit;              ///< Visitor call, otherwise a filter call.
+        bool        m_tested = false;       ///< m_result and m_violations are valid.
+        bool        m_result = true;        ///< Visitor result (false ends the query).
+        bool        m_freePadHit = false;   ///< Other item is a free pad colliding with us.
+        VIOLATIONS  m_violations;
+    };
+
+    /// Everything gathered for one item on one layer.
+    struct LAYER_RESULT
+    {
+        LAYER_RESULT( PCB_LAYER_ID aLayer ) :
+                m_layer( aLayer )
+        {}
+
+        PCB_LAYER_ID                                      m_layer;
+        std::vector<QUERY_STEP>                           m_steps;
+        std::vector<std::pair<size_t, PENDING_VIOLATION>> m_zoneViolations;  ///< By zone index.
+    };
+
     bool testTrackAgainstItem( PCB_TRACK* track, SHAPE* trackShape, PCB_LAYER_ID layer,
-                               BOARD_ITEM* other );
+                               BOARD_ITEM* other, VIOLATIONS& aViolations );
 
     void testTrackClearances();
 
-    bool testPadAgainstItem( PAD* pad, SHAPE* padShape, PCB_LAYER_ID layer, BOARD_ITEM* other );
+    bool testPadAgainstItem( PAD* pad, SHAPE* padShape, PCB_LAYER_ID layer, BOARD_ITEM* other,
+                             VIOLATIONS& aViolations );
 
     void testPadClearances();
 
     void testZonesToZones();
 
-    void testItemAgainstZone( BOARD_ITEM* aItem, ZONE* aZone, PCB_LAYER_ID aLayer );
+    void testItemAgainstZone( BOARD_ITEM* aItem, ZONE* aZone, PCB_LAYER_ID aLayer,
+                              VIOLATIONS& aViolations );
+
+    /**
+     * Report the zone violations gathered for \a aItem on \a aLayer, re-testing any zones
+     * reached after the error limits changed from \a aLimitState.
+     */
+    void replayZoneResults( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, LAYER_RESULT& aResult,
+                            int aLimitState );
+
+    /// @return a bitmask of the error limits which affect the outcome of the tests.
+    int errorLimitState() const;
+
+    /**
+     * Call \a aFunc for each index in [0, aCount) on the thread pool, reporting progress while
+     * waiting.
+     *
+     * @return false if DRC was cancelled.
+     */
+    bool forEachParallel( size_t aCount, const std::function<void( size_t )>& aFunc );
 
 private:
     int m_drcEpsilon;
@@ -163,7 +216,8 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
 
 bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackAgainstItem( PCB_TRACK* track, SHAPE* trackShape,
                                                                PCB_LAYER_ID layer,
-                                                               BOARD_ITEM* other )
+                                                               BOARD_ITEM* other,
+                                                               VIOLATIONS& aViolations )
 {
     bool           testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
     bool           testHoles = !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
@@ -202,7 +256,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackAgainstItem( PCB_TRACK* track,
                 drcItem->SetItems( track, other );
                 drcItem->SetViolatingRule( constraint.GetParentRule() );
 
-                reportViolation( drcItem, *intersection, layer );
+                aViolations.push_back( { drcItem, *intersection, layer } );
 
                 return m_drcEngine->GetReportAllTrackErrors();
             }
@@ -227,7 +281,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackAgainstItem( PCB_TRACK* track,
                 drce->SetItems( track, other );
                 drce->SetViolatingRule( constraint.GetParentRule() );
 
-                reportViolation( drce, pos, layer );
+                aViolations.push_back( { drce, pos, layer } );
 
                 if( !m_drcEngine->GetReportAllTrackErrors() )
                     return false;
@@ -281,7 +335,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackAgainstItem( PCB_TRACK* track,
                     drce->SetItems( a[ii], b[ii] );
                     drce->SetViolatingRule( constraint.GetParentRule() );
 
-                    reportViolation( drce, pos, layer );
+                    aViolations.push_back( { drce, pos, layer } );
                     has_error = true;
 
                     if( !m_drcEngine->GetReportAllTrackErrors() )
@@ -296,7 +350,8 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackAgainstItem( PCB_TRACK* track,
 
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem, ZONE* aZone,
-                                                              PCB_LAYER_ID aLayer )
+                                                              PCB_LAYER_ID aLayer,
+                                                              VIOLATIONS& aViolations )
 {
     if( !aZone->GetLayerSet().test( aLayer ) )
         return;
@@ -321,11 +376,14 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
     if( !testClearance && !testHoles )
         return;
 
-    DRC_RTREE*  zoneTree = m_board->m_CopperZoneRTreeCache[ aZone ].get();
+    // Called from worker threads, so look the tree up without inserting into the cache.
+    auto zoneTreeIt = m_board->m_CopperZoneRTreeCache.find( aZone );
 
-    if( !zoneTree )
+    if( zoneTreeIt == m_board->m_CopperZoneRTreeCache.end() || !zoneTreeIt->second )
         return;
 
+    DRC_RTREE* zoneTree = zoneTreeIt->second.get();
+
     DRC_CONSTRAINT constraint;
     int            clearance = -1;
     int            actual;
@@ -364,7 +422,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
             drce->SetItems( aItem, aZone );
             drce->SetViolatingRule( constraint.GetParentRule() );
 
-            reportViolation( drce, pos, aLayer );
+            aViolations.push_back( { drce, pos, aLayer } );
         }
     }
 
@@ -403,7 +461,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
                     drce->SetItems( aItem, aZone );
                     drce->SetViolatingRule( constraint.GetParentRule() );
 
-                    reportViolation( drce, pos, aLayer );
+                    aViolations.push_back( { drce, pos, aLayer } );
                 }
             }
         }
@@ -413,85 +471,175 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 {
-    // This is the number of tests between 2 calls to the progress bar
-    const int progressDelta = 100;
-    int       ii = 0;
-
     reportAux( wxT( "Testing %d tracks & vias..." ), m_board->Tracks().size() );
 
+    std::vector<PCB_TRACK*>                 tracks( m_board->Tracks().begin(),
+                                                    m_board->Tracks().end() );
+    std::unordered_map<BOARD_ITEM*, size_t> trackIndex;
+    std::vector<std::vector<LAYER_RESULT>>  results( tracks.size() );
+    const std::vector<ZONE*>&               zones = m_board->m_DRCCopperZones;
+    int                                     limitState = errorLimitState();
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+        trackIndex[ tracks[ii] ] = ii;
+
+    auto gatherTrack =
+            [&]( size_t ii )
+            {
+                PCB_TRACK* track = tracks[ii];
+
+                for( PCB_LAYER_ID layer : LSET( track->GetLayerSet() & LSET::AllCuMask() ).Seq() )
+                {
+                    LAYER_RESULT&          result = results[ii].emplace_back( layer );
+                    std::shared_ptr<SHAPE> trackShape = track->GetEffectiveShape( layer );
+
+                    m_board->m_CopperItemRTreeCache->QueryColliding( track, layer, layer,
+                            // Filter:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                auto otherCItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( other );
+
+                                if( otherCItem && otherCItem->GetNetCode() == track->GetNetCode() )
+                                    return false;
+
+                                result.m_steps.emplace_back( other, false );
+                                return true;
+                            },
+                            // Visitor:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                QUERY_STEP& step = result.m_steps.emplace_back( other, true );
+
+                                if( other->Type() == PCB_PAD_T
+                                        && static_cast<PAD*>( other )->IsFreePad() )
+                                {
+                                    step.m_freePadHit =
+                                            other->GetEffectiveShape( layer )->Collide( trackShape.get() );
+                                }
+
+                                // A pair with an earlier track is normally tested from that
+                                // track's side; the serial pass handles the odd one that isn't.
+                                auto it = trackIndex.find( other );
+
+                                if( it == trackIndex.end() || it->second > ii )
+                                {
+                                    step.m_tested = true;
+                                    step.m_result = testTrackAgainstItem( track, trackShape.get(),
+                                                                          layer, other,
+                                                                          step.m_violations );
+                                }
+
+                                return true;
+                            },
+                            m_board->m_DRCMaxClearance );
+
+                    for( size_t jj = 0; jj < zones.size(); ++jj )
+                    {
+                        VIOLATIONS violations;
+                        testItemAgainstZone( track, zones[jj], layer, violations );
+
+                        for( PENDING_VIOLATION& violation : violations )
+                            result.m_zoneViolations.emplace_back( jj, std::move( violation ) );
+
+                        if( m_drcEngine->IsCancelled() )
+                            break;
+                    }
+                }
+            };
+
+    if( !forEachParallel( tracks.size(), gatherTrack ) )
+        return;
+
+    // Now replay the results in board order.  Pair de-duplication and free pad net assignment
+    // depend on that order, as do the error limits, so anything gathered under a different
+    // error limit state is re-tested here.
     std::map<BOARD_ITEM*, int>                  freePadsUsageMap;
     std::unordered_map<PTR_PTR_CACHE_KEY, LSET> checkedPairs;
 
-    for( PCB_TRACK* track : m_board->Tracks() )
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
     {
-        if( !reportProgress( ii++, m_board->Tracks().size(), progressDelta ) )
-            break;
+        PCB_TRACK* track = tracks[ii];
 
-        for( PCB_LAYER_ID layer : LSET( track->GetLayerSet() & LSET::AllCuMask() ).Seq() )
+        for( LAYER_RESULT& result : results[ii] )
         {
-            std::shared_ptr<SHAPE> trackShape = track->GetEffectiveShape( layer );
+            PCB_LAYER_ID                          layer = result.m_layer;
+            std::shared_ptr<SHAPE>                trackShape;
+            std::unordered_map<BOARD_ITEM*, bool> filterResults;
 
-            m_board->m_CopperItemRTreeCache->QueryColliding( track, layer, layer,
-                    // Filter:
-                    [&]( BOARD_ITEM* other ) -> bool
-                    {
-                        auto otherCItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( other );
+            for( QUERY_STEP& step : result.m_steps )
+            {
+                BOARD_ITEM* other = step.m_other;
 
-                        if( otherCItem && otherCItem->GetNetCode() == track->GetNetCode() )
-                            return false;
+                if( !step.m_isVisit )
+                {
+                    BOARD_ITEM* a = track;
+                    BOARD_ITEM* b = other;
 
-                        BOARD_ITEM* a = track;
-                        BOARD_ITEM* b = other;
+                    // store canonical order so we don't collide in both directions
+                    // (a:b and b:a)
+                    if( static_cast<void*>( a ) > static_cast<void*>( b ) )
+                        std::swap( a, b );
 
-                        // store canonical order so we don't collide in both directions
-                        // (a:b and b:a)
-                        if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                            std::swap( a, b );
+                    auto it = checkedPairs.find( { a, b } );
 
-                        auto it = checkedPairs.find( { a, b } );
+                    if( it != checkedPairs.end() && it->second.test( layer ) )
+                    {
+                        filterResults[ other ] = false;
+                    }
+                    else
+                    {
+                        checkedPairs[ { a, b } ].set( layer );
+                        filterResults[ other ] = true;
+                    }
 
-                        if( it != checkedPairs.end() && it->second.test( layer ) )
-                        {
-                            return false;
-                        }
-                        else
-                        {
-                            checkedPairs[ { a, b } ].set( layer );
-                            return true;
-                        }
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* other ) -> bool
+                    continue;
+                }
+
+                if( !filterResults[ other ] )
+                    continue;
+
+                if( step.m_freePadHit )
+                {
+                    auto it = freePadsUsageMap.find( other );
+
+                    if( it == freePadsUsageMap.end() )
                     {
-                        if( other->Type() == PCB_PAD_T && static_cast<PAD*>( other )->IsFreePad() )
-                        {
-                            if( other->GetEffectiveShape( layer )->Collide( trackShape.get() ) )
-                            {
-                                auto it = freePadsUsageMap.find( other );
+                        freePadsUsageMap[ other ] = track->GetNetCode();
+                        break;
+                    }
+                    else if( it->second == track->GetNetCode() )
+                    {
+                        break;
+                    }
+                }
 
-                                if( it == freePadsUsageMap.end() )
-                                {
-                                    freePadsUsageMap[ other ] = track->GetNetCode();
-                                    return false;
-                                }
-                                else if( it->second == track->GetNetCode() )
-                                {
-                                    return false;
-                                }
-                            }
-                        }
+                bool keepGoing;
 
-                        return testTrackAgainstItem( track, trackShape.get(), layer, other );
-                    },
-                    m_board->m_DRCMaxClearance );
+                if( step.m_tested && errorLimitState() == limitState )
+                {
+                    reportViolations( step.m_violations );
+                    keepGoing = step.m_result;
+                }
+                else
+                {
+                    VIOLATIONS violations;
 
-            for( ZONE* zone : m_board->m_DRCCopperZones )
-            {
-                testItemAgainstZone( track, zone, layer );
+                    if( !trackShape )
+                        trackShape = track->GetEffectiveShape( layer );
 
-                if( m_drcEngine->IsCancelled() )
+                    keepGoing = testTrackAgainstItem( track, trackShape.get(), layer, other,
+                                                      violations );
+                    reportViolations( violations );
+                }
+
+                if( !keepGoing )
                     break;
             }
+
+            replayZoneResults( track, layer, result, limitState );
+
+            if( m_drcEngine->IsCancelled() )
+                return;
         }
     }
 }
@@ -499,7 +647,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 
 bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* padShape,
                                                              PCB_LAYER_ID aLayer,
-                                                             BOARD_ITEM* other )
+                                                             BOARD_ITEM* other,
+                                                             VIOLATIONS& aViolations )
 {
     bool testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
     bool testShorting = !m_drcEngine->IsErrorLimitExceeded( DRCE_SHORTING_ITEMS );
@@ -596,7 +745,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
             drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
             drce->SetItems( pad, otherPad );
 
-            reportViolation( drce, otherPad->GetPosition(), aLayer );
+            aViolations.push_back( { drce, otherPad->GetPosition(), aLayer } );
         }
 
         return !m_drcEngine->IsCancelled();
@@ -622,7 +771,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
                 drce->SetItems( pad, other );
                 drce->SetViolatingRule( constraint.GetParentRule() );
 
-                reportViolation( drce, pos, aLayer );
+                aViolations.push_back( { drce, pos, aLayer } );
                 testHoles = false;  // No need for multiple violations
             }
         }
@@ -653,7 +802,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
             drce->SetItems( pad, other );
             drce->SetViolatingRule( constraint.GetParentRule() );
 
-            reportViolation( drce, pos, aLayer );
+            aViolations.push_back( { drce, pos, aLayer } );
             testHoles = false;  // No need for multiple violations
         }
     }
@@ -674,7 +823,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
             drce->SetItems( pad, other );
             drce->SetViolatingRule( constraint.GetParentRule() );
 
-            reportViolation( drce, pos, aLayer );
+            aViolations.push_back( { drce, pos, aLayer } );
             testHoles = false;  // No need for multiple violations
         }
     }
@@ -695,7 +844,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
             drce->SetItems( pad, otherVia );
             drce->SetViolatingRule( constraint.GetParentRule() );
 
-            reportViolation( drce, pos, aLayer );
+            aViolations.push_back( { drce, pos, aLayer } );
         }
     }
 
@@ -705,260 +854,420 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 {
-    const int progressDelta = 100;
-    size_t    count = 0;
-    int       ii = 0;
+    std::vector<PAD*> pads;
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
-        count += footprint->Pads().size();
+        pads.insert( pads.end(), footprint->Pads().begin(), footprint->Pads().end() );
+
+    reportAux( wxT( "Testing %d pads..." ), pads.size() );
+
+    std::vector<std::vector<LAYER_RESULT>> results( pads.size() );
+    const std::vector<ZONE*>&              zones = m_board->m_DRCCopperZones;
+    int                                    limitState = errorLimitState();
+
+    auto gatherPad =
+            [&]( size_t ii )
+            {
+                PAD* pad = pads[ii];
+
+                for( PCB_LAYER_ID layer : pad->GetLayerSet().Seq() )
+                {
+                    LAYER_RESULT&          result = results[ii].emplace_back( layer );
+                    std::shared_ptr<SHAPE> padShape = pad->GetEffectiveShape( layer );
+
+                    m_board->m_CopperItemRTreeCache->QueryColliding( pad, layer, layer,
+                            // Filter:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                result.m_steps.emplace_back( other, false );
+                                return true;
+                            },
+                            // Visitor
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                QUERY_STEP& step = result.m_steps.emplace_back( other, true );
+
+                                step.m_tested = true;
+                                step.m_result = testPadAgainstItem( pad, padShape.get(), layer,
+                                                                    other, step.m_violations );
+                                return true;
+                            },
+                            m_board->m_DRCMaxClearance );
 
-    reportAux( wxT( "Testing %d pads..." ), count );
+                    for( size_t jj = 0; jj < zones.size(); ++jj )
+                    {
+                        VIOLATIONS violations;
+                        testItemAgainstZone( pad, zones[jj], layer, violations );
 
+                        for( PENDING_VIOLATION& violation : violations )
+                            result.m_zoneViolations.emplace_back( jj, std::move( violation ) );
+
+                        if( m_drcEngine->IsCancelled() )
+                            return;
+                    }
+                }
+            };
+
+    if( !forEachParallel( pads.size(), gatherPad ) )
+        return;
+
+    // Replay in board order; see testTrackClearances().
     std::unordered_map<PTR_PTR_CACHE_KEY, int> checkedPairs;
 
-    for( FOOTPRINT* footprint : m_board->Footprints() )
+    for( size_t ii = 0; ii < pads.size(); ++ii )
     {
-        for( PAD* pad : footprint->Pads() )
+        PAD* pad = pads[ii];
+
+        for( LAYER_RESULT& result : results[ii] )
         {
-            for( PCB_LAYER_ID layer : pad->GetLayerSet().Seq() )
+            PCB_LAYER_ID                          layer = result.m_layer;
+            std::unordered_map<BOARD_ITEM*, bool> filterResults;
+
+            for( QUERY_STEP& step : result.m_steps )
             {
-                std::shared_ptr<SHAPE> padShape = pad->GetEffectiveShape( layer );
+                BOARD_ITEM* other = step.m_other;
 
-                m_board->m_CopperItemRTreeCache->QueryColliding( pad, layer, layer,
-                        // Filter:
-                        [&]( BOARD_ITEM* other ) -> bool
-                        {
-                            BOARD_ITEM* a = pad;
-                            BOARD_ITEM* b = other;
+                if( !step.m_isVisit )
+                {
+                    BOARD_ITEM* a = pad;
+                    BOARD_ITEM* b = other;
 
-                            // store canonical order so we don't collide in both directions
-                            // (a:b and b:a)
-                            if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                                std::swap( a, b );
+                    // store canonical order so we don't collide in both directions
+                    // (a:b and b:a)
+                    if( static_cast<void*>( a ) > static_cast<void*>( b ) )
+                        std::swap( a, b );
 
-                            if( checkedPairs.find( { a, b } ) != checkedPairs.end() )
-                            {
-                                return false;
-                            }
-                            else
-                            {
-                                checkedPairs[ { a, b } ] = 1;
-                                return true;
-                            }
-                        },
-                        // Visitor
-                        [&]( BOARD_ITEM* other ) -> bool
-                        {
-                            return testPadAgainstItem( pad, padShape.get(), layer, other );
-                        },
-                        m_board->m_DRCMaxClearance );
+                    if( checkedPairs.find( { a, b } ) != checkedPairs.end() )
+                    {
+                        filterResults[ other ] = false;
+                    }
+                    else
+                    {
+                        checkedPairs[ { a, b } ] = 1;
+                        filterResults[ other ] = true;
+                    }
 
-                for( ZONE* zone : m_board->m_DRCCopperZones )
+                    continue;
+                }
+
+                if( !filterResults[ other ] )
+                    continue;
+
+                bool keepGoing;
+
+                if( errorLimitState() == limitState )
+                {
+                    reportViolations( step.m_violations );
+                    keepGoing = step.m_result;
+                }
+                else
                 {
-                    testItemAgainstZone( pad, zone, layer );
+                    VIOLATIONS             violations;
+                    std::shared_ptr<SHAPE> padShape = pad->GetEffectiveShape( layer );
 
-                    if( m_drcEngine->IsCancelled() )
-                        return;
+                    keepGoing = testPadAgainstItem( pad, padShape.get(), layer, other, violations );
+                    reportViolations( violations );
                 }
+
+                if( !keepGoing )
+                    break;
             }
 
-            if( !reportProgress( ii++, count, progressDelta ) )
+            replayZoneResults( pad, layer, result, limitState );
+
+            if( m_drcEngine->IsCancelled() )
                 return;
         }
-
-        if( m_drcEngine->IsCancelled() )
-            return;
     }
 }
 
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
 {
-    const int progressDelta = 50;
-
     bool      testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
     bool      testIntersects = !m_drcEngine->IsErrorLimitExceeded( DRCE_ZONES_INTERSECT );
 
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
-    DRC_CONSTRAINT  constraint;
-    int             zone2zoneClearance;
 
     if( m_board->GetBoardPolygonOutlines( buffer ) )
         boardOutline = &buffer;
 
+    const std::vector<ZONE*>& zones = m_board->m_DRCCopperZones;
+    std::vector<PCB_LAYER_ID> layers;
+
     for( int layer_id = F_Cu; layer_id <= B_Cu; ++layer_id )
     {
-        PCB_LAYER_ID layer = static_cast<PCB_LAYER_ID>( layer_id );
-        std::vector<SHAPE_POLY_SET> smoothed_polys;
-        smoothed_polys.resize( m_board->m_DRCCopperZones.size() );
-
         // Skip over layers not used on the current board
-        if( !m_board->IsLayerEnabled( layer ) )
-            continue;
+        if( m_board->IsLayerEnabled( static_cast<PCB_LAYER_ID>( layer_id ) ) )
+            layers.push_back( static_cast<PCB_LAYER_ID>( layer_id ) );
+    }
 
-        for( size_t ii = 0; ii < m_board->m_DRCCopperZones.size(); ii++ )
-        {
-            if( m_board->m_DRCCopperZones[ii]->IsOnLayer( layer ) )
-            {
-                m_board->m_DRCCopperZones[ii]->BuildSmoothedPoly( smoothed_polys[ii], layer,
-                                                                  boardOutline );
-            }
-        }
+    // smoothed_polys[layer index * zone count + zone index]
+    std::vector<SHAPE_POLY_SET> smoothed_polys( layers.size() * zones.size() );
 
-        // iterate through all areas
-        for( size_t ia = 0; ia < m_board->m_DRCCopperZones.size(); ia++ )
-        {
-            if( !reportProgress( layer_id * m_board->m_DRCCopperZones.size() + ia,
-                                 B_Cu * m_board->m_DRCCopperZones.size(), progressDelta ) )
+    auto buildSmoothedPoly =
+            [&]( size_t ii )
             {
-                return;     // DRC cancelled
-            }
+                PCB_LAYER_ID layer = layers[ ii / zones.size() ];
+                ZONE*        zone = zones[ ii % zones.size() ];
 
-            ZONE* zoneA = m_board->m_DRCCopperZones[ia];
+                if( zone->IsOnLayer( layer ) )
+                    zone->BuildSmoothedPoly( smoothed_polys[ii], layer, boardOutline );
+            };
 
-            if( !zoneA->IsOnLayer( layer ) )
-                continue;
+    if( !forEachParallel( smoothed_polys.size(), buildSmoothedPoly ) )
+        return;
+
+    // One task per layer and zoneA, each testing zoneA against all later zones.
+    std::vector<VIOLATIONS> results( layers.size() * zones.size() );
 
-            for( size_t ia2 = ia + 1; ia2 < m_board->m_DRCCopperZones.size(); ia2++ )
+    auto testZone =
+            [&]( size_t task )
             {
-                ZONE* zoneB = m_board->m_DRCCopperZones[ia2];
+                PCB_LAYER_ID    layer = layers[ task / zones.size() ];
+                size_t          ia = task % zones.size();
+                SHAPE_POLY_SET* layerPolys = &smoothed_polys[ task - ia ];
+                VIOLATIONS&     violations = results[task];
+                ZONE*           zoneA = zones[ia];
 
-                // test for same layer
-                if( !zoneB->IsOnLayer( layer ) )
-                    continue;
+                if( !zoneA->IsOnLayer( layer ) )
+                    return;
 
-                // Test for same net
-                if( zoneA->GetNetCode() == zoneB->GetNetCode() && zoneA->GetNetCode() >= 0 )
-                    continue;
+                for( size_t ia2 = ia + 1; ia2 < zones.size(); ia2++ )
+                {
+                    ZONE* zoneB = zones[ia2];
 
-                // test for different priorities
-                if( zoneA->GetAssignedPriority() != zoneB->GetAssignedPriority() )
-                    continue;
+                    // test for same layer
+                    if( !zoneB->IsOnLayer( layer ) )
+                        continue;
 
-                // rule areas may overlap at will
-                if( zoneA->GetIsRuleArea() || zoneB->GetIsRuleArea() )
-                    continue;
+                    // Test for same net
+                    if( zoneA->GetNetCode() == zoneB->GetNetCode() && zoneA->GetNetCode() >= 0 )
+                        continue;
 
-                // Examine a candidate zone: compare zoneB to zoneA
+                    // test for different priorities
+                    if( zoneA->GetAssignedPriority() != zoneB->GetAssignedPriority() )
+                        continue;
 
-                // Get clearance used in zone to zone test.
-                constraint = m_drcEngine->EvalRules( CLEARANCE_CONSTRAINT, zoneA, zoneB, layer );
-                zone2zoneClearance = constraint.GetValue().Min();
+                    // rule areas may overlap at will
+                    if( zoneA->GetIsRuleArea() || zoneB->GetIsRuleArea() )
+                        continue;
 
-                if( constraint.GetSeverity() == RPT_SEVERITY_IGNORE )
-                    continue;
+                    // Examine a candidate zone: compare zoneB to zoneA
 
-                if( testIntersects )
-                {
-                    // test for some corners of zoneA inside zoneB
-                    for( auto it = smoothed_polys[ia].IterateWithHoles(); it; it++ )
+                    // Get clearance used in zone to zone test.
+                    DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( CLEARANCE_CONSTRAINT,
+                                                                        zoneA, zoneB, layer );
+                    int            zone2zoneClearance = constraint.GetValue().Min();
+
+                    if( constraint.GetSeverity() == RPT_SEVERITY_IGNORE )
+                        continue;
+
+                    if( testIntersects )
                     {
-                        VECTOR2I currentVertex = *it;
-                        wxPoint pt( currentVertex.x, currentVertex.y );
+                        // test for some corners of zoneA inside zoneB
+                        for( auto it = layerPolys[ia].IterateWithHoles(); it; it++ )
+                        {
+                            VECTOR2I currentVertex = *it;
+
+                            if( layerPolys[ia2].Contains( currentVertex ) )
+                            {
+                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
+                                drce->SetItems( zoneA, zoneB );
+                                drce->SetViolatingRule( constraint.GetParentRule() );
+
+                                violations.push_back( { drce, currentVertex, layer } );
+                            }
+                        }
 
-                        if( smoothed_polys[ia2].Contains( currentVertex ) )
+                        // test for some corners of zoneB inside zoneA
+                        for( auto it = layerPolys[ia2].IterateWithHoles(); it; it++ )
                         {
-                            std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
-                            drce->SetItems( zoneA, zoneB );
-                            drce->SetViolatingRule( constraint.GetParentRule() );
+                            VECTOR2I currentVertex = *it;
+
+                            if( layerPolys[ia].Contains( currentVertex ) )
+                            {
+                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
+                                drce->SetItems( zoneB, zoneA );
+                                drce->SetViolatingRule( constraint.GetParentRule() );
 
-                            reportViolation( drce, pt, layer );
+                                violations.push_back( { drce, currentVertex, layer } );
+                            }
                         }
                     }
 
-                    // test for some corners of zoneB inside zoneA
-                    for( auto it = smoothed_polys[ia2].IterateWithHoles(); it; it++ )
+                    // Iterate through all the segments of refSmoothedPoly
+                    std::map<VECTOR2I, int> conflictPoints;
+
+                    for( auto refIt = layerPolys[ia].IterateSegmentsWithHoles(); refIt; refIt++ )
                     {
-                        VECTOR2I currentVertex = *it;
-                        wxPoint pt( currentVertex.x, currentVertex.y );
+                        // Build ref segment
+                        SEG refSegment = *refIt;
 
-                        if( smoothed_polys[ia].Contains( currentVertex ) )
+                        // Iterate through all the segments in layerPolys[ia2]
+                        for( auto it = layerPolys[ia2].IterateSegmentsWithHoles(); it; it++ )
                         {
-                            std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
-                            drce->SetItems( zoneB, zoneA );
-                            drce->SetViolatingRule( constraint.GetParentRule() );
-
-                            reportViolation( drce, pt, layer );
+                            // Build test segment
+                            SEG testSegment = *it;
+                            VECTOR2I pt;
+
+                            int ax1, ay1, ax2, ay2;
+                            ax1 = refSegment.A.x;
+                            ay1 = refSegment.A.y;
+                            ax2 = refSegment.B.x;
+                            ay2 = refSegment.B.y;
+
+                            int bx1, by1, bx2, by2;
+                            bx1 = testSegment.A.x;
+                            by1 = testSegment.A.y;
+                            bx2 = testSegment.B.x;
+                            by2 = testSegment.B.y;
+
+                            int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2, 0,
+                                                                 ax1, ay1, ax2, ay2, 0,
+                                                                 zone2zoneClearance, &pt.x, &pt.y );
+
+                            if( d < zone2zoneClearance )
+                            {
+                                if( conflictPoints.count( pt ) )
+                                    conflictPoints[ pt ] = std::min( conflictPoints[ pt ], d );
+                                else
+                                    conflictPoints[ pt ] = d;
+                            }
                         }
                     }
-                }
 
-                // Iterate through all the segments of refSmoothedPoly
-                std::map<VECTOR2I, int> conflictPoints;
+                    for( const std::pair<const VECTOR2I, int>& conflict : conflictPoints )
+                    {
+                        int actual = conflict.second;
+                        std::shared_ptr<DRC_ITEM> drce;
 
-                for( auto refIt = smoothed_polys[ia].IterateSegmentsWithHoles(); refIt; refIt++ )
-                {
-                    // Build ref segment
-                    SEG refSegment = *refIt;
+                        if( actual <= 0 && testIntersects )
+                        {
+                            drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
+                        }
+                        else if( testClearance )
+                        {
+                            drce = DRC_ITEM::Create( DRCE_CLEARANCE );
+                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                                      constraint.GetName(),
+                                                      zone2zoneClearance,
+                                                      std::max( actual, 0 ) );
 
-                    // Iterate through all the segments in smoothed_polys[ia2]
-                    for( auto it = smoothed_polys[ia2].IterateSegmentsWithHoles(); it; it++ )
-                    {
-                        // Build test segment
-                        SEG testSegment = *it;
-                        VECTOR2I pt;
-
-                        int ax1, ay1, ax2, ay2;
-                        ax1 = refSegment.A.x;
-                        ay1 = refSegment.A.y;
-                        ax2 = refSegment.B.x;
-                        ay2 = refSegment.B.y;
-
-                        int bx1, by1, bx2, by2;
-                        bx1 = testSegment.A.x;
-                        by1 = testSegment.A.y;
-                        bx2 = testSegment.B.x;
-                        by2 = testSegment.B.y;
-
-                        int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2, 0,
-                                                             ax1, ay1, ax2, ay2, 0,
-                                                             zone2zoneClearance, &pt.x, &pt.y );
-
-                        if( d < zone2zoneClearance )
+                            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
+                        }
+
+                        if( drce )
                         {
-                            if( conflictPoints.count( pt ) )
-                                conflictPoints[ pt ] = std::min( conflictPoints[ pt ], d );
-                            else
-                                conflictPoints[ pt ] = d;
+                            drce->SetItems( zoneA, zoneB );
+                            drce->SetViolatingRule( constraint.GetParentRule() );
+
+                            violations.push_back( { drce, conflict.first, layer } );
                         }
                     }
+
+                    if( m_drcEngine->IsCancelled() )
+                        return;
                 }
+            };
 
-                for( const std::pair<const VECTOR2I, int>& conflict : conflictPoints )
-                {
-                    int actual = conflict.second;
-                    std::shared_ptr<DRC_ITEM> drce;
+    if( !forEachParallel( results.size(), testZone ) )
+        return;
 
-                    if( actual <= 0 && testIntersects )
-                    {
-                        drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
-                    }
-                    else if( testClearance )
-                    {
-                        drce = DRC_ITEM::Create( DRCE_CLEARANCE );
-                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                  constraint.GetName(),
-                                                  zone2zoneClearance,
-                                                  std::max( actual, 0 ) );
+    for( VIOLATIONS& violations : results )
+        reportViolations( violations );
+}
+
+
+void DRC_TEST_PROVIDER_COPPER_CLEARANCE::replayZoneResults( BOARD_ITEM* aItem,
+                                                            PCB_LAYER_ID aLayer,
+                                                            LAYER_RESULT& aResult,
+                                                            int aLimitState )
+{
+    const std::vector<ZONE*>& zones = m_board->m_DRCCopperZones;
+    size_t                    kk = 0;
+
+    for( size_t jj = 0; jj < zones.size(); ++jj )
+    {
+        bool gathered = errorLimitState() == aLimitState;
+
+        for( ; kk < aResult.m_zoneViolations.size() && aResult.m_zoneViolations[kk].first == jj;
+               ++kk )
+        {
+            if( gathered )
+            {
+                PENDING_VIOLATION& violation = aResult.m_zoneViolations[kk].second;
+                reportViolation( violation.m_item, violation.m_pos, violation.m_layer );
+            }
+        }
+
+        if( !gathered )
+        {
+            VIOLATIONS violations;
+            testItemAgainstZone( aItem, zones[jj], aLayer, violations );
+            reportViolations( violations );
+        }
+
+        if( m_drcEngine->IsCancelled() )
+            return;
+    }
+}
+
+
+int DRC_TEST_PROVIDER_COPPER_CLEARANCE::errorLimitState() const
+{
+    int state = 0;
+
+    for( int code : { DRCE_CLEARANCE, DRCE_HOLE_CLEARANCE, DRCE_SHORTING_ITEMS,
+                      DRCE_ZONES_INTERSECT } )
+    {
+        state = ( state << 1 ) | ( m_drcEngine->IsErrorLimitExceeded( code ) ? 1 : 0 );
+    }
+
+    return state;
+}
 
-                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                    }
 
-                    if( drce )
+bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::forEachParallel( size_t aCount,
+                                                          const std::function<void( size_t )>& aFunc )
+{
+    thread_pool&        tp = GetKiCadThreadPool();
+    size_t              workers = std::min<size_t>( tp.get_thread_count(), aCount );
+    std::atomic<size_t> next( 0 );
+    std::atomic<size_t> done( 0 );
+
+    std::vector<std::future<void>> returns;
+    returns.reserve( workers );
+
+    for( size_t ii = 0; ii < workers; ++ii )
+    {
+        returns.emplace_back( tp.submit(
+                [&]()
+                {
+                    for( size_t jj = next.fetch_add( 1 ); jj < aCount; jj = next.fetch_add( 1 ) )
                     {
-                        drce->SetItems( zoneA, zoneB );
-                        drce->SetViolatingRule( constraint.GetParentRule() );
+                        if( m_drcEngine->IsCancelled() )
+                            break;
 
-                        reportViolation( drce, conflict.first, layer );
+                        aFunc( jj );
+                        done.fetch_add( 1 );
                     }
-                }
+                } ) );
+    }
 
-                if( m_drcEngine->IsCancelled() )
-                    return;
-            }
+    for( const std::future<void>& ret : returns )
+    {
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+        while( status != std::future_status::ready )
+        {
+            m_drcEngine->ReportProgress( static_cast<double>( done ) / aCount );
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
         }
     }
+
+    return !m_drcEngine->IsCancelled();
 }
 
 
@@ -21,7 +21,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <geometry/shape_poly_set.h>
+#include <drc/drc_courtyard_index.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <drc/drc_rule.h>
@@ -29,6 +31,7 @@
 #include <geometry/shape_segment.h>
 #include <drc/drc_test_provider_clearance_base.h>
 #include <footprint.h>
+#include <thread_pool.h>
 
 /*
     Couartyard clearance. Tests for malformed component courtyards and overlapping footprints.
@@ -69,6 +72,8 @@ public:
 private:
     bool testFootprintCourtyardDefinitions();
 
+    void testFootprintPair( FOOTPRINT* fpA, FOOTPRINT* fpB, VIOLATIONS& aViolations );
+
     bool testCourtyardClearances();
 
 private:
@@ -145,197 +150,262 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
 }
 
 
-bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
+void DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintPair( FOOTPRINT* fpA, FOOTPRINT* fpB,
+                                                               VIOLATIONS& aViolations )
 {
-    if( !reportPhase( _( "Checking footprints for overlapping courtyards..." ) ) )
-        return false;   // DRC cancelled
+    const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
 
-    const int progressDelta = 100;
-    int       ii = 0;
+    if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0
+         && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+         && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+    {
+        // No courtyards defined and no hole testing against other footprint's courtyards
+        return;
+    }
+
+    BOX2I frontA_worstCaseBBox = frontA.BBoxFromCaches();
+    BOX2I backA_worstCaseBBox = backA.BBoxFromCaches();
+
+    frontA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+    backA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+
+    BOX2I fpA_bbox = fpA->GetBoundingBox();
+
+    const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
 
-    for( auto itA = m_board->Footprints().begin(); itA != m_board->Footprints().end(); itA++ )
+    if( frontB.OutlineCount() == 0 && backB.OutlineCount() == 0
+         && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+         && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
     {
-        if( !reportProgress( ii++, m_board->Footprints().size(), progressDelta ) )
-            return false;   // DRC cancelled
+        // No courtyards defined and no hole testing against other footprint's courtyards
+        return;
+    }
 
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS)
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
-        {
-            return true;   // continue with other tests
-        }
+    BOX2I frontB_worstCaseBBox = frontB.BBoxFromCaches();
+    BOX2I backB_worstCaseBBox = backB.BBoxFromCaches();
 
-        FOOTPRINT*            fpA = *itA;
-        const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
-        const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
+    frontB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+    backB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+
+    BOX2I          fpB_bbox = fpB->GetBoundingBox();
+    DRC_CONSTRAINT constraint;
+    int            clearance;
+    int            actual;
+    VECTOR2I       pos;
+
+    //
+    // Check courtyard-to-courtyard collisions on front of board.
+    //
+
+    if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
+            && frontA_worstCaseBBox.Intersects( frontB.BBoxFromCaches() ) )
+    {
+        constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, F_Cu );
+        clearance = constraint.GetValue().Min();
 
-        if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0
-             && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-             && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+        if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
         {
-            // No courtyards defined and no hole testing against other footprint's courtyards
-            continue;
-        }
+            if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
+            {
+                auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
 
-        BOX2I frontA_worstCaseBBox = frontA.BBoxFromCaches();
-        BOX2I backA_worstCaseBBox = backA.BBoxFromCaches();
+                if( clearance > 0 )
+                {
+                    wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                              constraint.GetName(),
+                                              clearance,
+                                              actual );
 
-        frontA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
-        backA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+                    drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
+                    drce->SetViolatingRule( constraint.GetParentRule() );
+                }
 
-        BOX2I fpA_bbox = fpA->GetBoundingBox();
+                drce->SetItems( fpA, fpB );
+                aViolations.push_back( { drce, pos, F_CrtYd } );
+            }
+        }
+    }
 
-        for( auto itB = itA + 1; itB != m_board->Footprints().end(); itB++ )
-        {
-            FOOTPRINT*            fpB = *itB;
-            const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
-            const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
+    //
+    // Check courtyard-to-courtyard collisions on back of board.
+    //
 
-            if( frontB.OutlineCount() == 0 && backB.OutlineCount() == 0
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+    if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
+            && backA_worstCaseBBox.Intersects( backB.BBoxFromCaches() ) )
+    {
+        constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
+        clearance = constraint.GetValue().Min();
+
+        if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
+        {
+            if( backA.Collide( &backB, clearance, &actual, &pos ) )
             {
-                // No courtyards defined and no hole testing against other footprint's courtyards
-                continue;
-            }
+                auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
 
-            BOX2I frontB_worstCaseBBox = frontB.BBoxFromCaches();
-            BOX2I backB_worstCaseBBox = backB.BBoxFromCaches();
+                if( clearance > 0 )
+                {
+                    wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                              constraint.GetName(),
+                                              clearance,
+                                              actual );
 
-            frontB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
-            backB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+                    drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
+                    drce->SetViolatingRule( constraint.GetParentRule() );
+                }
 
-            BOX2I          fpB_bbox = fpB->GetBoundingBox();
-            DRC_CONSTRAINT constraint;
-            int            clearance;
-            int            actual;
-            VECTOR2I       pos;
+                drce->SetItems( fpA, fpB );
+                aViolations.push_back( { drce, pos, B_CrtYd } );
+            }
+        }
+    }
 
-            //
-            // Check courtyard-to-courtyard collisions on front of board.
-            //
+    //
+    // Check pad-hole-to-courtyard collisions on front and back of board.
+    //
+    // NB: via holes are not checked.  There is a presumption that a physical object goes
+    // through a pad hole, which is not the case for via holes.
+    //
 
-            if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
-                    && frontA_worstCaseBBox.Intersects( frontB.BBoxFromCaches() ) )
+    auto testPadAgainstCourtyards =
+            [&]( const PAD* pad, const FOOTPRINT* fp )
             {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, F_Cu );
-                clearance = constraint.GetValue().Min();
+                int errorCode = 0;
 
-                if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
-                {
-                    if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
-                    {
-                        auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
+                if( pad->GetAttribute() == PAD_ATTRIB::PTH )
+                    errorCode = DRCE_PTH_IN_COURTYARD;
+                else if( pad->GetAttribute() == PAD_ATTRIB::NPTH )
+                    errorCode = DRCE_NPTH_IN_COURTYARD;
+                else
+                    return;
 
-                        if( clearance > 0 )
-                        {
-                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                      constraint.GetName(),
-                                                      clearance,
-                                                      actual );
+                if( m_drcEngine->IsErrorLimitExceeded( errorCode ) )
+                    return;
 
-                            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                            drce->SetViolatingRule( constraint.GetParentRule() );
-                        }
+                if( pad->HasHole() )
+                {
+                    std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
+                    const SHAPE_POLY_SET&          front = fp->GetCourtyard( F_CrtYd );
+                    const SHAPE_POLY_SET&          back = fp->GetCourtyard( B_CrtYd );
 
-                        drce->SetItems( fpA, fpB );
-                        reportViolation( drce, pos, F_CrtYd );
+                    if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
+                    {
+                        std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
+                        drce->SetItems( pad, fp );
+                        aViolations.push_back( { drce, pad->GetPosition(), F_CrtYd } );
+                    }
+                    else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
+                    {
+                        std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
+                        drce->SetItems( pad, fp );
+                        aViolations.push_back( { drce, pad->GetPosition(), B_CrtYd } );
                     }
                 }
-            }
+            };
+
+    if( ( frontA.OutlineCount() > 0 && frontA_worstCaseBBox.Intersects( fpB_bbox ) )
+        || ( backA.OutlineCount() > 0 && backA_worstCaseBBox.Intersects( fpB_bbox ) ) )
+    {
+        for( const PAD* padB : fpB->Pads() )
+            testPadAgainstCourtyards( padB, fpA );
+    }
+
+    if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpA_bbox ) )
+        || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpA_bbox ) ) )
+    {
+        for( const PAD* padA : fpA->Pads() )
+            testPadAgainstCourtyards( padA, fpB );
+    }
+}
 
-            //
-            // Check courtyard-to-courtyard collisions on back of board.
-            //
 
-            if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
-                    && backA_worstCaseBBox.Intersects( backB.BBoxFromCaches() ) )
+bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
+{
+    if( !reportPhase( _( "Checking footprints for overlapping courtyards..." ) ) )
+        return false;   // DRC cancelled
+
+    auto allLimitsExceeded =
+            [&]()
             {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
-                clearance = constraint.GetValue().Min();
+                return m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS )
+                        && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+                        && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD );
+            };
 
-                if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
-                {
-                    if( backA.Collide( &backB, clearance, &actual, &pos ) )
-                    {
-                        auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
+    if( allLimitsExceeded() )
+        return true;   // continue with other tests
 
-                        if( clearance > 0 )
-                        {
-                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                      constraint.GetName(),
-                                                      clearance,
-                                                      actual );
+    std::vector<FOOTPRINT*> footprints( m_board->Footprints().begin(),
+                                        m_board->Footprints().end() );
+    DRC_COURTYARD_INDEX     index;
 
-                            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                            drce->SetViolatingRule( constraint.GetParentRule() );
-                        }
+    // Building the index also primes the footprints' bounding box caches before the
+    // worker threads read them.
+    index.Build( footprints );
 
-                        drce->SetItems( fpA, fpB );
-                        reportViolation( drce, pos, B_CrtYd );
-                    }
+    // Each footprint is tested against the later footprints it might interact with.  The
+    // violations are kept per footprint and reported below in the original pair order.
+    std::vector<VIOLATIONS> results( footprints.size() );
+    std::atomic<size_t>     done( 0 );
+
+    auto testFootprint =
+            [&]( size_t ii ) -> size_t
+            {
+                if( m_drcEngine->IsCancelled() )
+                    return 0;
+
+                for( size_t jj : index.QueryCandidates( footprints[ii],
+                                                        m_largestCourtyardClearance ) )
+                {
+                    if( jj > ii )
+                        testFootprintPair( footprints[ii], footprints[jj], results[ii] );
                 }
-            }
 
-            //
-            // Check pad-hole-to-courtyard collisions on front and back of board.
-            //
-            // NB: via holes are not checked.  There is a presumption that a physical object goes
-            // through a pad hole, which is not the case for via holes.
-            //
+                done.fetch_add( 1 );
+                return 1;
+            };
 
-            auto testPadAgainstCourtyards =
-                    [&]( const PAD* pad, const FOOTPRINT* fp )
-                    {
-                        int errorCode = 0;
-
-                        if( pad->GetAttribute() == PAD_ATTRIB::PTH )
-                            errorCode = DRCE_PTH_IN_COURTYARD;
-                        else if( pad->GetAttribute() == PAD_ATTRIB::NPTH )
-                            errorCode = DRCE_NPTH_IN_COURTYARD;
-                        else
-                            return;
-
-                        if( m_drcEngine->IsErrorLimitExceeded( errorCode ) )
-                            return;
-
-                        if( pad->HasHole() )
-                        {
-                            std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
-                            const SHAPE_POLY_SET&          front = fp->GetCourtyard( F_CrtYd );
-                            const SHAPE_POLY_SET&          back = fp->GetCourtyard( B_CrtYd );
-
-                            if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
-                            {
-                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
-                                drce->SetItems( pad, fp );
-                                reportViolation( drce, pad->GetPosition(), F_CrtYd );
-                            }
-                            else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
-                            {
-                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
-                                drce->SetItems( pad, fp );
-                                reportViolation( drce, pad->GetPosition(), B_CrtYd );
-                            }
-                        }
-                    };
+    thread_pool&                     tp = GetKiCadThreadPool();
+    std::vector<std::future<size_t>> returns;
 
-            if( ( frontA.OutlineCount() > 0 && frontA_worstCaseBBox.Intersects( fpB_bbox ) )
-                || ( backA.OutlineCount() > 0 && backA_worstCaseBBox.Intersects( fpB_bbox ) ) )
-            {
-                for( const PAD* padB : fpB->Pads() )
-                    testPadAgainstCourtyards( padB, fpA );
-            }
+    returns.reserve( footprints.size() );
 
-            if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpA_bbox ) )
-                || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpA_bbox ) ) )
+    for( size_t ii = 0; ii < footprints.size(); ++ii )
+        returns.emplace_back( tp.submit( testFootprint, ii ) );
+
+    for( const std::future<size_t>& ret : returns )
+    {
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+        while( status != std::future_status::ready )
+        {
+            m_drcEngine->ReportProgress( static_cast<double>( done ) / footprints.size() );
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        }
+    }
+
+    if( m_drcEngine->IsCancelled() )
+        return false;
+
+    // Hole-in-courtyard violations are only reported while under their error limit, as the
+    // tests themselves would have done when run in order.
+    for( VIOLATIONS& violations : results )
+    {
+        if( allLimitsExceeded() )
+            return true;   // continue with other tests
+
+        for( PENDING_VIOLATION& violation : violations )
+        {
+            int errorCode = violation.m_item->GetErrorCode();
+
+            if( errorCode != DRCE_OVERLAPPING_FOOTPRINTS
+                    && m_drcEngine->IsErrorLimitExceeded( errorCode ) )
             {
-                for( const PAD* padA : fpA->Pads() )
-                    testPadAgainstCourtyards( padA, fpB );
+                continue;
             }
 
-            if( m_drcEngine->IsCancelled() )
-                return false;
+            reportViolation( violation.m_item, violation.m_pos, violation.m_layer );
         }
     }
 
@@ -1123,7 +1123,10 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool addToHistory,
     if( addToHistory )
         UpdateFileHistory( GetBoard()->GetFileName() );
 
-    // Delete auto save file on successful save.
+    // Delete auto save file on successful save.  Let any auto save still being written finish
+    // first so it doesn't recreate the file afterwards.
+    waitForAutoSave();
+
     wxFileName autoSaveFileName = pcbFileName;
 
     autoSaveFileName.SetName( GetAutoSaveFilePrefix() + pcbFileName.GetName() );
@@ -1221,13 +1224,14 @@ bool PCB_EDIT_FRAME::doAutoSave()
     if( !IsContentModified() )
         return true;
 
-    wxString title = GetTitle();    // Save frame title, that can be modified by the save process
+    // Still writing the previous snapshot; try again later
+    if( m_autoSaveResult.valid() )
+        return false;
 
     if( GetBoard()->GetFileName().IsEmpty() )
     {
         tmpFileName = wxFileName( PATHS::GetDefaultUserProjectsPath(), NAMELESS_PROJECT,
                                   KiCadPcbFileExtension );
-        GetBoard()->SetFileName( tmpFileName.GetFullPath() );
     }
     else
     {
@@ -1255,30 +1259,75 @@ bool PCB_EDIT_FRAME::doAutoSave()
     wxLogTrace( traceAutoSave,
                 wxT( "Creating auto save file <" ) + autoSaveFileName.GetFullPath() + wxT( ">" ) );
 
-    if( SavePcbFile( autoSaveFileName.GetFullPath(), false, false ) )
+    GetBoard()->SynchronizeNetsAndNetClasses();
+
+    // Serialize the board into memory.  This is the snapshot that gets written out; the board
+    // itself is free to change again as soon as we return to the event loop.
+    STRING_FORMATTER snapshot;
+
+    try
     {
-        GetScreen()->SetContentModified();
-        GetBoard()->SetFileName( tmpFileName.GetFullPath() );
-        UpdateTitle();
-        m_autoSaveRequired = false;
-        m_autoSavePending = false;
-
-        if( !Kiface().IsSingle() &&
-            GetSettingsManager()->GetCommonSettings()->m_Backup.backup_on_autosave )
-        {
-            GetSettingsManager()->TriggerBackupIfNeeded( NULL_REPORTER::GetInstance() );
-        }
+        PCB_PLUGIN pi;
+        pi.FormatBoard( GetBoard(), &snapshot );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceAutoSave, wxT( "Auto save failed: " ) + ioe.What() );
+        return false;
+    }
 
-        SetTitle( title );      // Restore initial frame title
+    // Edits made from now on need another auto save
+    m_autoSaveRequired = false;
+    m_autoSavePending = false;
 
-        return true;
+    SetStatusText( wxString::Format( _( "Auto saving '%s'..." ),
+                                     autoSaveFileName.GetFullName() ), 0 );
+
+    m_autoSaveResult = KiWriteFileAtomicallyAsync( autoSaveFileName.GetFullPath(),
+                                                   snapshot.GetString(),
+                                                   [this]()
+                                                   {
+                                                       CallAfter( [this]()
+                                                                  {
+                                                                      onAutoSaveWritten();
+                                                                  } );
+                                                   } );
+
+    return true;
+}
+
+
+void PCB_EDIT_FRAME::onAutoSaveWritten()
+{
+    if( !m_autoSaveResult.valid() )
+        return;
+
+    wxString error = m_autoSaveResult.get();
+
+    if( !error.IsEmpty() )
+    {
+        wxLogTrace( traceAutoSave, wxT( "Auto save failed: " ) + error );
+        SetStatusText( _( "Auto save failed." ), 0 );
+
+        // Make sure the next idle cycle schedules another attempt
+        m_autoSaveRequired = true;
+        return;
     }
 
-    GetBoard()->SetFileName( tmpFileName.GetFullPath() );
+    SetStatusText( _( "Auto save complete." ), 0 );
 
-    SetTitle( title );      // Restore initial frame title
+    if( !Kiface().IsSingle() &&
+        GetSettingsManager()->GetCommonSettings()->m_Backup.backup_on_autosave )
+    {
+        GetSettingsManager()->TriggerBackupIfNeeded( NULL_REPORTER::GetInstance() );
+    }
+}
 
-    return false;
+
+void PCB_EDIT_FRAME::waitForAutoSave()
+{
+    if( m_autoSaveResult.valid() )
+        m_autoSaveResult.wait();
 }
 
 
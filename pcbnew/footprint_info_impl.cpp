@@ -45,19 +45,20 @@ void FOOTPRINT_INFO_IMPL::load()
 
     wxASSERT( fptable );
 
-    const FOOTPRINT* footprint = fptable->GetEnumeratedFootprint( m_nickname, m_fpname );
+    FOOTPRINT_SUMMARY summary;
 
-    if( footprint == nullptr ) // Should happen only with malformed/broken libraries
+    if( !fptable->GetFootprintSummary( m_nickname, m_fpname, summary ) )
     {
+        // Should happen only with malformed/broken libraries
         m_pad_count = 0;
         m_unique_pad_count = 0;
     }
     else
     {
-        m_pad_count = footprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
-        m_unique_pad_count = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
-        m_keywords = footprint->GetKeywords();
-        m_doc = footprint->GetDescription();
+        m_pad_count = summary.m_padCount;
+        m_unique_pad_count = summary.m_uniquePadCount;
+        m_keywords = summary.m_keywords;
+        m_doc = summary.m_description;
     }
 
     m_loaded = true;
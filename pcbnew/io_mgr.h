@@ -39,6 +39,21 @@ class STRING_UTF8_MAP;
 class PROJECT;
 class PROGRESS_REPORTER;
 
+
+/**
+ * The parts of a footprint shown by the footprint browsers.
+ *
+ * Plugins which keep an index of their libraries can provide this without loading the
+ * footprint itself.
+ */
+struct FOOTPRINT_SUMMARY
+{
+    wxString m_description;
+    wxString m_keywords;
+    unsigned m_padCount       = 0;
+    unsigned m_uniquePadCount = 0;
+};
+
 /**
  * A factory which returns an instance of a #PLUGIN.
  */
@@ -429,6 +444,19 @@ public:
                                                      const wxString& aFootprintName,
                                                      const STRING_UTF8_MAP* aProperties = nullptr );
 
+    /**
+     * Fetch the description, keywords and pad counts of a footprint for use after
+     * FootprintEnumerate().
+     *
+     * The default implementation loads the footprint with GetEnumeratedFootprint(); plugins
+     * which index their libraries can answer without loading it.
+     *
+     * @return false if the footprint could not be found.
+     */
+    virtual bool GetFootprintSummary( const wxString& aLibraryPath, const wxString& aFootprintName,
+                                      FOOTPRINT_SUMMARY& aSummary,
+                                      const STRING_UTF8_MAP* aProperties = nullptr );
+
     /**
      * Check for the existence of a footprint.
      */
@@ -44,6 +44,7 @@
 #include <board.h>
 #include <board_design_settings.h>
 #include <footprint.h>
+#include <zone.h>
 #include <drawing_sheet/ds_proxy_view_item.h>
 #include <connectivity/connectivity_data.h>
 #include <wildcards_and_files_ext.h>
@@ -182,7 +183,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
         PCB_BASE_EDIT_FRAME( aKiway, aParent, FRAME_PCB_EDITOR, _( "PCB Editor" ),
                              wxDefaultPosition, wxDefaultSize, KICAD_DEFAULT_DRAWFRAME_STYLE,
                              PCB_EDIT_FRAME_NAME ),
-        m_exportNetlistAction( nullptr ), m_findDialog( nullptr )
+        m_exportNetlistAction( nullptr ), m_findDialog( nullptr ), m_zoneFillLevel( 0 )
 {
     m_maximizeByDefault = true;
     m_showBorderAndTitleBlock = true;   // true to display sheet references
@@ -357,6 +358,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
                 {
                     m_lastViewport = GetCanvas()->GetView()->GetViewport();
                     m_redrawNetnamesTimer.StartOnce( 500 );
+                    redrawZoneFills();
                 }
 
                 // Do not forget to pass the Idle event to other clients:
@@ -453,6 +455,9 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
 PCB_EDIT_FRAME::~PCB_EDIT_FRAME()
 {
+    // The auto save worker calls back into this frame when it finishes
+    waitForAutoSave();
+
     if( ADVANCED_CFG::GetCfg().m_ShowEventCounters )
     {
         // Stop the timer during destruction early to avoid potential event race conditions (that do happen on windows)
@@ -521,15 +526,38 @@ void PCB_EDIT_FRAME::redrawNetnames( wxTimerEvent& aEvent )
         return;
 
     KIGFX::VIEW* view = GetCanvas()->GetView();
+    BOX2D        viewport = view->GetViewport();
+    double       scale = view->GetScale();
+
+    // Net labels are laid out for the viewport they are drawn in (see PCB_PAINTER), so only the
+    // tracks in view are updated, the others will be when they come into view.  A track fully
+    // inside both the previous and the current viewport keeps its labels while the zoom and
+    // the viewport size do not change.
+    BOX2I viewportBox( viewport.GetOrigin(), viewport.GetSize() );
+    BOX2I previousBox( m_netnamesViewport.GetOrigin(), m_netnamesViewport.GetSize() );
+    bool  sameSize = viewport.GetSize() == m_netnamesViewport.GetSize();
+
+    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> items;
 
-    for( PCB_TRACK* track : GetBoard()->Tracks() )
+    view->Query( viewportBox, items );
+
+    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& item : items )
     {
-        double lod = track->ViewGetLOD( GetNetnameLayer( track->GetLayer() ), view );
-        double scale = view->GetScale();
+        if( !IsNetnameLayer( item.second ) )
+            continue;
+
+        PCB_TRACK* track = dynamic_cast<PCB_TRACK*>( item.first );
 
-        if( lod != track->GetCachedLOD() || scale != track->GetCachedScale() )
+        if( !track )
+            continue;
+
+        double lod = track->ViewGetLOD( item.second, view );
+        BOX2I  bbox = track->GetBoundingBox();
+        bool   unclipped = sameSize && viewportBox.Contains( bbox ) && previousBox.Contains( bbox );
+
+        if( lod != track->GetCachedLOD() || scale != track->GetCachedScale() || !unclipped )
         {
-            if( lod < view->GetScale() )
+            if( lod < scale )
             {
                 view->Update( track, KIGFX::REPAINT );
                 needs_refresh = true;
@@ -540,11 +568,33 @@ void PCB_EDIT_FRAME::redrawNetnames( wxTimerEvent& aEvent )
         }
     }
 
+    m_netnamesViewport = viewport;
+
     if( needs_refresh )
         GetCanvas()->Refresh();
 }
 
 
+void PCB_EDIT_FRAME::redrawZoneFills()
+{
+    KIGFX::VIEW* view = GetCanvas()->GetView();
+
+    // Zone fills are drawn simplified to about half a pixel (see PCB_PAINTER), so they are
+    // only redrawn when the zoom changes the level of simplification.
+    int level = ZONE::GetDisplayFillLevel( KiROUND( view->ToWorld( 0.5 ) ) );
+
+    if( level == m_zoneFillLevel )
+        return;
+
+    m_zoneFillLevel = level;
+
+    for( ZONE* zone : GetBoard()->Zones() )
+        view->Update( zone, KIGFX::REPAINT );
+
+    GetCanvas()->Refresh();
+}
+
+
 void PCB_EDIT_FRAME::SetPageSettings( const PAGE_INFO& aPageSettings )
 {
     PCB_BASE_FRAME::SetPageSettings( aPageSettings );
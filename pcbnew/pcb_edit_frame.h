@@ -25,6 +25,8 @@
 #include "zones.h"
 #include <mail_type.h>
 
+#include <future>
+
 class ACTION_PLUGIN;
 class PCB_SCREEN;
 class BOARD;
@@ -781,6 +783,16 @@ protected:
      */
     bool doAutoSave() override;
 
+    /**
+     * Called on the GUI thread once the background auto save write has finished.
+     */
+    void onAutoSaveWritten();
+
+    /**
+     * Block until any auto save being written in the background has finished.
+     */
+    void waitForAutoSave();
+
     /**
      * Load the given filename but sets the path to the current project path.
      *
@@ -801,6 +813,11 @@ protected:
 
     void redrawNetnames( wxTimerEvent& aEvent );
 
+    /**
+     * Redraw the zone fills when the zoom changed their level of simplification.
+     */
+    void redrawZoneFills();
+
 public:
     PCB_LAYER_BOX_SELECTOR* m_SelLayerBox;  // a combo box to display and select active layer
 
@@ -836,7 +853,17 @@ private:
     BOX2D        m_lastViewport;
     wxTimer      m_redrawNetnamesTimer;
 
+    /**
+     * Viewport the track net labels in view were last laid out for, see redrawNetnames().
+     */
+    BOX2D        m_netnamesViewport;
+
+    /// Level of simplification of the zone fills last drawn, see ZONE::GetDisplayFillLevel()
+    int          m_zoneFillLevel;
+
     wxTimer*     m_eventCounterTimer;
+
+    std::future<wxString> m_autoSaveResult;    ///< Pending background auto save write
 };
 
 #endif  // __PCB_EDIT_FRAME_H__
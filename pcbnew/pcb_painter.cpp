@@ -2394,7 +2394,15 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_FRACTURE_BORDERS
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION ) )
     {
-        const std::shared_ptr<SHAPE_POLY_SET>& polySet = aZone->GetFilledPolysList( layer );
+        std::shared_ptr<SHAPE_POLY_SET> polySet = aZone->GetFilledPolysList( layer );
+
+        // When zoomed out, board zone fills are drawn simplified to about half a pixel.  The
+        // board editor redraws them when the zoom changes the level of simplification.
+        if( aZone->Type() == PCB_ZONE_T && displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED
+                && !m_pcbSettings.m_isPrinting )
+        {
+            polySet = aZone->GetDisplayFill( layer, KiROUND( 0.5 / m_gal->GetWorldScale() ) );
+        }
 
         if( polySet->OutlineCount() == 0 )  // Nothing to draw
             return;
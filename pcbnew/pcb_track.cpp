@@ -427,7 +427,15 @@ INSPECT_RESULT PCB_TRACK::Visit( INSPECTOR inspector, void* testData,
 
 std::shared_ptr<SHAPE_SEGMENT> PCB_VIA::GetEffectiveHoleShape() const
 {
-    return std::make_shared<SHAPE_SEGMENT>( SEG( m_Start, m_Start ), m_drill );
+    std::shared_ptr<SHAPE_SEGMENT> hole = std::atomic_load( &m_effectiveHoleShape );
+
+    if( !hole || hole->GetSeg().A != m_Start || hole->GetWidth() != m_drill )
+    {
+        hole = std::make_shared<SHAPE_SEGMENT>( SEG( m_Start, m_Start ), m_drill );
+        std::atomic_store( &m_effectiveHoleShape, hole );
+    }
+
+    return hole;
 }
 
 
@@ -1150,7 +1158,46 @@ bool PCB_TRACK::cmp_tracks::operator() ( const PCB_TRACK* a, const PCB_TRACK* b
 
 std::shared_ptr<SHAPE> PCB_TRACK::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHING aFlash ) const
 {
-    return std::make_shared<SHAPE_SEGMENT>( m_Start, m_End, m_Width );
+    // These are queried in the innermost loops of DRC, zone filling and connectivity, so the
+    // shape is only rebuilt when the track changed since the last call
+    std::shared_ptr<SHAPE> shape = std::atomic_load( &m_effectiveShape );
+
+    if( shape && shape->Type() == SH_SEGMENT )
+    {
+        const SHAPE_SEGMENT* seg = static_cast<const SHAPE_SEGMENT*>( shape.get() );
+
+        if( seg->GetSeg().A == m_Start && seg->GetSeg().B == m_End && seg->GetWidth() == m_Width )
+            return shape;
+    }
+
+    shape = std::make_shared<SHAPE_SEGMENT>( m_Start, m_End, m_Width );
+    std::atomic_store( &m_effectiveShape, shape );
+
+    return shape;
+}
+
+
+/**
+ * Return the circle cached in \a aCache if it still matches \a aCenter and \a aRadius, or
+ * cache a new one.
+ */
+static std::shared_ptr<SHAPE> getCachedCircle( std::shared_ptr<SHAPE>& aCache,
+                                               const VECTOR2I& aCenter, int aRadius )
+{
+    std::shared_ptr<SHAPE> shape = std::atomic_load( &aCache );
+
+    if( shape && shape->Type() == SH_CIRCLE )
+    {
+        const SHAPE_CIRCLE* circle = static_cast<const SHAPE_CIRCLE*>( shape.get() );
+
+        if( circle->GetCenter() == aCenter && circle->GetRadius() == aRadius )
+            return shape;
+    }
+
+    shape = std::make_shared<SHAPE_CIRCLE>( aCenter, aRadius );
+    std::atomic_store( &aCache, shape );
+
+    return shape;
 }
 
 
@@ -1159,18 +1206,35 @@ std::shared_ptr<SHAPE> PCB_VIA::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHING
     if( aFlash == FLASHING::ALWAYS_FLASHED
             || ( aFlash == FLASHING::DEFAULT && FlashLayer( aLayer ) ) )
     {
-        return std::make_shared<SHAPE_CIRCLE>( m_Start, m_Width / 2 );
+        return getCachedCircle( m_effectiveShape, m_Start, m_Width / 2 );
     }
     else
     {
-        return std::make_shared<SHAPE_CIRCLE>( m_Start, GetDrillValue() / 2 );
+        // The drill value may come from the board settings, it is checked on each call
+        return getCachedCircle( m_effectiveDrillShape, m_Start, GetDrillValue() / 2 );
     }
 }
 
 
 std::shared_ptr<SHAPE> PCB_ARC::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHING aFlash ) const
 {
-    return std::make_shared<SHAPE_ARC>( GetStart(), GetMid(), GetEnd(), GetWidth() );
+    std::shared_ptr<SHAPE> shape = std::atomic_load( &m_effectiveShape );
+
+    if( shape && shape->Type() == SH_ARC )
+    {
+        const SHAPE_ARC* arc = static_cast<const SHAPE_ARC*>( shape.get() );
+
+        if( arc->GetP0() == m_Start && arc->GetArcMid() == m_Mid && arc->GetP1() == m_End
+                && arc->GetWidth() == m_Width )
+        {
+            return shape;
+        }
+    }
+
+    shape = std::make_shared<SHAPE_ARC>( m_Start, m_Mid, m_End, m_Width );
+    std::atomic_store( &m_effectiveShape, shape );
+
+    return shape;
 }
 
 
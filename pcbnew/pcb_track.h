@@ -275,6 +275,13 @@ protected:
 
     double   m_CachedLOD; ///< Last LOD used to draw this track's net
     double   m_CachedScale; ///< Last zoom scale used to draw this track's net (we want to redraw when changing zoom)
+
+    /**
+     * The last shape returned by GetEffectiveShape(), reused as long as it matches the geometry.
+     * Cached shapes are never modified, and are accessed with std::atomic_load/atomic_store as
+     * items are queried from several threads.
+     */
+    mutable std::shared_ptr<SHAPE> m_effectiveShape;
 };
 
 
@@ -568,6 +575,10 @@ private:
     bool         m_isFree;                   ///< "Free" vias don't get their nets auto-updated
 
     mutable ZONE_LAYER_CONNECTION m_zoneLayerConnections[B_Cu + 1];
+
+    /// Cached unflashed shape and hole shape, see PCB_TRACK::m_effectiveShape.
+    mutable std::shared_ptr<SHAPE>         m_effectiveDrillShape;
+    mutable std::shared_ptr<SHAPE_SEGMENT> m_effectiveHoleShape;
 };
 
 
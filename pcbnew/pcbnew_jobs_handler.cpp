@@ -26,6 +26,7 @@
 #include <jobs/job_export_pcb_pos.h>
 #include <jobs/job_export_pcb_svg.h>
 #include <jobs/job_export_pcb_step.h>
+#include <jobs/job_pcb_render.h>
 #include <cli/exit_codes.h>
 #include <plotters/plotter_dxf.h>
 #include <plotters/plotter_gerber.h>
@@ -42,6 +43,12 @@
 #include <gendrill_Excellon_writer.h>
 #include <gendrill_gerber_writer.h>
 #include <wildcards_and_files_ext.h>
+#include <3d_rendering/raytracing/render_3d_raytrace.h>
+#include <3d_rendering/track_ball.h>
+#include <3d_viewer/eda_3d_viewer_settings.h>
+#include <project.h>
+#include <reporter.h>
+#include <wx/image.h>
 
 #include "pcbnew_scripting_helpers.h"
 
@@ -55,6 +62,7 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER()
     Register( "gerber",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportGerber, this, std::placeholders::_1 ) );
     Register( "drill", std::bind( &PCBNEW_JOBS_HANDLER::JobExportDrill, this, std::placeholders::_1 ) );
+    Register( "render", std::bind( &PCBNEW_JOBS_HANDLER::JobRender, this, std::placeholders::_1 ) );
 }
 
 
@@ -459,4 +467,115 @@ int PCBNEW_JOBS_HANDLER::JobExportPos( JOB* aJob )
     }
 
     return CLI::EXIT_CODES::OK;
-}
\ No newline at end of file
+}
+
+
+int PCBNEW_JOBS_HANDLER::JobRender( JOB* aJob )
+{
+    JOB_PCB_RENDER* aRenderJob = dynamic_cast<JOB_PCB_RENDER*>( aJob );
+
+    if( aRenderJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    if( aJob->IsCli() )
+        wxPrintf( _( "Loading board\n" ) );
+
+    BOARD* brd = LoadBoard( aRenderJob->m_filename );
+
+    if( !brd )
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+
+    if( aRenderJob->m_outputFile.IsEmpty() )
+    {
+        wxFileName fn = brd->GetFileName();
+        fn.SetName( fn.GetName() );
+        fn.SetExt( PngFileExtension );
+
+        aRenderJob->m_outputFile = fn.GetFullName();
+    }
+
+    // Start from the default 3D viewer settings, so the result does not depend on the user
+    // settings and nothing is saved back to them
+    EDA_3D_VIEWER_SETTINGS cfg;
+    cfg.ResetToDefaults();
+
+    const bool highQuality = aRenderJob->m_quality == JOB_PCB_RENDER::QUALITY::HIGH;
+
+    cfg.m_Render.engine = RENDER_ENGINE::RAYTRACING;
+    cfg.m_Render.raytrace_shadows = true;
+    cfg.m_Render.raytrace_procedural_textures = true;
+    cfg.m_Render.raytrace_backfloor = aRenderJob->m_floor;
+    cfg.m_Render.raytrace_anti_aliasing = highQuality;
+    cfg.m_Render.raytrace_post_processing = highQuality;
+    cfg.m_Render.raytrace_reflections = highQuality;
+    cfg.m_Render.raytrace_refractions = highQuality;
+
+    BOARD_ADAPTER boardAdapter;
+    TRACK_BALL    camera( 2 * RANGE_SCALE_3D );
+
+    boardAdapter.SetBoard( brd );
+    boardAdapter.Set3dCacheManager( brd->GetProject()->Get3DCacheManager() );
+    boardAdapter.m_Cfg = &cfg;
+
+    const wxSize size( aRenderJob->m_width, aRenderJob->m_height );
+
+    camera.SetCurWindowSize( size );
+    camera.SetProjection( aRenderJob->m_perspective ? PROJECTION_TYPE::PERSPECTIVE
+                                                    : PROJECTION_TYPE::ORTHO );
+
+    // Same views as the 3D viewer
+    switch( aRenderJob->m_side )
+    {
+    case JOB_PCB_RENDER::SIDE::TOP:
+        break;
+
+    case JOB_PCB_RENDER::SIDE::BOTTOM:
+        camera.RotateY( glm::radians( 179.999f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::LEFT:
+        camera.RotateZ( glm::radians( 90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::RIGHT:
+        camera.RotateZ( glm::radians( -90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::FRONT:
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::BACK:
+        camera.RotateX( glm::radians( -90.0f ) );
+        camera.RotateZ( glm::radians( 179.999f ) );
+        break;
+    }
+
+    camera.RotateX( glm::radians( (float) aRenderJob->m_rotateX ) );
+    camera.RotateY( glm::radians( (float) aRenderJob->m_rotateY ) );
+    camera.RotateZ( glm::radians( (float) aRenderJob->m_rotateZ ) );
+    camera.Zoom( (float) aRenderJob->m_zoom );
+
+    REPORTER& reporter = aJob->IsCli() ? STDOUT_REPORTER::GetInstance()
+                                       : NULL_REPORTER::GetInstance();
+
+    RENDER_3D_RAYTRACE renderer( nullptr, boardAdapter, camera );
+    wxImage            image;
+
+    renderer.RenderImage( size, image, &reporter, &reporter );
+
+    if( !image.SaveFile( aRenderJob->m_outputFile, wxBITMAP_TYPE_PNG ) )
+    {
+        if( aJob->IsCli() )
+            wxPrintf( _( "Error creating png file\n" ) );
+
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    }
+
+    if( aJob->IsCli() )
+        wxPrintf( _( "Successfully created png file\n" ) );
+
+    return CLI::EXIT_CODES::OK;
+}
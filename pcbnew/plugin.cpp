@@ -22,6 +22,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <footprint.h>
 #include <io_mgr.h>
 #include <string_utf8_map.h>
 #include <wx/translation.h>
@@ -86,6 +87,26 @@ const FOOTPRINT* PLUGIN::GetEnumeratedFootprint( const wxString& aLibraryPath,
 }
 
 
+bool PLUGIN::GetFootprintSummary( const wxString& aLibraryPath, const wxString& aFootprintName,
+                                  FOOTPRINT_SUMMARY& aSummary,
+                                  const STRING_UTF8_MAP* aProperties )
+{
+    // default implementation
+    const FOOTPRINT* footprint = GetEnumeratedFootprint( aLibraryPath, aFootprintName,
+                                                         aProperties );
+
+    if( !footprint )
+        return false;
+
+    aSummary.m_description = footprint->GetDescription();
+    aSummary.m_keywords = footprint->GetKeywords();
+    aSummary.m_padCount = footprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
+    aSummary.m_uniquePadCount = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+
+    return true;
+}
+
+
 bool PLUGIN::FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                               const STRING_UTF8_MAP* aProperties )
 {
@@ -53,6 +53,7 @@
 #include <wx/wfstream.h>
 #include <wx/zstream.h>
 #include <progress_reporter.h>
+#include <thread_pool.h>
 
 
 constexpr double BOLD_FACTOR = 1.75;    // CSS font-weight-normal is 400; bold is 700
@@ -334,6 +335,58 @@ std::vector<PCB_LAYER_ID> ALTIUM_PCB::GetKicadLayersToIterate( ALTIUM_LAYER aAlt
 }
 
 
+/**
+ * Decode all the records of a stream on the thread pool.
+ *
+ * The stream is read before returning, the task does not use \a aFile.
+ *
+ * @param aArgs are the record constructor arguments following the parser.
+ */
+template <typename RECORD, typename... ARGS>
+static std::future<std::vector<RECORD>> decodeRecordsAsync( const ALTIUM_COMPOUND_FILE& aFile,
+                                                            const CFB::COMPOUND_FILE_ENTRY* aEntry,
+                                                            const wxString& aStreamName,
+                                                            ARGS... aArgs )
+{
+    std::shared_ptr<ALTIUM_PARSER> reader = std::make_shared<ALTIUM_PARSER>( aFile, aEntry );
+    thread_pool&                   tp = GetKiCadThreadPool();
+
+    return tp.submit(
+            [reader, aStreamName, aArgs...]() -> std::vector<RECORD>
+            {
+                std::vector<RECORD> records;
+
+                while( reader->GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+                    records.emplace_back( *reader, aArgs... );
+
+                if( reader->GetRemainingBytes() != 0 )
+                {
+                    THROW_IO_ERROR( wxString::Format( wxT( "%s stream is not fully parsed" ),
+                                                      aStreamName ) );
+                }
+
+                return records;
+            } );
+}
+
+
+/**
+ * Return the records decoded by decodeRecordsAsync() in \a aDecoded, or decode them now if
+ * they were not.
+ */
+template <typename RECORD, typename... ARGS>
+static std::vector<RECORD> getRecords( std::future<std::vector<RECORD>>& aDecoded,
+                                       const ALTIUM_COMPOUND_FILE&       aFile,
+                                       const CFB::COMPOUND_FILE_ENTRY*   aEntry,
+                                       const wxString& aStreamName, ARGS... aArgs )
+{
+    if( !aDecoded.valid() )
+        aDecoded = decodeRecordsAsync<RECORD>( aFile, aEntry, aStreamName, aArgs... );
+
+    return aDecoded.get();
+}
+
+
 ALTIUM_PCB::ALTIUM_PCB( BOARD* aBoard, PROGRESS_REPORTER* aProgressReporter )
 {
     m_board              = aBoard;
@@ -524,6 +577,37 @@ void ALTIUM_PCB::Parse( const ALTIUM_COMPOUND_FILE&                  altiumPcbFi
         }
     }
 
+    // The primitive streams are the largest ones and their records do not depend on the other
+    // streams: decode them in the background while the first streams are converted.
+    auto findData =
+            [&]( ALTIUM_PCB_DIR aDirectory ) -> const CFB::COMPOUND_FILE_ENTRY*
+            {
+                const auto& mappedDirectory = aFileMapping.find( aDirectory );
+
+                if( mappedDirectory == aFileMapping.end() )
+                    return nullptr;
+
+                return altiumPcbFile.FindStream( { mappedDirectory->second, "Data" } );
+            };
+
+    if( const CFB::COMPOUND_FILE_ENTRY* entry = findData( ALTIUM_PCB_DIR::ARCS6 ) )
+        m_arcs6 = decodeRecordsAsync<AARC6>( altiumPcbFile, entry, wxT( "Arcs6" ) );
+
+    if( const CFB::COMPOUND_FILE_ENTRY* entry = findData( ALTIUM_PCB_DIR::PADS6 ) )
+        m_pads6 = decodeRecordsAsync<APAD6>( altiumPcbFile, entry, wxT( "Pads6" ) );
+
+    if( const CFB::COMPOUND_FILE_ENTRY* entry = findData( ALTIUM_PCB_DIR::VIAS6 ) )
+        m_vias6 = decodeRecordsAsync<AVIA6>( altiumPcbFile, entry, wxT( "Vias6" ) );
+
+    if( const CFB::COMPOUND_FILE_ENTRY* entry = findData( ALTIUM_PCB_DIR::TRACKS6 ) )
+        m_tracks6 = decodeRecordsAsync<ATRACK6>( altiumPcbFile, entry, wxT( "Tracks6" ) );
+
+    if( const CFB::COMPOUND_FILE_ENTRY* entry = findData( ALTIUM_PCB_DIR::SHAPEBASEDREGIONS6 ) )
+    {
+        m_shapeBasedRegions6 = decodeRecordsAsync<AREGION6>( altiumPcbFile, entry,
+                                                             wxT( "ShapeBasedRegions6" ), true );
+    }
+
     // Parse data in specified order
     for( const std::tuple<bool, ALTIUM_PCB_DIR, PARSE_FUNCTION_POINTER_fp>& cur : parserOrder )
     {
@@ -1888,12 +1972,12 @@ void ALTIUM_PCB::ParseShapeBasedRegions6Data( const ALTIUM_COMPOUND_FILE&     aA
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading zones..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AREGION6> regions = getRecords( m_shapeBasedRegions6, aAltiumPcbFile, aEntry,
+                                                wxT( "ShapeBasedRegions6" ), true );
 
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AREGION6& elem : regions )
     {
         checkpoint();
-        AREGION6 elem( reader, true );
 
         if( elem.component == ALTIUM_COMPONENT_NONE
             || elem.kind == ALTIUM_REGION_KIND::BOARD_CUTOUT )
@@ -1907,9 +1991,6 @@ void ALTIUM_PCB::ParseShapeBasedRegions6Data( const ALTIUM_COMPOUND_FILE&     aA
             ConvertShapeBasedRegions6ToFootprintItem( footprint, elem );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "ShapeBasedRegions6 stream is not fully parsed" );
 }
 
 
@@ -2149,12 +2230,12 @@ void ALTIUM_PCB::ParseArcs6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading arcs..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AARC6> arcs = getRecords( m_arcs6, aAltiumPcbFile, aEntry, wxT( "Arcs6" ) );
 
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) arcs.size(); primitiveIndex++ )
     {
         checkpoint();
-        AARC6 elem( reader );
+        const AARC6& elem = arcs[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -2166,9 +2247,6 @@ void ALTIUM_PCB::ParseArcs6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
             ConvertArcs6ToFootprintItem( footprint, elem, primitiveIndex, true );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "Arcs6 stream is not fully parsed" );
 }
 
 
@@ -2354,12 +2432,9 @@ void ALTIUM_PCB::ParsePads6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading pads..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const APAD6& elem : getRecords( m_pads6, aAltiumPcbFile, aEntry, wxT( "Pads6" ) ) )
     {
         checkpoint();
-        APAD6 elem( reader );
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -2371,9 +2446,6 @@ void ALTIUM_PCB::ParsePads6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
             ConvertPads6ToFootprintItem( footprint, elem );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Pads6 stream is not fully parsed" ) );
 }
 
 
@@ -2815,12 +2887,9 @@ void ALTIUM_PCB::ParseVias6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading vias..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AVIA6& elem : getRecords( m_vias6, aAltiumPcbFile, aEntry, wxT( "Vias6" ) ) )
     {
         checkpoint();
-        AVIA6 elem( reader );
 
         PCB_VIA* via = new PCB_VIA( m_board );
         m_board->Add( via, ADD_MODE::APPEND );
@@ -2864,9 +2933,6 @@ void ALTIUM_PCB::ParseVias6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
         // we need VIATYPE set!
         via->SetLayerPair( start_klayer, end_klayer );
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Vias6 stream is not fully parsed" ) );
 }
 
 void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
@@ -2875,12 +2941,13 @@ void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFil
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading tracks..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<ATRACK6> tracks = getRecords( m_tracks6, aAltiumPcbFile, aEntry,
+                                              wxT( "Tracks6" ) );
 
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) tracks.size(); primitiveIndex++ )
     {
         checkpoint();
-        ATRACK6 elem( reader );
+        const ATRACK6& elem = tracks[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -2892,9 +2959,6 @@ void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFil
             ConvertTracks6ToFootprintItem( footprint, elem, primitiveIndex, true );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "Tracks6 stream is not fully parsed" );
 }
 
 
@@ -25,6 +25,7 @@
 #define ALTIUM_PCB_H
 
 #include <functional>
+#include <future>
 #include <layer_ids.h>
 #include <vector>
 
@@ -251,6 +252,13 @@ private:
 
     std::map<ALTIUM_LAYER, ZONE*>        m_outer_plane;
 
+    /// Records of the primitive streams, decoded on the thread pool.  See Parse().
+    std::future<std::vector<AARC6>>    m_arcs6;
+    std::future<std::vector<APAD6>>    m_pads6;
+    std::future<std::vector<AVIA6>>    m_vias6;
+    std::future<std::vector<ATRACK6>>  m_tracks6;
+    std::future<std::vector<AREGION6>> m_shapeBasedRegions6;
+
     PROGRESS_REPORTER* m_progressReporter; ///< optional; may be nullptr
     unsigned           m_doneCount;
     unsigned           m_lastProgressCount;
@@ -79,6 +79,7 @@ Load() TODO's
 #include <pad_shapes.h>
 #include <pcb_text.h>
 #include <pcb_dimension.h>
+#include <thread_pool.h>
 
 #include <plugins/eagle/eagle_plugin.h>
 
@@ -602,10 +603,34 @@ void EAGLE_PLUGIN::loadAllSections( wxXmlNode* aDoc )
     {
         m_xpath->push( "board" );
 
-        loadPlain( plain );
-        loadClasses( classes );
-        loadSignals( signals );
+        // The library packages are converted in the background while the board items are
+        // loaded, they are only needed by the elements
         loadLibraries( libs );
+
+        try
+        {
+            loadPlain( plain );
+            loadClasses( classes );
+            loadSignals( signals );
+        }
+        catch( ... )
+        {
+            cancelLibraries();
+            throw;
+        }
+
+        m_xpath->push( "libraries.library" );
+        finishLibraries();
+        m_xpath->pop();
+
+        // The sections already loaded are not needed anymore, free them to lower the peak
+        // memory use of large boards
+        for( wxXmlNode* section : { plain, signals, boardChildren["libraries"] } )
+        {
+            if( section && board->RemoveChild( section ) )
+                delete section;
+        }
+
         loadElements( elems );
 
         m_xpath->pop();
@@ -1141,7 +1166,7 @@ void EAGLE_PLUGIN::loadPlain( wxXmlNode* aGraphics )
 }
 
 
-void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
+void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName, bool aParallel )
 {
     if( !aLib )
         return;
@@ -1152,50 +1177,99 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
     if( !packages )
         return;
 
-    m_xpath->push( "packages" );
-
     // Create a FOOTPRINT for all the eagle packages, for use later via a copy constructor
-    // to instantiate needed footprints in our BOARD.  Save the FOOTPRINT templates in
-    // a FOOTPRINT_MAP using a single lookup key consisting of libname+pkgname.
+    // to instantiate needed footprints in our BOARD.  The packages are independent of each
+    // other so they can be converted by worker threads, see finishLibraries().
+    thread_pool& tp = GetKiCadThreadPool();
 
     // Get the first package and iterate
     wxXmlNode* package = packages->GetChildren();
 
     while( package )
     {
-        checkpoint();
-
-        m_xpath->push( "package", "name" );
-
         wxString pack_ref = package->GetAttribute( "name" );
         ReplaceIllegalFileNameChars( pack_ref, '_' );
 
-        m_xpath->Value( pack_ref.ToUTF8() );
+        PACKAGE_JOB& job = m_packageJobs.emplace_back();
+
+        job.m_key = aLibName ? makeKey( *aLibName, pack_ref ) : pack_ref;
+        job.m_name = pack_ref;
+        job.m_libName = aLibName ? *aLibName : m_lib_path;
+
+        auto convert =
+                [this, package, pack_ref]()
+                {
+                    return std::unique_ptr<FOOTPRINT>( makeFootprint( package, pack_ref ) );
+                };
+
+        if( aParallel )
+        {
+            job.m_footprint = tp.submit( convert );
+        }
+        else
+        {
+            // Keep any error for finishLibraries() so it is reported the same way
+            std::packaged_task<std::unique_ptr<FOOTPRINT>()> task( convert );
 
-        wxString key = aLibName ? makeKey( *aLibName, pack_ref ) : pack_ref;
+            job.m_footprint = task.get_future();
+            task();
+        }
 
-        FOOTPRINT* footprint = makeFootprint( package, pack_ref );
+        package = package->GetNext();
+    }
+}
+
+
+void EAGLE_PLUGIN::finishLibraries()
+{
+    std::vector<PACKAGE_JOB> jobs;
+    jobs.swap( m_packageJobs );
+
+    // None of the jobs may still be reading the XML document if one of them failed
+    for( PACKAGE_JOB& job : jobs )
+        job.m_footprint.wait();
+
+    m_xpath->push( "packages.package", "name" );
+
+    for( PACKAGE_JOB& job : jobs )
+    {
+        checkpoint();
+
+        m_xpath->Value( job.m_name.ToUTF8() );
+
+        std::unique_ptr<FOOTPRINT> footprint = job.m_footprint.get();
+
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->GetAttribute() == PAD_ATTRIB::PTH && pad->GetDrillSizeX() < m_min_hole )
+                m_min_hole = pad->GetDrillSizeX();
+        }
 
         // add the templating FOOTPRINT to the FOOTPRINT template factory "m_templates"
-        std::pair<FOOTPRINT_MAP::iterator, bool> r = m_templates.insert( { key, footprint} );
+        std::pair<FOOTPRINT_MAP::iterator, bool> r = m_templates.insert( { job.m_key,
+                                                                           footprint.get() } );
 
         if( !r.second /* && !( m_props && m_props->Value( "ignore_duplicates" ) ) */ )
         {
-            wxString lib = aLibName ? *aLibName : m_lib_path;
-            const wxString& pkg = pack_ref;
-
             wxString emsg = wxString::Format( _( "<package> '%s' duplicated in <library> '%s'" ),
-                                              pkg,
-                                              lib );
+                                              job.m_name,
+                                              job.m_libName );
             THROW_IO_ERROR( emsg );
         }
 
-        m_xpath->pop();
-
-        package = package->GetNext();
+        footprint.release();
     }
 
-    m_xpath->pop();     // "packages"
+    m_xpath->pop();
+}
+
+
+void EAGLE_PLUGIN::cancelLibraries()
+{
+    for( PACKAGE_JOB& job : m_packageJobs )
+        job.m_footprint.wait();
+
+    m_packageJobs.clear();
 }
 
 
@@ -1214,7 +1288,7 @@ void EAGLE_PLUGIN::loadLibraries( wxXmlNode* aLibs )
         const wxString& lib_name = library->GetAttribute( "name" );
 
         m_xpath->Value( lib_name.c_str() );
-        loadLibrary( library, &lib_name );
+        loadLibrary( library, &lib_name, true );
         library = library->GetNext();
     }
 
@@ -1806,7 +1880,7 @@ void EAGLE_PLUGIN::orientFPText( FOOTPRINT* aFootprint, const EELEMENT& e, FP_TE
 }
 
 
-FOOTPRINT* EAGLE_PLUGIN::makeFootprint( wxXmlNode* aPackage, const wxString& aPkgName )
+FOOTPRINT* EAGLE_PLUGIN::makeFootprint( wxXmlNode* aPackage, const wxString& aPkgName ) const
 {
     std::unique_ptr<FOOTPRINT> m = std::make_unique<FOOTPRINT>( m_board );
 
@@ -1924,7 +1998,7 @@ void EAGLE_PLUGIN::packageWire( FOOTPRINT* aFootprint, wxXmlNode* aTree ) const
 }
 
 
-void EAGLE_PLUGIN::packagePad( FOOTPRINT* aFootprint, wxXmlNode* aTree )
+void EAGLE_PLUGIN::packagePad( FOOTPRINT* aFootprint, wxXmlNode* aTree ) const
 {
     // this is thru hole technology here, no SMDs
     EPAD e( aTree );
@@ -1944,9 +2018,6 @@ void EAGLE_PLUGIN::packagePad( FOOTPRINT* aFootprint, wxXmlNode* aTree )
     pad->SetDrillSize( wxSize( eagleDrillz, eagleDrillz ) );
     pad->SetLayerSet( LSET::AllCuMask() );
 
-    if( eagleDrillz < m_min_hole )
-        m_min_hole = eagleDrillz;
-
     // Solder mask
     if( !e.stop || *e.stop == true )         // enabled by default
         pad->SetLayerSet( pad->GetLayerSet().set( B_Mask ).set( F_Mask ) );
@@ -3201,13 +3272,19 @@ void EAGLE_PLUGIN::cacheLib( const wxString& aLibPath )
 
             m_xpath->push( "eagle.drawing.library" );
             wxXmlNode* library = drawingChildren["library"];
-            loadLibrary( library, nullptr );
+            // Libraries are cached from FOOTPRINT_LIST_IMPL's worker threads, which must not wait
+            // for other tasks of the same pool.
+            loadLibrary( library, nullptr, false );
+            finishLibraries();
             m_xpath->pop();
 
             m_mod_time = modtime;
         }
     }
-    catch(...){}
+    catch(...)
+    {
+        cancelLibraries();
+    }
     // TODO: Handle exceptions
     // catch( file_parser_error fpe )
     // {
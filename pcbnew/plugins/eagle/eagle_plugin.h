@@ -32,7 +32,9 @@
 #include <plugins/eagle/eagle_parser.h>
 #include <plugins/common/plugin_common_layer_mapping.h>
 
+#include <future>
 #include <map>
+#include <memory>
 #include <tuple>
 #include <wx/xml/xml.h>
 
@@ -252,15 +254,33 @@ private:
      * Load the Eagle "library" XML element, which can occur either under a "libraries"
      * element (if a *.brd file) or under a "drawing" element if a *.lbr file.
      *
+     * finishLibraries() must be called to add the converted footprints to m_templates before
+     * the XML document is released.
+     *
      * @param aLib is the portion of the loaded XML document tree that is the "library"
      *             element.
      * @param aLibName is a pointer to the library name or NULL.  If NULL this means
      *                 we are loading a *.lbr not a *.brd file and the key used in m_templates
      *                 is to exclude the library name.
+     * @param aParallel converts the packages on the thread pool.  This must only be used when
+     *                  not running on the thread pool already, because finishLibraries() blocks
+     *                  until the conversions are done.
      */
-    void loadLibrary( wxXmlNode* aLib, const wxString* aLibName );
+    void loadLibrary( wxXmlNode* aLib, const wxString* aLibName, bool aParallel );
 
     void loadLibraries( wxXmlNode* aLibs );
+
+    /**
+     * Wait for the packages queued by loadLibrary() and add their footprints to m_templates.
+     *
+     * @throw IO_ERROR or XML_PARSER_ERROR if a package could not be converted.
+     */
+    void finishLibraries();
+
+    /**
+     * Wait for the packages queued by loadLibrary() and discard them, when the load failed.
+     */
+    void cancelLibraries();
     void loadElements( wxXmlNode* aElements );
 
     /**
@@ -282,11 +302,14 @@ private:
 
     /**
      * Create a FOOTPRINT from an Eagle package.
+     *
+     * This is run by worker threads, it and the packageXXX() functions must not modify the
+     * plugin.
      */
-    FOOTPRINT* makeFootprint( wxXmlNode* aPackage, const wxString& aPkgName );
+    FOOTPRINT* makeFootprint( wxXmlNode* aPackage, const wxString& aPkgName ) const;
 
     void packageWire( FOOTPRINT* aFootprint, wxXmlNode* aTree ) const;
-    void packagePad( FOOTPRINT* aFootprint, wxXmlNode* aTree );
+    void packagePad( FOOTPRINT* aFootprint, wxXmlNode* aTree ) const;
     void packageText( FOOTPRINT* aFootprint, wxXmlNode* aTree ) const;
     void packageRectangle( FOOTPRINT* aFootprint, wxXmlNode* aTree ) const;
     void packagePolygon( FOOTPRINT* aFootprint, wxXmlNode* aTree ) const;
@@ -306,6 +329,15 @@ private:
     ///< Deletes the footprint templates list
     void deleteTemplates();
 
+    /// A library package being converted to a footprint template.
+    struct PACKAGE_JOB
+    {
+        wxString                                m_key;      ///< key in m_templates
+        wxString                                m_name;
+        wxString                                m_libName;
+        std::future<std::unique_ptr<FOOTPRINT>> m_footprint;
+    };
+
     typedef std::vector<ELAYER>     ELAYERS;
     typedef ELAYERS::const_iterator EITER;
 
@@ -332,6 +364,8 @@ private:
                                     ///< lookup key is either libname.packagename or simply
                                     ///< packagename if FootprintLoad() or FootprintEnumberate()
 
+    std::vector<PACKAGE_JOB> m_packageJobs;  ///< packages not added to m_templates yet
+
     const STRING_UTF8_MAP*   m_props;    ///< passed via Save() or Load(), no ownership, may be NULL.
     BOARD*              m_board;    ///< which BOARD is being worked on, no ownership here
 
@@ -0,0 +1,275 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstdint>
+#include <functional>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <gestfich.h>
+#include <ki_exception.h>
+#include <paths.h>
+#include <trace_helpers.h>
+#include <plugins/kicad/fp_lib_snapshot.h>
+
+
+static const char     SNAPSHOT_MAGIC[8] = { 'K', 'I', 'F', 'P', 'S', 'N', 'A', 'P' };
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+
+/**
+ * Bounds-checked reader for the little-endian snapshot records.
+ */
+class SNAPSHOT_READER
+{
+public:
+    SNAPSHOT_READER( const std::string& aData ) :
+            m_data( aData ),
+            m_pos( 0 ),
+            m_ok( true )
+    { }
+
+    bool Ok() const { return m_ok; }
+
+    uint64_t ReadU64( int aBytes = 8 )
+    {
+        if( m_pos + aBytes > m_data.size() )
+        {
+            m_ok = false;
+            return 0;
+        }
+
+        uint64_t value = 0;
+
+        for( int i = 0; i < aBytes; ++i )
+            value |= uint64_t( uint8_t( m_data[m_pos + i] ) ) << ( 8 * i );
+
+        m_pos += aBytes;
+        return value;
+    }
+
+    uint32_t ReadU32() { return static_cast<uint32_t>( ReadU64( 4 ) ); }
+
+    std::string ReadString()
+    {
+        uint32_t len = ReadU32();
+
+        if( !m_ok || m_pos + len > m_data.size() )
+        {
+            m_ok = false;
+            return std::string();
+        }
+
+        std::string str = m_data.substr( m_pos, len );
+        m_pos += len;
+        return str;
+    }
+
+    wxString ReadWxString() { return wxString::FromUTF8( ReadString() ); }
+
+    bool ReadMagic()
+    {
+        if( m_data.size() < sizeof( SNAPSHOT_MAGIC )
+                || m_data.compare( 0, sizeof( SNAPSHOT_MAGIC ), SNAPSHOT_MAGIC,
+                                   sizeof( SNAPSHOT_MAGIC ) ) != 0 )
+        {
+            m_ok = false;
+            return false;
+        }
+
+        m_pos = sizeof( SNAPSHOT_MAGIC );
+        return true;
+    }
+
+private:
+    const std::string& m_data;
+    size_t             m_pos;
+    bool               m_ok;
+};
+
+
+static void writeU64( std::string& aOut, uint64_t aValue, int aBytes = 8 )
+{
+    for( int i = 0; i < aBytes; ++i )
+        aOut += static_cast<char>( ( aValue >> ( 8 * i ) ) & 0xFF );
+}
+
+
+static void writeString( std::string& aOut, const std::string& aValue )
+{
+    writeU64( aOut, aValue.size(), 4 );
+    aOut += aValue;
+}
+
+
+static void writeString( std::string& aOut, const wxString& aValue )
+{
+    writeString( aOut, std::string( aValue.utf8_str() ) );
+}
+
+
+FP_LIB_SNAPSHOT::FP_LIB_SNAPSHOT( const wxString& aLibraryPath ) :
+        m_libraryPath( aLibraryPath )
+{
+}
+
+
+wxString FP_LIB_SNAPSHOT::snapshotFileName() const
+{
+    wxFileName fn;
+    size_t     hash = std::hash<std::string>()( std::string( m_libraryPath.utf8_str() ) );
+
+    fn.AssignDir( PATHS::GetUserCachePath() );
+    fn.AppendDir( wxT( "footprint-snapshots" ) );
+    fn.SetName( wxString::Format( wxT( "%016llx" ), (unsigned long long) hash ) );
+    fn.SetExt( wxT( "fpsnap" ) );
+
+    return fn.GetFullPath();
+}
+
+
+bool FP_LIB_SNAPSHOT::StatFile( const wxString& aFullPath, long long& aTimestamp,
+                                long long& aSize )
+{
+    wxStructStat st;
+
+    if( wxStat( aFullPath, &st ) != 0 )
+        return false;
+
+    aTimestamp = static_cast<long long>( st.st_mtime );
+    aSize = static_cast<long long>( st.st_size );
+    return true;
+}
+
+
+bool FP_LIB_SNAPSHOT::Read()
+{
+    m_entries.clear();
+
+    wxString fileName = snapshotFileName();
+
+    if( !wxFileExists( fileName ) )
+        return false;
+
+    wxFFile     file( fileName, wxT( "rb" ) );
+    std::string data;
+
+    if( !file.IsOpened() )
+        return false;
+
+    wxFileOffset length = file.Length();
+
+    if( length < 0 )
+        return false;
+
+    data.resize( length );
+
+    if( !data.empty() && file.Read( &data[0], data.size() ) != data.size() )
+        return false;
+
+    SNAPSHOT_READER reader( data );
+
+    if( !reader.ReadMagic() || reader.ReadU32() != SNAPSHOT_VERSION )
+        return false;
+
+    if( reader.ReadWxString() != m_libraryPath )
+        return false;
+
+    uint32_t count = reader.ReadU32();
+
+    for( uint32_t ii = 0; ii < count && reader.Ok(); ++ii )
+    {
+        wxString name = reader.ReadWxString();
+        ENTRY    entry;
+
+        entry.m_timestamp = static_cast<long long>( reader.ReadU64() );
+        entry.m_size = static_cast<long long>( reader.ReadU64() );
+        entry.m_summary.m_description = reader.ReadWxString();
+        entry.m_summary.m_keywords = reader.ReadWxString();
+        entry.m_summary.m_padCount = reader.ReadU32();
+        entry.m_summary.m_uniquePadCount = reader.ReadU32();
+        entry.m_source = reader.ReadString();
+
+        m_entries[name] = std::move( entry );
+    }
+
+    if( !reader.Ok() )
+    {
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Discarding corrupt footprint snapshot '%s'." ),
+                    fileName );
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+void FP_LIB_SNAPSHOT::Write() const
+{
+    wxFileName  fn( snapshotFileName() );
+    std::string data;
+
+    if( !fn.DirExists() && !wxFileName::Mkdir( fn.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return;
+
+    data.append( SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) );
+    writeU64( data, SNAPSHOT_VERSION, 4 );
+    writeString( data, m_libraryPath );
+    writeU64( data, m_entries.size(), 4 );
+
+    for( const std::pair<const wxString, ENTRY>& pair : m_entries )
+    {
+        const ENTRY& entry = pair.second;
+
+        writeString( data, pair.first );
+        writeU64( data, static_cast<uint64_t>( entry.m_timestamp ) );
+        writeU64( data, static_cast<uint64_t>( entry.m_size ) );
+        writeString( data, entry.m_summary.m_description );
+        writeString( data, entry.m_summary.m_keywords );
+        writeU64( data, entry.m_summary.m_padCount, 4 );
+        writeU64( data, entry.m_summary.m_uniquePadCount, 4 );
+        writeString( data, entry.m_source );
+    }
+
+    try
+    {
+        KiWriteFileAtomically( fn.GetFullPath(), data );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Failed to write footprint snapshot '%s': %s" ),
+                    fn.GetFullPath(), ioe.What() );
+    }
+}
+
+
+FP_LIB_SNAPSHOT::ENTRY* FP_LIB_SNAPSHOT::Find( const wxString& aFileName )
+{
+    auto it = m_entries.find( aFileName );
+
+    return it == m_entries.end() ? nullptr : &it->second;
+}
@@ -0,0 +1,95 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef FP_LIB_SNAPSHOT_H
+#define FP_LIB_SNAPSHOT_H
+
+#include <map>
+#include <string>
+
+#include <io_mgr.h>      // FOOTPRINT_SUMMARY
+#include <wx/string.h>
+
+
+/**
+ * A binary snapshot of a .pretty footprint library, kept in the user cache directory.
+ *
+ * For every footprint file the snapshot records the file's modification time and size, the
+ * summary shown by the footprint browsers and the s-expression text of the footprint.  This
+ * lets #FP_CACHE enumerate a library and report footprint summaries without parsing anything,
+ * and parse individual footprints from memory when they are first used.  Entries are only
+ * trusted while the modification time and size of their file still match.
+ *
+ * The file is a flat sequence of little-endian, length-prefixed records which is read in one
+ * pass.
+ */
+class FP_LIB_SNAPSHOT
+{
+public:
+    struct ENTRY
+    {
+        long long         m_timestamp = 0;  ///< File modification time when it was read
+        long long         m_size = 0;       ///< File size when it was read
+        FOOTPRINT_SUMMARY m_summary;
+        std::string       m_source;         ///< s-expression text of the footprint file
+    };
+
+    FP_LIB_SNAPSHOT( const wxString& aLibraryPath );
+
+    /**
+     * Read the snapshot of the library from the cache directory.
+     *
+     * @return false if there is no snapshot or it could not be used, in which case the
+     *         snapshot is left empty.
+     */
+    bool Read();
+
+    /**
+     * Write the snapshot to the cache directory.  Failures are not fatal (the snapshot is
+     * only an optimization) and are only reported through the trace log.
+     */
+    void Write() const;
+
+    /**
+     * @return the entry for footprint file \a aFileName, or nullptr if there is none.
+     */
+    ENTRY* Find( const wxString& aFileName );
+
+    /**
+     * Read the modification time and size of a footprint file.
+     *
+     * @return false if the file could not be examined.
+     */
+    static bool StatFile( const wxString& aFullPath, long long& aTimestamp, long long& aSize );
+
+    /// Entries keyed by footprint file name (including the extension)
+    std::map<wxString, ENTRY>& Entries() { return m_entries; }
+
+private:
+    wxString snapshotFileName() const;
+
+    wxString                  m_libraryPath;
+    std::map<wxString, ENTRY> m_entries;
+};
+
+#endif // FP_LIB_SNAPSHOT_H
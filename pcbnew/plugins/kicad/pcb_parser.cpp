@@ -55,7 +55,6 @@
 #include <plugins/kicad/pcb_plugin.h>
 #include <pcb_plot_params_parser.h>
 #include <pcb_plot_params.h>
-#include <locale_io.h>
 #include <zones.h>
 #include <plugins/kicad/pcb_parser.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
@@ -682,7 +681,6 @@ BOARD_ITEM* PCB_PARSER::Parse()
 {
     T               token;
     BOARD_ITEM*     item;
-    LOCALE_IO       toggle;
 
     m_groupInfos.clear();
 
@@ -22,6 +22,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+
 #include <advanced_config.h>
 #include <base_units.h>
 #include <board.h>
@@ -46,13 +52,16 @@
 #include <pcb_text.h>
 #include <pcb_textbox.h>
 #include <pcbnew_settings.h>
+#include <plugins/kicad/fp_lib_snapshot.h>
 #include <plugins/kicad/pcb_plugin.h>
 #include <plugins/kicad/pcb_parser.h>
 #include <trace_helpers.h>
 #include <pcb_track.h>
 #include <progress_reporter.h>
+#include <thread_pool.h>
 #include <wildcards_and_files_ext.h>
 #include <wx/dir.h>
+#include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx_filename.h>
 #include <zone.h>
@@ -78,23 +87,94 @@ using namespace PCB_KEYS_T;
  */
 class FP_CACHE_ITEM
 {
-    WX_FILENAME                m_filename;
-    std::unique_ptr<FOOTPRINT> m_footprint;
+    WX_FILENAME                        m_filename;
+    mutable std::unique_ptr<FOOTPRINT> m_footprint;
+    mutable std::string                m_source;    // Snapshot text, parsed on first use
+    mutable std::mutex                 m_mutex;
+    FOOTPRINT_SUMMARY                  m_summary;
 
 public:
     FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
+    /**
+     * Create an item which is only parsed from \a aSource when the footprint is first needed.
+     */
+    FP_CACHE_ITEM( const WX_FILENAME& aFileName, std::string&& aSource,
+                   const FOOTPRINT_SUMMARY& aSummary );
+
     const WX_FILENAME& GetFileName() const { return m_filename; }
-    const FOOTPRINT* GetFootprint()  const { return m_footprint.get(); }
+    const FOOTPRINT* GetFootprint() const;
+    const FOOTPRINT_SUMMARY& GetSummary() const { return m_summary; }
+
+    /**
+     * @return true if \a aFootprint is the footprint held by this item.  Never causes a parse.
+     */
+    bool Holds( const FOOTPRINT* aFootprint ) const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_footprint.get() == aFootprint;
+    }
 };
 
 
+static FOOTPRINT_SUMMARY summarize( const FOOTPRINT* aFootprint )
+{
+    FOOTPRINT_SUMMARY summary;
+
+    summary.m_description = aFootprint->GetDescription();
+    summary.m_keywords = aFootprint->GetKeywords();
+    summary.m_padCount = aFootprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
+    summary.m_uniquePadCount = aFootprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+
+    return summary;
+}
+
+
 FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
         m_filename( aFileName ),
         m_footprint( aFootprint )
+{
+    if( aFootprint )
+        m_summary = summarize( aFootprint );
+}
+
+
+FP_CACHE_ITEM::FP_CACHE_ITEM( const WX_FILENAME& aFileName, std::string&& aSource,
+                              const FOOTPRINT_SUMMARY& aSummary ) :
+        m_filename( aFileName ),
+        m_source( std::move( aSource ) ),
+        m_summary( aSummary )
 { }
 
 
+const FOOTPRINT* FP_CACHE_ITEM::GetFootprint() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_footprint && !m_source.empty() )
+    {
+        try
+        {
+            STRING_LINE_READER reader( m_source, m_filename.GetFullPath() );
+            PCB_PARSER         parser( &reader, nullptr, nullptr );
+
+            m_footprint.reset( (FOOTPRINT*) parser.Parse() );
+            m_footprint->SetFPID( LIB_ID( wxEmptyString, m_filename.GetName() ) );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxLogTrace( traceKicadPcbPlugin, wxT( "Error parsing snapshot of '%s': %s" ),
+                        m_filename.GetFullPath(), ioe.What() );
+        }
+
+        // Parsed or not, the text isn't needed any more
+        std::string().swap( m_source );
+    }
+
+    return m_footprint.get();
+}
+
+
 typedef boost::ptr_map< wxString, FP_CACHE_ITEM >   FOOTPRINT_MAP;
 
 
@@ -191,7 +271,7 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
 
     for( FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        if( aFootprint && aFootprint != it->second->GetFootprint() )
+        if( aFootprint && !it->second->Holds( aFootprint ) )
             continue;
 
         WX_FILENAME fn = it->second->GetFileName();
@@ -254,47 +334,211 @@ void FP_CACHE::Load()
         THROW_IO_ERROR( msg );
     }
 
-    wxString fullName;
-    wxString fileSpec = wxT( "*." ) + KiCadFootprintFileExtension;
+    wxString              fullName;
+    wxString              fileSpec = wxT( "*." ) + KiCadFootprintFileExtension;
+    std::vector<wxString> fileNames;
+
+    if( !dir.GetFirst( &fullName, fileSpec ) )
+        return;
+
+    do
+    {
+        fileNames.push_back( fullName );
+    } while( dir.GetNext( &fullName ) );
+
+    // Sort so that the merged results and error messages don't depend on the order the
+    // directory was read in or on which thread finished first.
+    std::sort( fileNames.begin(), fileNames.end() );
+
+    // Footprints whose file hasn't changed since the last snapshot are taken from it and only
+    // parsed when first used.  Everything else gets parsed now.
+    FP_LIB_SNAPSHOT snapshot( m_lib_raw_path );
+    bool            snapshotDirty = !snapshot.Read();
+
+    // The parse state is shared with the thread pool through a shared_ptr.  Helper tasks that
+    // haven't started by the time we have claimed all the files are skipped, so we only ever
+    // wait for helpers that are actually running, never for one to be scheduled (this may
+    // itself be running on a pool thread when called from FOOTPRINT_LIST_IMPL).
+    struct PARSE_STATE
+    {
+        std::vector<wxString>                   m_paths;
+        std::vector<FP_LIB_SNAPSHOT::ENTRY>     m_entries;
+        std::vector<std::unique_ptr<FOOTPRINT>> m_footprints;
+        std::vector<wxString>                   m_errors;
+        std::vector<size_t>                     m_toParse;
+        std::atomic<size_t>                     m_next{ 0 };
+        std::vector<std::atomic<int>>           m_helperState;  ///< HELPER_PENDING etc.
+    };
+
+    enum HELPER_STATE { HELPER_PENDING, HELPER_RUNNING, HELPER_SKIPPED };
+
+    auto              state = std::make_shared<PARSE_STATE>();
+    std::vector<bool> fromSnapshot( fileNames.size(), false );
 
     // wxFileName construction is egregiously slow.  Construct it once and just swap out
     // the filename thereafter.
     WX_FILENAME fn( m_lib_raw_path, wxT( "dummyName" ) );
 
-    if( dir.GetFirst( &fullName, fileSpec ) )
+    state->m_entries.resize( fileNames.size() );
+    state->m_footprints.resize( fileNames.size() );
+    state->m_errors.resize( fileNames.size() );
+
+    for( size_t ii = 0; ii < fileNames.size(); ++ii )
     {
-        wxString cacheError;
+        fn.SetFullName( fileNames[ii] );
+        state->m_paths.push_back( fn.GetFullPath() );
 
-        do
-        {
-            fn.SetFullName( fullName );
+        FP_LIB_SNAPSHOT::ENTRY& entry = state->m_entries[ii];
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
-            {
-                FILE_LINE_READER reader( fn.GetFullPath() );
-                PCB_PARSER       parser( &reader, nullptr, nullptr );
+        FP_LIB_SNAPSHOT::StatFile( state->m_paths[ii], entry.m_timestamp, entry.m_size );
 
-                FOOTPRINT* footprint = (FOOTPRINT*) parser.Parse();
-                wxString   fpName = fn.GetName();
+        FP_LIB_SNAPSHOT::ENTRY* cached = snapshot.Find( fileNames[ii] );
 
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
-            }
-            catch( const IO_ERROR& ioe )
+        if( cached && cached->m_timestamp == entry.m_timestamp && cached->m_size == entry.m_size )
+            fromSnapshot[ii] = true;
+        else
+            state->m_toParse.push_back( ii );
+    }
+
+    auto parseFiles =
+            []( const std::shared_ptr<PARSE_STATE>& aState )
             {
-                if( !cacheError.IsEmpty() )
-                    cacheError += wxT( "\n\n" );
+                for( size_t next = aState->m_next++; next < aState->m_toParse.size();
+                     next = aState->m_next++ )
+                {
+                    size_t                  ii = aState->m_toParse[next];
+                    FP_LIB_SNAPSHOT::ENTRY& entry = aState->m_entries[ii];
+
+                    // Queue I/O errors so only files that fail to parse don't get loaded.
+                    try
+                    {
+                        wxFFile      file( aState->m_paths[ii], wxT( "rb" ) );
+                        wxFileOffset length = file.IsOpened() ? file.Length() : -1;
+
+                        if( length >= 0 )
+                            entry.m_source.resize( length );
+
+                        if( length < 0
+                                || file.Read( &entry.m_source[0], entry.m_source.size() )
+                                           != entry.m_source.size() )
+                        {
+                            THROW_IO_ERROR( wxString::Format( _( "Cannot read file '%s'." ),
+                                                              aState->m_paths[ii] ) );
+                        }
+
+                        STRING_LINE_READER reader( entry.m_source, aState->m_paths[ii] );
+                        PCB_PARSER         parser( &reader, nullptr, nullptr );
+
+                        aState->m_footprints[ii].reset( (FOOTPRINT*) parser.Parse() );
+                        entry.m_summary = summarize( aState->m_footprints[ii].get() );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        aState->m_errors[ii] = ioe.What();
+                    }
+                }
+            };
 
-                cacheError += ioe.What();
-            }
-        } while( dir.GetNext( &fullName ) );
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       helpers = std::min<size_t>( tp.get_thread_count(), state->m_toParse.size() / 4 );
+
+    std::vector<std::future<void>> helperResults;
+
+    state->m_helperState = std::vector<std::atomic<int>>( helpers );
+
+    for( size_t ii = 0; ii < helpers; ++ii )
+    {
+        state->m_helperState[ii] = HELPER_PENDING;
+
+        helperResults.push_back( tp.submit(
+                [state, ii, parseFiles]()
+                {
+                    int expected = HELPER_PENDING;
 
-        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+                    if( state->m_helperState[ii].compare_exchange_strong( expected,
+                                                                          HELPER_RUNNING ) )
+                    {
+                        parseFiles( state );
+                    }
+                } ) );
+    }
+
+    // Take part in the parsing ourselves, then wait for the helpers still parsing files
+    parseFiles( state );
+
+    for( size_t ii = 0; ii < helpers; ++ii )
+    {
+        int expected = HELPER_PENDING;
 
-        if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
+        if( !state->m_helperState[ii].compare_exchange_strong( expected, HELPER_SKIPPED ) )
+            helperResults[ii].get();
     }
+
+    // Bring the snapshot up to date with what is on disk
+    std::map<wxString, FP_LIB_SNAPSHOT::ENTRY>& entries = snapshot.Entries();
+
+    for( auto it = entries.begin(); it != entries.end(); )
+    {
+        if( !std::binary_search( fileNames.begin(), fileNames.end(), it->first ) )
+        {
+            it = entries.erase( it );
+            snapshotDirty = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for( size_t ii : state->m_toParse )
+    {
+        if( state->m_footprints[ii] )
+        {
+            entries[fileNames[ii]] = std::move( state->m_entries[ii] );
+            snapshotDirty = true;
+        }
+        else if( entries.erase( fileNames[ii] ) )
+        {
+            snapshotDirty = true;
+        }
+    }
+
+    if( snapshotDirty )
+        snapshot.Write();
+
+    wxString cacheError;
+
+    for( size_t ii = 0; ii < fileNames.size(); ++ii )
+    {
+        fn.SetFullName( fileNames[ii] );
+
+        wxString fpName = fn.GetName();
+
+        if( fromSnapshot[ii] )
+        {
+            FP_LIB_SNAPSHOT::ENTRY* entry = snapshot.Find( fileNames[ii] );
+
+            m_footprints.insert( fpName, new FP_CACHE_ITEM( fn, std::move( entry->m_source ),
+                                                            entry->m_summary ) );
+        }
+        else if( FOOTPRINT* footprint = state->m_footprints[ii].release() )
+        {
+            footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
+            m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
+        }
+        else if( !state->m_errors[ii].IsEmpty() )
+        {
+            if( !cacheError.IsEmpty() )
+                cacheError += wxT( "\n\n" );
+
+            cacheError += state->m_errors[ii];
+        }
+    }
+
+    m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+
+    if( !cacheError.IsEmpty() )
+        THROW_IO_ERROR( cacheError );
 }
 
 
@@ -357,6 +601,17 @@ void PCB_PLUGIN::Save( const wxString& aFileName, BOARD* aBoard, const STRING_UT
         }
     }
 
+    FILE_OUTPUTFORMATTER    formatter( aFileName );
+
+    FormatBoard( aBoard, &formatter, aProperties );
+}
+
+
+void PCB_PLUGIN::FormatBoard( BOARD* aBoard, OUTPUTFORMATTER* aFormatter,
+                              const STRING_UTF8_MAP* aProperties )
+{
+    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
+
     init( aProperties );
 
     m_board = aBoard;       // after init()
@@ -364,9 +619,7 @@ void PCB_PLUGIN::Save( const wxString& aFileName, BOARD* aBoard, const STRING_UT
     // Prepare net mapping that assures that net codes saved in a file are consecutive integers
     m_mapping->SetBoard( aBoard );
 
-    FILE_OUTPUTFORMATTER    formatter( aFileName );
-
-    m_out = &formatter;     // no ownership
+    m_out = aFormatter;     // no ownership
 
     m_out->Print( 0, "(kicad_pcb (version %d) (generator pcbnew)\n", SEXPR_BOARD_FILE_VERSION );
 
@@ -2589,6 +2842,36 @@ const FOOTPRINT* PCB_PLUGIN::GetEnumeratedFootprint( const wxString& aLibraryPat
 }
 
 
+bool PCB_PLUGIN::GetFootprintSummary( const wxString& aLibraryPath,
+                                      const wxString& aFootprintName,
+                                      FOOTPRINT_SUMMARY& aSummary,
+                                      const STRING_UTF8_MAP* aProperties )
+{
+    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    try
+    {
+        validateCache( aLibraryPath, false );
+    }
+    catch( const IO_ERROR& )
+    {
+        // do nothing with the error
+    }
+
+    FOOTPRINT_MAP& footprints = m_cache->GetFootprints();
+    FOOTPRINT_MAP::const_iterator it = footprints.find( aFootprintName );
+
+    if( it == footprints.end() )
+        return false;
+
+    // Served from the library snapshot when possible, so this doesn't parse the footprint
+    aSummary = it->second->GetSummary();
+    return true;
+}
+
+
 bool PCB_PLUGIN::FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                                   const STRING_UTF8_MAP* aProperties )
 {
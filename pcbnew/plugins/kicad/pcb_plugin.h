@@ -206,6 +206,10 @@ public:
                                              const wxString& aFootprintName,
                                              const STRING_UTF8_MAP* aProperties = nullptr ) override;
 
+    bool GetFootprintSummary( const wxString& aLibraryPath, const wxString& aFootprintName,
+                              FOOTPRINT_SUMMARY& aSummary,
+                              const STRING_UTF8_MAP* aProperties = nullptr ) override;
+
     bool FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                           const STRING_UTF8_MAP* aProperties = nullptr ) override;
 
@@ -242,6 +246,17 @@ public:
      */
     void Format( const BOARD_ITEM* aItem, int aNestLevel = 0 ) const;
 
+    /**
+     * Output \a aBoard as a complete board file to \a aFormatter.
+     *
+     * Unlike Save(), this does not create any file and does not run the group sanity check,
+     * so it can be used to take an in-memory snapshot of the board.
+     *
+     * @throw IO_ERROR on write error.
+     */
+    void FormatBoard( BOARD* aBoard, OUTPUTFORMATTER* aFormatter,
+                      const STRING_UTF8_MAP* aProperties = nullptr );
+
     std::string GetStringOutput( bool doClear )
     {
         std::string ret = m_sf.GetString();
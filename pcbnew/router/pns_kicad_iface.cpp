@@ -68,6 +68,7 @@
 #include "pns_node.h"
 #include "pns_router.h"
 #include "pns_debug_decorator.h"
+#include "pns_stats.h"
 #include "router_preview_item.h"
 
 typedef VECTOR2I::extended_type ecoord;
@@ -85,6 +86,59 @@ struct CLEARANCE_CACHE_KEY
     }
 };
 
+/**
+ * The attributes of an item the design rules can depend on.
+ *
+ * Items coming from the board are evaluated through their parent, which holds the netclass,
+ * the parent footprint and the local overrides.  Items created by the router have no parent
+ * and are evaluated as a track, arc or via of their net, so all the items of the same kind,
+ * net and layers share the same clearances.
+ */
+struct CLEARANCE_RULE_ITEM
+{
+    const BOARD_ITEM* Parent;
+    int               Kind;
+    int               Net;
+    int               LayerStart;
+    int               LayerEnd;
+
+    bool operator==(const CLEARANCE_RULE_ITEM& other) const
+    {
+        return Parent == other.Parent && Kind == other.Kind && Net == other.Net
+                && LayerStart == other.LayerStart && LayerEnd == other.LayerEnd;
+    }
+};
+
+
+struct CLEARANCE_RULE_CACHE_KEY
+{
+    CLEARANCE_RULE_ITEM A;
+    CLEARANCE_RULE_ITEM B;
+    bool                Flag;
+
+    bool operator==(const CLEARANCE_RULE_CACHE_KEY& other) const
+    {
+        return A == other.A && B == other.B && Flag == other.Flag;
+    }
+};
+
+
+static CLEARANCE_RULE_ITEM clearanceRuleItem( const PNS::ITEM* aItem )
+{
+    if( !aItem )
+        return { nullptr, 0, 0, 0, 0 };
+
+    int kind = aItem->Kind();
+
+    // Lines and segments are both evaluated as a track
+    if( kind == PNS::ITEM::LINE_T )
+        kind = PNS::ITEM::SEGMENT_T;
+
+    return { aItem->Parent(), kind, aItem->Net(), aItem->Layers().Start(),
+             aItem->Layers().End() };
+}
+
+
 namespace std
 {
     template <>
@@ -95,6 +149,32 @@ namespace std
             return hash<const void*>()( k.A ) ^ hash<const void*>()( k.B ) ^ hash<int>()( k.Flag );
         }
     };
+
+    template <>
+    struct hash<CLEARANCE_RULE_CACHE_KEY>
+    {
+        std::size_t operator()( const CLEARANCE_RULE_CACHE_KEY& k ) const
+        {
+            std::size_t seed = hash<int>()( k.Flag );
+
+            auto combine =
+                    [&]( std::size_t aHash )
+                    {
+                        seed ^= aHash + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+                    };
+
+            for( const CLEARANCE_RULE_ITEM& item : { k.A, k.B } )
+            {
+                combine( hash<const void*>()( item.Parent ) );
+                combine( hash<int>()( item.Kind ) );
+                combine( hash<int>()( item.Net ) );
+                combine( hash<int>()( item.LayerStart ) );
+                combine( hash<int>()( item.LayerEnd ) );
+            }
+
+            return seed;
+        }
+    };
 }
 
 
@@ -132,6 +212,16 @@ public:
 private:
     int holeRadius( const PNS::ITEM* aItem ) const;
 
+    /**
+     * Look for a clearance in the cache of the items, then in the one of the rule attributes.
+     *
+     * @return true if found, the clearance being stored in \a aValue.
+     */
+    bool findCachedClearance( std::unordered_map<CLEARANCE_CACHE_KEY, int>& aItemCache,
+                              std::unordered_map<CLEARANCE_RULE_CACHE_KEY, int>& aRuleCache,
+                              const CLEARANCE_CACHE_KEY& aKey,
+                              const CLEARANCE_RULE_CACHE_KEY& aRuleKey, int& aValue );
+
     /**
      * Checks for netnamed differential pairs.
      * This accepts nets named suffixed by 'P', 'N', '+', '-', as well as additional
@@ -154,6 +244,11 @@ private:
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_clearanceCache;
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_holeClearanceCache;
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_holeToHoleClearanceCache;
+
+    // Second level caches, shared by the items with the same rule attributes
+    std::unordered_map<CLEARANCE_RULE_CACHE_KEY, int> m_clearanceRuleCache;
+    std::unordered_map<CLEARANCE_RULE_CACHE_KEY, int> m_holeClearanceRuleCache;
+    std::unordered_map<CLEARANCE_RULE_CACHE_KEY, int> m_holeToHoleClearanceRuleCache;
 };
 
 
@@ -377,17 +472,48 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItem( const PNS::ITEM* aItem )
 }
 
 
+bool PNS_PCBNEW_RULE_RESOLVER::findCachedClearance(
+        std::unordered_map<CLEARANCE_CACHE_KEY, int>& aItemCache,
+        std::unordered_map<CLEARANCE_RULE_CACHE_KEY, int>& aRuleCache,
+        const CLEARANCE_CACHE_KEY& aKey, const CLEARANCE_RULE_CACHE_KEY& aRuleKey, int& aValue )
+{
+    PNS::Stats().m_clearanceQueries++;
+
+    auto it = aItemCache.find( aKey );
+
+    if( it != aItemCache.end() )
+    {
+        PNS::Stats().m_clearanceItemHits++;
+        aValue = it->second;
+        return true;
+    }
+
+    // The router creates new items all the time, they are found here from the first query
+    auto ruleIt = aRuleCache.find( aRuleKey );
+
+    if( ruleIt != aRuleCache.end() )
+    {
+        PNS::Stats().m_clearanceRuleHits++;
+        aValue = ruleIt->second;
+        return true;
+    }
+
+    return false;
+}
+
+
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                          bool aUseClearanceEpsilon )
 {
-    CLEARANCE_CACHE_KEY key = { aA, aB, aUseClearanceEpsilon };
-    auto it = m_clearanceCache.find( key );
+    CLEARANCE_CACHE_KEY      key = { aA, aB, aUseClearanceEpsilon };
+    CLEARANCE_RULE_CACHE_KEY ruleKey = { clearanceRuleItem( aA ), clearanceRuleItem( aB ),
+                                         aUseClearanceEpsilon };
+    int                      rv = 0;
 
-    if( it != m_clearanceCache.end() )
-        return it->second;
+    if( findCachedClearance( m_clearanceCache, m_clearanceRuleCache, key, ruleKey, rv ) )
+        return rv;
 
     PNS::CONSTRAINT constraint;
-    int             rv = 0;
     LAYER_RANGE     layers;
 
     if( !aB )
@@ -427,6 +553,7 @@ int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* a
         rv -= m_clearanceEpsilon;
 
     m_clearanceCache[ key ] = rv;
+    m_clearanceRuleCache[ ruleKey ] = rv;
     return rv;
 }
 
@@ -434,14 +561,15 @@ int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* a
 int PNS_PCBNEW_RULE_RESOLVER::HoleClearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                              bool aUseClearanceEpsilon )
 {
-    CLEARANCE_CACHE_KEY key = { aA, aB, aUseClearanceEpsilon };
-    auto it = m_holeClearanceCache.find( key );
+    CLEARANCE_CACHE_KEY      key = { aA, aB, aUseClearanceEpsilon };
+    CLEARANCE_RULE_CACHE_KEY ruleKey = { clearanceRuleItem( aA ), clearanceRuleItem( aB ),
+                                         aUseClearanceEpsilon };
+    int                      rv = 0;
 
-    if( it != m_holeClearanceCache.end() )
-        return it->second;
+    if( findCachedClearance( m_holeClearanceCache, m_holeClearanceRuleCache, key, ruleKey, rv ) )
+        return rv;
 
     PNS::CONSTRAINT constraint;
-    int rv = 0;
     int layer;
 
     if( !aA->Layers().IsMultilayer() || !aB || aB->Layers().IsMultilayer() )
@@ -456,6 +584,7 @@ int PNS_PCBNEW_RULE_RESOLVER::HoleClearance( const PNS::ITEM* aA, const PNS::ITE
         rv -= m_clearanceEpsilon;
 
     m_holeClearanceCache[ key ] = rv;
+    m_holeClearanceRuleCache[ ruleKey ] = rv;
     return rv;
 }
 
@@ -463,14 +592,18 @@ int PNS_PCBNEW_RULE_RESOLVER::HoleClearance( const PNS::ITEM* aA, const PNS::ITE
 int PNS_PCBNEW_RULE_RESOLVER::HoleToHoleClearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                                    bool aUseClearanceEpsilon )
 {
-    CLEARANCE_CACHE_KEY key = { aA, aB, aUseClearanceEpsilon };
-    auto it = m_holeToHoleClearanceCache.find( key );
+    CLEARANCE_CACHE_KEY      key = { aA, aB, aUseClearanceEpsilon };
+    CLEARANCE_RULE_CACHE_KEY ruleKey = { clearanceRuleItem( aA ), clearanceRuleItem( aB ),
+                                         aUseClearanceEpsilon };
+    int                      rv = 0;
 
-    if( it != m_holeToHoleClearanceCache.end() )
-        return it->second;
+    if( findCachedClearance( m_holeToHoleClearanceCache, m_holeToHoleClearanceRuleCache, key,
+                             ruleKey, rv ) )
+    {
+        return rv;
+    }
 
     PNS::CONSTRAINT constraint;
-    int rv = 0;
     int layer;
 
     if( !aA->Layers().IsMultilayer() || !aB || aB->Layers().IsMultilayer() )
@@ -485,6 +618,7 @@ int PNS_PCBNEW_RULE_RESOLVER::HoleToHoleClearance( const PNS::ITEM* aA, const PN
         rv -= m_clearanceEpsilon;
 
     m_holeToHoleClearanceCache[ key ] = rv;
+    m_holeToHoleClearanceRuleCache[ ruleKey ] = rv;
     return rv;
 }
 
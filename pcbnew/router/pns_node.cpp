@@ -42,6 +42,7 @@
 #include "pns_index.h"
 #include "pns_debug_decorator.h"
 #include "pns_router.h"
+#include "pns_stats.h"
 #include "pns_utils.h"
 
 
@@ -140,6 +141,8 @@ NODE* NODE::Branch()
 {
     NODE* child = new NODE;
 
+    Stats().m_branches++;
+
     m_children.insert( child );
 
     child->m_depth = m_depth + 1;
@@ -149,18 +152,8 @@ NODE* NODE::Branch()
     child->m_maxClearance = m_maxClearance;
     child->m_collisionQueryScope = m_collisionQueryScope;
 
-    // Immediate offspring of the root branch needs not copy anything. For the rest, deep-copy
-    // joints, overridden item maps and pointers to stored items.
-    if( !isRoot() )
-    {
-        JOINT_MAP::iterator j;
-
-        for( ITEM* item : *m_index )
-            child->m_index->Add( item );
-
-        child->m_joints = m_joints;
-        child->m_override = m_override;
-    }
+    // Nothing is copied: the items, overrides and joints of the parents are looked up through
+    // the chain of parents, so the branch only stores its own changes.
 
 #if 0
     wxLogTrace( wxT( "PNS" ), wxT( "%d items, %d joints, %d overrides" ),
@@ -197,6 +190,19 @@ void OBSTACLE_VISITOR::SetWorld( const NODE* aNode, const NODE* aOverride )
 }
 
 
+bool NODE::Overrides( ITEM* aItem ) const
+{
+    // Only the nodes between this one and the owner of the item can have changed it
+    for( const NODE* node = this; node && aItem->Owner() != node; node = node->m_parent )
+    {
+        if( !node->m_override.empty() && node->m_override.count( aItem ) )
+            return true;
+    }
+
+    return false;
+}
+
+
 bool OBSTACLE_VISITOR::visit( ITEM* aCandidate )
 {
     // check if there is a more recent branch with a newer (possibly modified) version of this
@@ -271,6 +277,8 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
 int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles, int aKindMask,
                           int aLimitCount, bool aDifferentNetsOnly, int aOverrideClearance )
 {
+    Stats().m_collisionQueries++;
+
     /// By default, virtual items cannot collide
     if( aItem->IsVirtual() )
         return 0;
@@ -282,16 +290,20 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles, int aK
 #endif
 
     visitor.SetCountLimit( aLimitCount );
-    visitor.SetWorld( this, nullptr );
 
-    // first, look for colliding items in the local index
-    m_index->Query( aItem, m_maxClearance, visitor );
-
-    // if we haven't found enough items, look in the root branch as well.
-    if( !isRoot() && ( visitor.m_matchCount < aLimitCount || aLimitCount < 0 ) )
+    // first, look for colliding items in the local index, then in the parents' ones if we
+    // haven't found enough items. Items changed since in this branch are skipped.
+    for( const NODE* node = this; node; node = node->m_parent )
     {
-        visitor.SetWorld( m_root, this );
-        m_root->m_index->Query( aItem, m_maxClearance, visitor );
+        if( node != this && aLimitCount >= 0 && visitor.m_matchCount >= aLimitCount )
+            break;
+
+        if( node == this )
+            visitor.SetWorld( this, nullptr );
+        else
+            visitor.SetWorld( node->isRoot() ? m_root : this, this );
+
+        node->m_index->Query( aItem, m_maxClearance, visitor );
     }
 
     return aObstacles.size();
@@ -543,14 +555,13 @@ const ITEM_SET NODE::HitTest( const VECTOR2I& aPoint ) const
 
     m_index->Query( &s, m_maxClearance, visitor );
 
-    if( !isRoot() )    // fixme: could be made cleaner
+    for( const NODE* node = m_parent; node; node = node->m_parent )
     {
-        ITEM_SET items_root;
-        visitor.SetWorld( m_root, nullptr );
-        HIT_VISITOR  visitor_root( items_root, aPoint );
-        m_root->m_index->Query( &s, m_maxClearance, visitor_root );
+        ITEM_SET    items_parent;
+        HIT_VISITOR visitor_parent( items_parent, aPoint );
+        node->m_index->Query( &s, m_maxClearance, visitor_parent );
 
-        for( ITEM* item : items_root.Items() )
+        for( ITEM* item : items_parent.Items() )
         {
             if( !Overrides( item ) )
                 items.Add( item );
@@ -737,14 +748,13 @@ bool NODE::QueryEdgeExclusions( const VECTOR2I& aPos ) const
 
 void NODE::doRemove( ITEM* aItem )
 {
-    // case 1: removing an item that is stored in the root node from any branch:
+    // case 1: removing an item that is stored in a parent node from any branch:
     // mark it as overridden, but do not remove
-    if( aItem->BelongsTo( m_root ) && !isRoot() )
+    if( !aItem->BelongsTo( this ) && !isRoot() )
         m_override.insert( aItem );
 
-    // case 2: the item belongs to this branch or a parent, non-root branch,
-    // or the root itself and we are the root: remove from the index
-    else if( !aItem->BelongsTo( m_root ) || isRoot() )
+    // case 2: the item belongs to this branch, or we are the root: remove from the index
+    else
         m_index->Remove( aItem );
 
     // the item belongs to this particular branch: un-reference it
@@ -783,6 +793,20 @@ void NODE::rebuildJoint( JOINT* aJoint, ITEM* aItem )
     tag.net = net;
     tag.pos = aJoint->Pos();
 
+    // the joints may still be the ones of a parent branch: change a copy of them
+    if( !isRoot() && m_joints.find( tag ) == m_joints.end() )
+    {
+        JOINT_MAP& joints = jointMapFor( tag );
+
+        if( &joints != &m_root->m_joints )
+        {
+            auto range = joints.equal_range( tag );
+
+            for( auto f = range.first; f != range.second; ++f )
+                m_joints.insert( *f );
+        }
+    }
+
     bool split;
 
     do
@@ -806,6 +830,9 @@ void NODE::rebuildJoint( JOINT* aJoint, ITEM* aItem )
         }
     } while( split );
 
+    if( !isRoot() && m_joints.find( tag ) == m_joints.end() )
+        m_clearedJoints.insert( tag );
+
     // and re-link them, using the former via's link list
     for( ITEM* link : links )
     {
@@ -1185,13 +1212,8 @@ JOINT* NODE::FindJoint( const VECTOR2I& aPos, int aLayer, int aNet )
     tag.net = aNet;
     tag.pos = aPos;
 
-    JOINT_MAP::iterator f = m_joints.find( tag ), end = m_joints.end();
-
-    if( f == end && !isRoot() )
-    {
-        end = m_root->m_joints.end();
-        f = m_root->m_joints.find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
-    }
+    JOINT_MAP& joints = jointMapFor( tag );
+    JOINT_MAP::iterator f = joints.find( tag ), end = joints.end();
 
     if( f == end )
         return nullptr;
@@ -1215,6 +1237,21 @@ void NODE::LockJoint( const VECTOR2I& aPos, const ITEM* aItem, bool aLock )
 }
 
 
+NODE::JOINT_MAP& NODE::jointMapFor( const JOINT::HASH_TAG& aTag )
+{
+    for( NODE* node = this; !node->isRoot(); node = node->m_parent )
+    {
+        if( node->m_joints.find( aTag ) != node->m_joints.end() )
+            return node->m_joints;
+
+        if( node->m_clearedJoints.count( aTag ) )
+            break;
+    }
+
+    return m_root->m_joints;
+}
+
+
 JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int aNet )
 {
     JOINT::HASH_TAG tag;
@@ -1227,10 +1264,10 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int a
 
     std::pair<JOINT_MAP::iterator, JOINT_MAP::iterator> range;
 
-    // not found and we are not root? find in the root and copy results here.
+    // not found and we are not root? find in the parents or the root and copy results here.
     if( f == m_joints.end() && !isRoot() )
     {
-        range = m_root->m_joints.equal_range( tag );
+        range = jointMapFor( tag ).equal_range( tag );
 
         for( f = range.first; f != range.second; ++f )
             m_joints.insert( *f );
@@ -1381,22 +1418,45 @@ void NODE::Dump( bool aLong )
 }
 
 
-void NODE::GetUpdatedItems( ITEM_VECTOR& aRemoved, ITEM_VECTOR& aAdded )
+void NODE::getBranchItems( ITEM_VECTOR& aItems ) const
 {
     if( isRoot() )
+    {
+        aItems.insert( aItems.end(), m_index->begin(), m_index->end() );
         return;
+    }
 
-    if( m_override.size() )
-        aRemoved.reserve( m_override.size() );
+    for( const NODE* node = this; !node->isRoot(); node = node->m_parent )
+    {
+        for( ITEM* item : *node->m_index )
+        {
+            if( node == this || !Overrides( item ) )
+                aItems.push_back( item );
+        }
+    }
+}
+
+
+void NODE::getOverriddenRootItems( ITEM_VECTOR& aItems ) const
+{
+    for( const NODE* node = this; !node->isRoot(); node = node->m_parent )
+    {
+        for( ITEM* item : node->m_override )
+        {
+            if( item->BelongsTo( m_root ) )
+                aItems.push_back( item );
+        }
+    }
+}
 
-    if( m_index->Size() )
-        aAdded.reserve( m_index->Size() );
 
-    for( ITEM* item : m_override )
-        aRemoved.push_back( item );
+void NODE::GetUpdatedItems( ITEM_VECTOR& aRemoved, ITEM_VECTOR& aAdded )
+{
+    if( isRoot() )
+        return;
 
-    for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
-        aAdded.push_back( *i );
+    getOverriddenRootItems( aRemoved );
+    getBranchItems( aAdded );
 }
 
 
@@ -1433,10 +1493,14 @@ void NODE::Commit( NODE* aNode )
     if( aNode->isRoot() )
         return;
 
-    for( ITEM* item : aNode->m_override )
+    ITEM_VECTOR removed, added;
+
+    aNode->GetUpdatedItems( removed, added );
+
+    for( ITEM* item : removed )
         Remove( item );
 
-    for( ITEM* item : *aNode->m_index )
+    for( ITEM* item : added )
     {
         item->SetRank( -1 );
         item->Unmark();
@@ -1467,13 +1531,13 @@ void NODE::AllItemsInNet( int aNet, std::set<ITEM*>& aItems, int aKindMask )
         }
     }
 
-    if( !isRoot() )
+    for( NODE* node = m_parent; node; node = node->m_parent )
     {
-        INDEX::NET_ITEMS_LIST* l_root = m_root->m_index->GetItemsForNet( aNet );
+        INDEX::NET_ITEMS_LIST* l_parent = node->m_index->GetItemsForNet( aNet );
 
-        if( l_root )
+        if( l_parent )
         {
-            for( ITEM* item : *l_root )
+            for( ITEM* item : *l_parent )
             {
                 if( !Overrides( item ) && item->OfKind( aKindMask ) && item->IsRoutable() )
                     aItems.insert( item );
@@ -1485,7 +1549,11 @@ void NODE::AllItemsInNet( int aNet, std::set<ITEM*>& aItems, int aKindMask )
 
 void NODE::ClearRanks( int aMarkerMask )
 {
-    for( ITEM* item : *m_index )
+    ITEM_VECTOR items;
+
+    getBranchItems( items );
+
+    for( ITEM* item : items )
     {
         item->SetRank( -1 );
         item->Mark( item->Marker() & ~aMarkerMask );
@@ -1495,9 +1563,12 @@ void NODE::ClearRanks( int aMarkerMask )
 
 void NODE::RemoveByMarker( int aMarker )
 {
-    std::vector<ITEM*> garbage;
+    ITEM_VECTOR items;
+    ITEM_VECTOR garbage;
 
-    for( ITEM* item : *m_index )
+    getBranchItems( items );
+
+    for( ITEM* item : items )
     {
         if( item->Marker() & aMarker )
             garbage.emplace_back( item );
@@ -1585,24 +1656,28 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, LAYER_RA
 
     aJoints.clear();
 
-    for( JOINT_MAP::value_type& j : m_joints )
+    for( NODE* node = this; !node->isRoot(); node = node->m_parent )
     {
-        if( !j.second.Layers().Overlaps( aLayerMask ) )
-            continue;
-
-        if( aBox.Contains( j.second.Pos() ) && j.second.LinkCount( aKindMask ) )
+        for( JOINT_MAP::value_type& j : node->m_joints )
         {
-            aJoints.push_back( &j.second );
-            n++;
+            // skip joints changed again in a more recent branch
+            if( node != this && &jointMapFor( j.first ) != &node->m_joints )
+                continue;
+
+            if( !j.second.Layers().Overlaps( aLayerMask ) )
+                continue;
+
+            if( aBox.Contains( j.second.Pos() ) && j.second.LinkCount( aKindMask ) )
+            {
+                aJoints.push_back( &j.second );
+                n++;
+            }
         }
     }
 
-    if( isRoot() )
-        return n;
-
     for( JOINT_MAP::value_type& j : m_root->m_joints )
     {
-        if( !Overrides( &j.second ) && j.second.Layers().Overlaps( aLayerMask ) )
+        if( j.second.Layers().Overlaps( aLayerMask ) )
         {
             if( aBox.Contains( j.second.Pos() ) && j.second.LinkCount( aKindMask ) )
             {
@@ -1622,14 +1697,17 @@ ITEM *NODE::FindItemByParent( const BOARD_ITEM* aParent )
     {
         const BOARD_CONNECTED_ITEM* cItem = static_cast<const BOARD_CONNECTED_ITEM*>( aParent );
 
-        INDEX::NET_ITEMS_LIST* l_cur = m_index->GetItemsForNet( cItem->GetNetCode() );
-
-        if( l_cur )
+        for( NODE* node = this; node; node = node->m_parent )
         {
-            for( ITEM* item : *l_cur )
+            INDEX::NET_ITEMS_LIST* l_cur = node->m_index->GetItemsForNet( cItem->GetNetCode() );
+
+            if( l_cur )
             {
-                if( item->Parent() == aParent )
-                    return item;
+                for( ITEM* item : *l_cur )
+                {
+                    if( item->Parent() == aParent && ( node == this || !Overrides( item ) ) )
+                        return item;
+                }
             }
         }
     }
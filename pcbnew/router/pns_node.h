@@ -316,7 +316,11 @@ public:
      * Create a lightweight copy (called branch) of self that tracks the changes (added/removed
      * items) wrs to the root.
      *
-     * @note If there are any branches in use, their parents must **not** be deleted.
+     * A branch only stores its own changes, on top of the ones of its parents, so creating it
+     * costs nothing whatever the number of changes in the parents.
+     *
+     * @note If there are any branches in use, their parents must **not** be deleted nor
+     *       modified (except the root).
      *
      * @return the new branch.
      */
@@ -404,11 +408,9 @@ public:
         return m_parent;
     }
 
-    ///< Check if this branch contains an updated version of the m_item from the root branch.
-    bool Overrides( ITEM* aItem ) const
-    {
-        return m_override.find( aItem ) != m_override.end();
-    }
+    ///< Check if this branch, or one of its parents, contains an updated version of \a aItem
+    ///< from an older parent.
+    bool Overrides( ITEM* aItem ) const;
 
     void FixupVirtualVias();
 
@@ -425,6 +427,8 @@ public:
     void Add( std::unique_ptr< ITEM > aItem, bool aAllowRedundant = false );
 
 private:
+    typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
+    typedef JOINT_MAP::value_type TagJointPair;
 
     /// nodes are not copyable
     NODE( const NODE& aB );
@@ -433,6 +437,10 @@ private:
     ///< Try to find matching joint and creates a new one if not found.
     JOINT& touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int aNet );
 
+    ///< Return the joint map holding the joints at \a aTag seen from this node, which is the one
+    ///< of the most recent node that changed them, or the one of the root.
+    JOINT_MAP& jointMapFor( const JOINT::HASH_TAG& aTag );
+
     ///< Touch a joint and links it to an m_item.
     void linkJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int aNet, ITEM* aWhere );
 
@@ -451,6 +459,13 @@ private:
     void removeArcIndex( ARC* aVia );
 
     void doRemove( ITEM* aItem );
+
+    ///< Return the items added in this node and its parents that are still there, except the
+    ///< root items, or all the items for the root node.
+    void getBranchItems( ITEM_VECTOR& aItems ) const;
+
+    ///< Return the root items removed in this node and its parents.
+    void getOverriddenRootItems( ITEM_VECTOR& aItems ) const;
     void unlinkParent();
     void releaseChildren();
     void releaseGarbage();
@@ -475,22 +490,24 @@ private:
 
 private:
     struct DEFAULT_OBSTACLE_VISITOR;
-    typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
-    typedef JOINT_MAP::value_type TagJointPair;
 
-    JOINT_MAP       m_joints;           ///< hash table with the joints, linking the items. Joints
-                                        ///< are hashed by their position, layer set and net.
+    JOINT_MAP       m_joints;           ///< hash table with the joints changed in this node,
+                                        ///< linking the items. Joints are hashed by their
+                                        ///< position, layer set and net.
+
+    ///< positions whose joints were all removed in this node: the root joints apply again
+    std::unordered_set<JOINT::HASH_TAG, JOINT::JOINT_TAG_HASH> m_clearedJoints;
 
     NODE*           m_parent;           ///< node this node was branched from
     NODE*           m_root;             ///< root node of the whole hierarchy
     std::set<NODE*> m_children;         ///< list of nodes branched from this one
 
-    std::unordered_set<ITEM*> m_override;   ///< hash of root's items that have been changed
-                                            ///< in this node
+    std::unordered_set<ITEM*> m_override;   ///< hash of the parents' items that have been
+                                            ///< changed in this node
 
     int             m_maxClearance;     ///< worst case item-item clearance
     RULE_RESOLVER*  m_ruleResolver;     ///< Design rules resolver
-    INDEX*          m_index;            ///< Geometric/Net index of the items
+    INDEX*          m_index;            ///< Geometric/Net index of the items added in this node
     int             m_depth;            ///< depth of the node (number of parent nodes in the
                                         ///< inheritance chain)
 
@@ -34,6 +34,7 @@
 
 #include "pns_utils.h"
 #include "pns_router.h"
+#include "pns_stats.h"
 #include "pns_debug_decorator.h"
 
 
@@ -470,6 +471,7 @@ bool OPTIMIZER::mergeObtuse( LINE* aLine )
     while( 1 )
     {
         iter++;
+        Stats().m_optimizerIterations++;
         int n_segs = current_path.SegmentCount();
         int max_step = n_segs - 2;
 
@@ -688,6 +690,8 @@ bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
 
 bool OPTIMIZER::mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentPath, int step )
 {
+    Stats().m_optimizerIterations++;
+
     int n_segs = aCurrentPath.SegmentCount();
 
     int cost_orig = COST_ESTIMATOR::CornerCost( aCurrentPath );
@@ -1268,6 +1272,8 @@ bool checkDpColliding( NODE* aNode, DIFF_PAIR* aPair, bool aIsP, const SHAPE_LIN
 
 bool OPTIMIZER::mergeDpStep( DIFF_PAIR* aPair, bool aTryP, int step )
 {
+    Stats().m_optimizerIterations++;
+
     int n = 1;
 
     SHAPE_LINE_CHAIN currentPath = aTryP ? aPair->CP() : aPair->CN();
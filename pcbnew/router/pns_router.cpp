@@ -19,6 +19,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <vector>
@@ -42,6 +43,7 @@
 #include "pns_solid.h"
 #include "pns_utils.h"
 #include "pns_router.h"
+#include "pns_debug_decorator.h"
 #include "pns_shove.h"
 #include "pns_dragger.h"
 #include "pns_component_dragger.h"
@@ -50,6 +52,7 @@
 #include "pns_meander_placer.h"
 #include "pns_meander_skew_placer.h"
 #include "pns_dp_meander_placer.h"
+#include "pns_stats.h"
 
 namespace PNS {
 
@@ -457,20 +460,38 @@ bool ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
     if( m_logger )
         m_logger->Log( LOGGER::EVT_MOVE, aP, endItem );
 
+    bool rv = false;
+
     switch( m_state )
     {
     case ROUTE_TRACK:
-        return movePlacing( aP, endItem );
+        rv = movePlacing( aP, endItem );
+        break;
 
     case DRAG_SEGMENT:
     case DRAG_COMPONENT:
-        return moveDragging( aP, endItem );
+        rv = moveDragging( aP, endItem );
+        break;
 
     default:
         break;
     }
 
-    return false;
+    DEBUG_DECORATOR* dbg = m_iface->GetDebugDecorator();
+
+    if( dbg && dbg->IsDebugEnabled() )
+    {
+        const STATS& stats = Stats();
+        double       queries = std::max<double>( stats.m_clearanceQueries, 1 );
+
+        dbg->Message( wxString::Format( wxT( "clearance cache: %llu queries, %.1f%% item hits, "
+                                             "%.1f%% rule hits" ),
+                                        (unsigned long long) stats.m_clearanceQueries,
+                                        100.0 * stats.m_clearanceItemHits / queries,
+                                        100.0 * stats.m_clearanceRuleHits / queries ) );
+    }
+
+    return rv;
 }
 
 
@@ -0,0 +1,63 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_STATS_H
+#define __PNS_STATS_H
+
+#include <cstdint>
+
+namespace PNS {
+
+/**
+ * Counters of the work done by the router, read by the QA tools to catch performance
+ * regressions.  The router runs in a single thread, so they are plain integers.
+ */
+struct STATS
+{
+    uint64_t m_collisionQueries = 0;      ///< calls to NODE::QueryColliding()
+    uint64_t m_branches = 0;              ///< calls to NODE::Branch()
+    uint64_t m_optimizerIterations = 0;   ///< merge passes run by the OPTIMIZER
+    uint64_t m_clearanceQueries = 0;      ///< clearances asked to the RULE_RESOLVER
+    uint64_t m_clearanceItemHits = 0;     ///< ... found in the cache of the items
+    uint64_t m_clearanceRuleHits = 0;     ///< ... found in the cache of the rule attributes
+
+    void Reset() { *this = STATS(); }
+
+    /// Return the work done since \a aStart was taken.
+    STATS operator-( const STATS& aStart ) const
+    {
+        STATS delta;
+
+        delta.m_collisionQueries = m_collisionQueries - aStart.m_collisionQueries;
+        delta.m_branches = m_branches - aStart.m_branches;
+        delta.m_optimizerIterations = m_optimizerIterations - aStart.m_optimizerIterations;
+        delta.m_clearanceQueries = m_clearanceQueries - aStart.m_clearanceQueries;
+        delta.m_clearanceItemHits = m_clearanceItemHits - aStart.m_clearanceItemHits;
+        delta.m_clearanceRuleHits = m_clearanceRuleHits - aStart.m_clearanceRuleHits;
+
+        return delta;
+    }
+};
+
+/// Return the counters of the router.
+STATS& Stats();
+
+}
+
+#endif    // __PNS_STATS_H
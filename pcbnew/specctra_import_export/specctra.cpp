@@ -3816,13 +3816,7 @@ UNIT_RES UNIT_RES::Default( nullptr, T_resolution );
 
 int PADSTACK::Compare( PADSTACK* lhs, PADSTACK* rhs )
 {
-    if( !lhs->hash.size() )
-        lhs->hash = lhs->makeHash();
-
-    if( !rhs->hash.size() )
-        rhs->hash = rhs->makeHash();
-
-    int result = lhs->hash.compare( rhs->hash );
+    int result = lhs->GetHash().compare( rhs->GetHash() );
 
     if( result )
         return result;
@@ -3837,13 +3831,7 @@ int PADSTACK::Compare( PADSTACK* lhs, PADSTACK* rhs )
 
 int IMAGE::Compare( IMAGE* lhs, IMAGE* rhs )
 {
-    if( !lhs->hash.size() )
-        lhs->hash = lhs->makeHash();
-
-    if( !rhs->hash.size() )
-        rhs->hash = rhs->makeHash();
-
-    int result = lhs->hash.compare( rhs->hash );
+    int result = lhs->GetHash().compare( rhs->GetHash() );
 
     return result;
 }
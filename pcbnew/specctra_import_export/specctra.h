@@ -35,10 +35,12 @@
 #include <specctra_import_export/specctra_lexer.h>
 
 #include <memory>
+#include <unordered_map>
 #include <geometry/shape_poly_set.h>
 
 // all outside the DSN namespace:
 class BOARD;
+class BOARD_COMMIT;
 class PCB_TRACK;
 class PCB_VIA;
 class NETCLASS;
@@ -2028,6 +2030,17 @@ public:
      */
     static int Compare( IMAGE* lhs, IMAGE* rhs );
 
+    /**
+     * @return the string used by Compare(), made on first use.
+     */
+    const std::string& GetHash()
+    {
+        if( hash.empty() )
+            hash = makeHash();
+
+        return hash;
+    }
+
     std::string GetImageId()
     {
         if( duplicated )
@@ -2157,6 +2170,17 @@ public:
      */
     static int Compare( PADSTACK* lhs, PADSTACK* rhs );
 
+    /**
+     * @return the string used by Compare(), made on first use.
+     */
+    const std::string& GetHash()
+    {
+        if( hash.empty() )
+            hash = makeHash();
+
+        return hash;
+    }
+
     void SetPadstackId( const char* aPadstackId )
     {
         padstack_id = aPadstackId;
@@ -2293,23 +2317,22 @@ public:
      */
     int FindIMAGE( IMAGE* aImage )
     {
-        unsigned i;
+        indexImages();
+
+        auto range = m_imageIndex.equal_range( imageKey( aImage ) );
 
-        for( i=0;  i<images.size();  ++i )
+        for( auto it = range.first; it != range.second; ++it )
         {
-            if( 0 == IMAGE::Compare( aImage, &images[i] ) )
-                return (int) i;
+            if( 0 == IMAGE::Compare( aImage, &images[it->second] ) )
+                return it->second;
         }
 
         // There is no match to the IMAGE contents, but now generate a unique
         // name for it.
-        int dups = 1;
+        auto dups = m_imageIdCounts.find( aImage->image_id );
 
-        for( i=0;  i<images.size();  ++i )
-        {
-            if( 0 == aImage->image_id.compare( images[i].image_id ) )
-                aImage->duplicated = dups++;
-        }
+        if( dups != m_imageIdCounts.end() )
+            aImage->duplicated = dups->second;
 
         return -1;
     }
@@ -2350,10 +2373,14 @@ public:
      */
     int FindVia( PADSTACK* aVia )
     {
-        for( unsigned i = 0; i < vias.size(); ++i )
+        indexVias();
+
+        auto range = m_viaIndex.equal_range( viaKey( aVia ) );
+
+        for( auto it = range.first; it != range.second; ++it )
         {
-            if( 0 == PADSTACK::Compare( aVia, &vias[i] ) )
-                return int( i );
+            if( 0 == PADSTACK::Compare( aVia, &vias[it->second] ) )
+                return it->second;
         }
 
         return -1;
@@ -2404,15 +2431,16 @@ public:
      */
     PADSTACK* FindPADSTACK( const std::string& aPadstackId )
     {
-        for( unsigned i = 0; i < padstacks.size(); ++i )
+        // The first padstack of a given name wins
+        for( ; m_indexedPadstacks < padstacks.size(); ++m_indexedPadstacks )
         {
-            PADSTACK* ps = &padstacks[i];
-
-            if( ps->GetPadstackId().compare( aPadstackId ) == 0 )
-                return ps;
+            PADSTACK* ps = &padstacks[m_indexedPadstacks];
+            m_padstackIndex.emplace( ps->GetPadstackId(), ps );
         }
 
-        return nullptr;
+        auto it = m_padstackIndex.find( aPadstackId );
+
+        return it != m_padstackIndex.end() ? it->second : nullptr;
     }
 
     void FormatContents( OUTPUTFORMATTER* out, int nestLevel ) override
@@ -2441,11 +2469,54 @@ public:
 private:
     friend class SPECCTRA_DB;
 
+    static size_t imageKey( IMAGE* aImage )
+    {
+        return std::hash<std::string>()( aImage->GetHash() );
+    }
+
+    static size_t viaKey( PADSTACK* aVia )
+    {
+        // Via names hold the drill diameters, see PADSTACK::Compare()
+        return std::hash<std::string>()( aVia->GetHash() )
+               ^ ( std::hash<std::string>()( aVia->GetPadstackId() ) << 1 );
+    }
+
+    /**
+     * Add the images not indexed yet to the indexes, the containers may also be filled by
+     * the parser.
+     */
+    void indexImages()
+    {
+        for( ; m_indexedImages < images.size(); ++m_indexedImages )
+        {
+            IMAGE* image = &images[m_indexedImages];
+
+            m_imageIndex.emplace( imageKey( image ), (int) m_indexedImages );
+            m_imageIdCounts[image->image_id]++;
+        }
+    }
+
+    void indexVias()
+    {
+        for( ; m_indexedVias < vias.size(); ++m_indexedVias )
+            m_viaIndex.emplace( viaKey( &vias[m_indexedVias] ), (int) m_indexedVias );
+    }
+
     UNIT_RES*       unit;
     IMAGES          images;
 
     PADSTACKS       padstacks;      ///< all except vias, which are in 'vias'
     PADSTACKS       vias;
+
+    // Indexes of the containers above, so lookups do not compare against every element.
+    // Images and vias are indexed by the std::hash of their Compare() string.
+    std::unordered_multimap<size_t, int>             m_imageIndex;
+    std::unordered_map<std::string, int>             m_imageIdCounts;
+    size_t                                           m_indexedImages = 0;
+    std::unordered_multimap<size_t, int>             m_viaIndex;
+    size_t                                           m_indexedVias = 0;
+    std::unordered_map<std::string, PADSTACK*>       m_padstackIndex;
+    size_t                                           m_indexedPadstacks = 0;
 };
 
 
@@ -3753,11 +3824,13 @@ public:
      * Add the entire #SESSION info to a #BOARD but does not write it out.
      *
      * The #BOARD given to this function will have all its tracks and via's replaced, and all
-     * its components are subject to being moved.
+     * its components are subject to being moved.  The changes are staged in \a aCommit, the
+     * caller pushes it once the import succeeded or reverts it otherwise.
      *
      * @param aBoard The #BOARD to merge the #SESSION information into.
+     * @param aCommit The commit recording the changes made to \a aBoard.
      */
-    void FromSESSION( BOARD* aBoard );
+    void FromSESSION( BOARD* aBoard, BOARD_COMMIT& aCommit );
 
     /**
      * Write the internal #SESSION instance out as a #SPECTRA DSN format file.
@@ -38,11 +38,12 @@
 #include <locale_io.h>
 #include <macros.h>
 #include <board.h>
+#include <board_commit.h>
 #include <board_design_settings.h>
 #include <footprint.h>
+#include <pcb_marker.h>
 #include <pcb_track.h>
 #include <connectivity/connectivity_data.h>
-#include <view/view.h>
 #include "specctra.h"
 #include <math/util.h>      // for KiROUND
 #include <pcbnew_settings.h>
@@ -52,28 +53,20 @@ using namespace DSN;
 
 bool PCB_EDIT_FRAME::ImportSpecctraSession( const wxString& fullFileName )
 {
-    // To avoid issues with undo/redo lists (dangling pointers) clear the lists
-    // todo: use undo/redo feature
-    ClearUndoRedoList();
-
-    // Remove existing tracks from view. They will be readded later after loading new tracks.
-    if( GetCanvas() )    // clear view:
-    {
-        for( PCB_TRACK* track : GetBoard()->Tracks() )
-            GetCanvas()->GetView()->Remove( track );
-    }
-
     SPECCTRA_DB     db;
+    BOARD_COMMIT    commit( this );
     LOCALE_IO       toggle;
 
     try
     {
         db.LoadSESSION( fullFileName );
-        db.FromSESSION( GetBoard() );
+        db.FromSESSION( GetBoard(), commit );
     }
     catch( const IO_ERROR& ioe )
     {
-        wxString msg = _( "Board may be corrupted, do not save it.\n Fix problem and try again" );
+        commit.Revert();
+
+        wxString msg = _( "Failed to import the session file." );
 
         wxString extra = ioe.What();
 
@@ -81,20 +74,7 @@ bool PCB_EDIT_FRAME::ImportSpecctraSession( const wxString& fullFileName )
         return false;
     }
 
-    GetBoard()->GetConnectivity()->Clear();
-    GetBoard()->BuildConnectivity();
-
-    OnModify();
-
-    if( GetCanvas() )    // Update view:
-    {
-        // Update footprint positions
-        GetCanvas()->GetView()->RecacheAllItems();
-
-        // add imported tracks (previous tracks are removed, therefore all are new)
-        for( auto track : GetBoard()->Tracks() )
-            GetCanvas()->GetView()->Add( track );
-   }
+    commit.Push( _( "Import Specctra Session" ) );
 
     SetStatusText( wxString( _( "Session file imported and merged OK." ) ) );
 
@@ -334,7 +314,7 @@ PCB_VIA* SPECCTRA_DB::makeVIA( WIRE_VIA*aVia, PADSTACK* aPadstack, const POINT&
 // no UI code in this function, throw exception to report problems to the
 // UI handler: void PCB_EDIT_FRAME::ImportSpecctraSession( wxCommandEvent& event )
 
-void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
+void SPECCTRA_DB::FromSESSION( BOARD* aBoard, BOARD_COMMIT& aCommit )
 {
     m_sessionBoard = aBoard;      // not owned here
 
@@ -347,29 +327,8 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
     if( !m_session->route->library )
         THROW_IO_ERROR( _("Session file is missing the \"library_out\" section") );
 
-    // delete the old tracks and vias but save locked tracks/vias; they will be re-added later
-    std::vector<PCB_TRACK*> locked;
-
-    while( !aBoard->Tracks().empty() )
-    {
-        PCB_TRACK* track = aBoard->Tracks().back();
-        aBoard->Tracks().pop_back();
-
-        if( track->IsLocked() )
-            locked.push_back( track );
-        else
-            delete track;
-    }
-
-    aBoard->DeleteMARKERs();
-
     buildLayerMaps( aBoard );
 
-    // Add locked tracks: because they are exported as Fix tracks, they are not
-    // in .ses file.
-    for( PCB_TRACK* track: locked )
-        aBoard->Add( track );
-
     if( m_session->placement )
     {
         // Walk the PLACEMENT object's COMPONENTs list, and for each PLACE within
@@ -399,6 +358,8 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
                 UNIT_RES* resolution = place->GetUnits();
                 wxASSERT( resolution );
 
+                aCommit.Modify( footprint );
+
                 wxPoint newPos = mapPt( place->vertex, resolution );
                 footprint->SetPosition( newPos );
 
@@ -438,6 +399,10 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
 
     m_routeResolution = m_session->route->GetUnits();
 
+    // The new tracks and vias are only handed to the commit once the whole session has been
+    // read, so nothing is left half done on the board if a problem is found.
+    std::vector<std::unique_ptr<PCB_TRACK>> newTracks;
+
     // Walk the NET_OUTs and create tracks and vias anew.
     NET_OUTS& net_outs = m_session->route->net_outs;
     for( NET_OUTS::iterator net = net_outs.begin(); net!=net_outs.end(); ++net )
@@ -479,30 +444,17 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
                 PATH*   path = (PATH*) wire->shape;
 
                 for( unsigned pt=0; pt < path->points.size()-1; ++pt )
-                {
-                    PCB_TRACK* track = makeTRACK( wire, path, pt, netoutCode );
-                    aBoard->Add( track );
-                }
+                    newTracks.emplace_back( makeTRACK( wire, path, pt, netoutCode ) );
             }
         }
 
         WIRE_VIAS& wire_vias = net->wire_vias;
         LIBRARY& library = *m_session->route->library;
 
+        // page 144 of spec says wire_via's net_id is optional, all the vias of a NET_OUT
+        // belong to its net
         for( unsigned i=0;  i<wire_vias.size();  ++i )
         {
-            int         netCode = 0;
-
-            // page 144 of spec says wire_via's net_id is optional
-            if( net->net_id.size() )
-            {
-                wxString netName = FROM_UTF8( net->net_id.c_str() );
-                NETINFO_ITEM* netvia = aBoard->FindNet( netName );
-
-                if( netvia )
-                    netCode = netvia->GetNetCode();
-            }
-
             WIRE_VIA* wire_via = &wire_vias[i];
 
             // example: (via Via_15:8_mil 149000 -71000 )
@@ -528,12 +480,29 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
 
             for( unsigned v = 0; v < wire_via->vertexes.size(); ++v )
             {
-                PCB_VIA* via = makeVIA( wire_via, padstack, wire_via->vertexes[v], netCode,
-                                        via_drill_default );
-                aBoard->Add( via );
+                newTracks.emplace_back( makeVIA( wire_via, padstack, wire_via->vertexes[v],
+                                                 netoutCode, via_drill_default ) );
             }
         }
     }
+
+    // Replace the old tracks and vias, but keep the locked ones: because they are exported as
+    // fixed wires, they are not in the .ses file.  The unlocked ones are taken off the board
+    // in a single pass, removing them one by one through the commit is quadratic.
+    std::vector<BOARD_ITEM*> removed = aBoard->RemoveTracks(
+            []( PCB_TRACK* aTrack )
+            {
+                return !aTrack->IsLocked();
+            } );
+
+    for( BOARD_ITEM* track : removed )
+        aCommit.Removed( track );
+
+    for( PCB_MARKER* marker : aBoard->Markers() )
+        aCommit.Remove( marker );
+
+    for( std::unique_ptr<PCB_TRACK>& track : newTracks )
+        aCommit.Add( track.release() );
 }
 
 
@@ -36,6 +36,7 @@
 #include <geometry/shape_line_chain.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <bezier_curves.h>
+#include <thread_pool.h>
 
 #include <wx/log.h>
 
@@ -90,15 +91,49 @@ ZONE* TEARDROP_MANAGER::createTeardrop( TEARDROP_VARIANT aTeardropVariant,
 }
 
 
+bool TEARDROP_MANAGER::addTeardrop( BOARD_COMMIT* aCommitter, TEARDROP_VARIANT aTeardropVariant,
+                                    std::vector<VECTOR2I>& aPoints, PCB_TRACK* aTrack )
+{
+    // An existing teardrop having exactly the same shape was built from the same track and
+    // pad/via with the same parameters, so it does not need to be rebuilt
+    auto previous = m_previousTdList.find( teardropKey( aTeardropVariant, aPoints, aTrack ) );
+
+    if( previous != m_previousTdList.end() )
+    {
+        m_keptTdList.push_back( previous->second );
+        m_previousTdList.erase( previous );
+        return false;
+    }
+
+    ZONE* new_teardrop = createTeardrop( aTeardropVariant, aPoints, aTrack );
+    m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
+    m_createdTdList.push_back( new_teardrop );
+
+    if( aCommitter )
+        aCommitter->Added( new_teardrop );
+
+    return true;
+}
+
+
 int TEARDROP_MANAGER::SetTeardrops( BOARD_COMMIT* aCommitter, bool aFollowTracks )
 {
     // Init parameters:
     m_tolerance = pcbIUScale.mmToIU( 0.01 );
 
-    int count = 0;      // Number of created teardrop
+    int count = 0;      // Number of teardrops kept or created
+
+    m_createdTdList.clear();
+    m_keptTdList.clear();
+    m_previousTdList.clear();
+
+    // Old teardrops are removed only if they are not rebuilt with the same shape, i.e. if
+    // their track, their pad/via or the teardrop parameters have changed
+    std::vector< ZONE*> teardrops;
+    collectTeardrops( teardrops );
 
-    // Old teardrops must be removed, to ensure a clean teardrop rebuild
-    int removed_cnt = RemoveTeardrops( aCommitter, false );
+    for( ZONE* teardrop : teardrops )
+        m_previousTdList.emplace( teardropKey( teardrop ), teardrop );
 
     // get vias, PAD_ATTRIB_PTH and others if aIncludeNotDrilled == true
     // (custom pads are not collected)
@@ -110,6 +145,9 @@ int TEARDROP_MANAGER::SetTeardrops( BOARD_COMMIT* aCommitter, bool aFollowTracks
     collectPadsCandidate( viapad_list, m_prmsList->m_TargetViasPads,
                           m_prmsList->m_UseRoundShapesOnly, m_prmsList->m_TargetPadsWithNoHole );
 
+    VIAPAD_RTREE viapadIndex;
+    buildViaPadIndex( viapad_list, viapadIndex );
+
     TRACK_BUFFER trackLookupList;
 
     if( aFollowTracks )
@@ -126,9 +164,7 @@ int TEARDROP_MANAGER::SetTeardrops( BOARD_COMMIT* aCommitter, bool aFollowTracks
         }
     }
 
-
-    std::vector< ZONE*> teardrops;
-    collectTeardrops( teardrops );
+    std::vector<size_t> candidates;
 
     for( PCB_TRACK* track : m_board->Tracks() )
     {
@@ -136,9 +172,18 @@ int TEARDROP_MANAGER::SetTeardrops( BOARD_COMMIT* aCommitter, bool aFollowTracks
             continue;
 
         // Search for a padvia connected to track, with one end inside and one end outside
-        // if both track ends are inside or outside, one cannot build a teadrop
-        for( VIAPAD& viapad: viapad_list )
+        // if both track ends are inside or outside, one cannot build a teadrop.
+        // Only pads/vias containing one of the track ends are candidates.
+        candidates.clear();
+        queryViaPadIndex( viapadIndex, track->GetStart(), candidates );
+        queryViaPadIndex( viapadIndex, track->GetEnd(), candidates );
+        std::sort( candidates.begin(), candidates.end() );
+        candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+        for( size_t candidate : candidates )
         {
+            VIAPAD& viapad = viapad_list[candidate];
+
             // Pad and track must be on the same layer
             if( !viapad.IsOnLayer( track->GetLayer() ) )
                 continue;
@@ -179,13 +224,7 @@ int TEARDROP_MANAGER::SetTeardrops( BOARD_COMMIT* aCommitter, bool aFollowTracks
 
             if( success )
             {
-                ZONE* new_teardrop = createTeardrop( TD_TYPE_PADVIA, points, track );
-                m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                m_createdTdList.push_back( new_teardrop );
-
-                if( aCommitter )
-                    aCommitter->Added( new_teardrop );
-
+                addTeardrop( aCommitter, TD_TYPE_PADVIA, points, track );
                 count += 1;
             }
         }
@@ -196,33 +235,30 @@ int TEARDROP_MANAGER::SetTeardrops( BOARD_COMMIT* aCommitter, bool aFollowTracks
     if( m_prmsList->m_TargetTrack2Track )
         track2trackCount = addTeardropsOnTracks( aCommitter );
 
-    // Now set priority of teardrops now all teardrops are added
-    setTeardropPriorities();
+    // Remove old teardrops that were not rebuilt
+    int removed_cnt = 0;
 
-    // Fill teardrop shapes. This is a rough calculation, just to show a filled
-    // shape on screen, but most of time this is a good shape.
-    // Exact shapes can be calculated only on a full zone refill, **much more** time consuming
-    if( m_createdTdList.size() )
+    for( const std::pair<const std::vector<int>, ZONE*>& previous : m_previousTdList )
     {
-        int epsilon = pcbIUScale.mmToIU( 0.001 );
+        m_board->Remove( previous.second, REMOVE_MODE::BULK );
 
-        for( ZONE* zone: m_createdTdList )
-        {
-            int half_min_width = zone->GetMinThickness() / 2;
-            int numSegs = GetArcToSegmentCount( half_min_width, pcbIUScale.mmToIU( 0.005 ), FULL_CIRCLE );
-            SHAPE_POLY_SET filledPolys = *zone->Outline();
+        if( aCommitter )
+            aCommitter->Removed( previous.second );
+
+        removed_cnt += 1;
+    }
 
-            filledPolys.Deflate( half_min_width - epsilon, numSegs );
+    m_previousTdList.clear();
 
-            // Re-inflate after pruning of areas that don't meet minimum-width criteria
-            if( half_min_width - epsilon > epsilon )
-                filledPolys.Inflate( half_min_width - epsilon, numSegs );
+    // Now set priority of teardrops now all teardrops are added
+    int modified_cnt = setTeardropPriorities( aCommitter );
 
-            zone->SetFilledPolysList( zone->GetFirstLayer(), filledPolys );
-        }
-    }
+    // Fill teardrop shapes. This is a rough calculation, just to show a filled
+    // shape on screen, but most of time this is a good shape.
+    // Exact shapes can be calculated only on a full zone refill, **much more** time consuming
+    fillCreatedTeardrops();
 
-    if( count || removed_cnt || track2trackCount )
+    if( m_createdTdList.size() || removed_cnt || modified_cnt )
     {
         if( aCommitter )
             aCommitter->Push( _( "Add teardrops" ) );
@@ -236,12 +272,52 @@ int TEARDROP_MANAGER::SetTeardrops( BOARD_COMMIT* aCommitter, bool aFollowTracks
 }
 
 
-void TEARDROP_MANAGER::setTeardropPriorities()
+void TEARDROP_MANAGER::fillCreatedTeardrops()
+{
+    if( m_createdTdList.empty() )
+        return;
+
+    int epsilon = pcbIUScale.mmToIU( 0.001 );
+
+    // Each teardrop is filled from its own outline only, so they can be filled in parallel
+    auto fill_lambda =
+            [&]( ZONE* zone ) -> size_t
+            {
+                int half_min_width = zone->GetMinThickness() / 2;
+                int numSegs = GetArcToSegmentCount( half_min_width, pcbIUScale.mmToIU( 0.005 ),
+                                                    FULL_CIRCLE );
+                SHAPE_POLY_SET filledPolys = *zone->Outline();
+
+                filledPolys.Deflate( half_min_width - epsilon, numSegs );
+
+                // Re-inflate after pruning of areas that don't meet minimum-width criteria
+                if( half_min_width - epsilon > epsilon )
+                    filledPolys.Inflate( half_min_width - epsilon, numSegs );
+
+                zone->SetFilledPolysList( zone->GetFirstLayer(), filledPolys );
+                return 1;
+            };
+
+    thread_pool&                     tp = GetKiCadThreadPool();
+    std::vector<std::future<size_t>> returns;
+
+    returns.reserve( m_createdTdList.size() );
+
+    for( ZONE* zone : m_createdTdList )
+        returns.emplace_back( tp.submit( fill_lambda, zone ) );
+
+    for( std::future<size_t>& ret : returns )
+        ret.wait();
+}
+
+
+int TEARDROP_MANAGER::setTeardropPriorities( BOARD_COMMIT* aCommitter )
 {
     // Note: a teardrop area is on only one layer, so using GetFirstLayer() is OK
     // to know the zone layer of a teardrop
 
     int priority_base = MAGIC_TEARDROP_ZONE_ID;
+    int modified_cnt = 0;
 
     // The sort function to sort by increasing copper layers. Group by layers.
     // For same layers sort by decreasing areas
@@ -256,14 +332,19 @@ void TEARDROP_MANAGER::setTeardropPriorities()
             }
     } compareLess;
 
-    for( ZONE* td: m_createdTdList )
+    std::vector<ZONE*> tdList = m_keptTdList;
+    std::set<ZONE*>    kept( m_keptTdList.begin(), m_keptTdList.end() );
+
+    tdList.insert( tdList.end(), m_createdTdList.begin(), m_createdTdList.end() );
+
+    for( ZONE* td: tdList )
         td->CalculateOutlineArea();
 
-    std::sort( m_createdTdList.begin(), m_createdTdList.end(), compareLess );
+    std::stable_sort( tdList.begin(), tdList.end(), compareLess );
 
     int curr_layer = -1;
 
-    for( ZONE* td: m_createdTdList )
+    for( ZONE* td: tdList )
     {
         if( td->GetFirstLayer() != curr_layer )
         {
@@ -271,8 +352,23 @@ void TEARDROP_MANAGER::setTeardropPriorities()
             priority_base = MAGIC_TEARDROP_ZONE_ID;
         }
 
-        td->SetAssignedPriority( priority_base++ );
+        int priority = priority_base++;
+
+        if( kept.count( td ) )
+        {
+            if( td->GetAssignedPriority() == (unsigned) priority )
+                continue;
+
+            if( aCommitter )
+                aCommitter->Modify( td );
+
+            modified_cnt += 1;
+        }
+
+        td->SetAssignedPriority( priority );
     }
+
+    return modified_cnt;
 }
 
 
@@ -298,6 +394,11 @@ int TEARDROP_MANAGER::addTeardropsOnTracks( BOARD_COMMIT* aCommitter )
     collectVias( viapad_list );
     collectPadsCandidate( viapad_list, true, true, true );
 
+    VIAPAD_RTREE viapadIndex;
+    buildViaPadIndex( viapad_list, viapadIndex );
+
+    std::vector<size_t> candidates;
+
     TEARDROP_PARAMETERS* currParams = m_prmsList->GetParameters( TARGET_TRACK );
 
     // Explore groups (a group is a set of tracks on the same layer and the same net):
@@ -369,8 +470,13 @@ int TEARDROP_MANAGER::addTeardropsOnTracks( BOARD_COMMIT* aCommitter )
 
                 // Ensure a pad or via is not on test_pos point before creating a teardrop
                 // at this location
-                for( VIAPAD& viapad : viapad_list )
+                candidates.clear();
+                queryViaPadIndex( viapadIndex, roundshape_pos, candidates );
+
+                for( size_t idx : candidates )
                 {
+                    VIAPAD& viapad = viapad_list[idx];
+
                     if( viapad.IsOnLayer( track->GetLayer() )
                         && viapad.m_Parent->HitTest( roundshape_pos, 0 ) )
                     {
@@ -389,13 +495,7 @@ int TEARDROP_MANAGER::addTeardropsOnTracks( BOARD_COMMIT* aCommitter )
 
                     if( success )
                     {
-                        ZONE* new_teardrop = createTeardrop( TD_TYPE_TRACKEND, points, track );
-                        m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                        m_createdTdList.push_back( new_teardrop );
-
-                        if( aCommitter )
-                            aCommitter->Added( new_teardrop );
-
+                        addTeardrop( aCommitter, TD_TYPE_TRACKEND, points, track );
                         count += 1;
                     }
                 }
@@ -31,6 +31,7 @@
 #include <pad.h>
 #include <pcb_track.h>
 #include <zone.h>
+#include <geometry/rtree.h>
 #include "teardrop_parameters.h"
 
 #define MAGIC_TEARDROP_PADVIA_NAME "$teardrop_padvia$"
@@ -90,8 +91,10 @@ public:
     TEARDROP_MANAGER( BOARD* aBoard, PCB_EDIT_FRAME* aFrame );
 
     /**
-     * Set teardrops on a teardrop free board
-     * @return the number of teardrop created
+     * Set teardrops on a board.
+     * Existing teardrops that would be rebuilt with the same shape are kept as is, other
+     * existing teardrops are removed, and only new teardrops are added and filled.
+     * @return the number of teardrops on the board (kept or created)
      * @param aCommitter is a BOARD_COMMIT reference (can be null)
      * @param aFollowTracks = true to use a track connected to the initial track connected
      * to a pad / via if this initial track is too short to build the teardrop
@@ -112,6 +115,8 @@ public:
 
 
 private:
+    typedef RTree<size_t, int, 2, double> VIAPAD_RTREE;
+
     /**
      * Collect and build the list of all vias from the given board
      */
@@ -137,8 +142,38 @@ private:
      */
     void collectTeardrops( std::vector< ZONE* >& aList ) const;
 
+    /**
+     * Build a R-tree of the bounding boxes of the pads and vias in \a aList.
+     * Items are stored by their index in \a aList.
+     */
+    void buildViaPadIndex( const std::vector< VIAPAD >& aList, VIAPAD_RTREE& aIndex ) const;
+
+    /**
+     * Find the pads and vias of \a aIndex which can contain \a aPoint
+     * @param aResults is the list to append the indices of the candidates to
+     */
+    void queryViaPadIndex( const VIAPAD_RTREE& aIndex, const VECTOR2I& aPoint,
+                           std::vector<size_t>& aResults ) const;
+
+    /**
+     * @return a key identifying a teardrop by its variant, layer, net and outline,
+     * used to find existing teardrops that do not need to be rebuilt
+     */
+    static std::vector<int> teardropKey( TEARDROP_VARIANT aTeardropVariant,
+                                         const std::vector<VECTOR2I>& aPoints,
+                                         PCB_TRACK* aTrack );
+    static std::vector<int> teardropKey( ZONE* aTeardrop );
+
+    /**
+     * Add a teardrop to the board, or keep the existing one if it has the same shape.
+     * @return true if a new teardrop was created
+     */
+    bool addTeardrop( BOARD_COMMIT* aCommitter, TEARDROP_VARIANT aTeardropVariant,
+                      std::vector<VECTOR2I>& aPoints, PCB_TRACK* aTrack );
+
     /**
      * Add teardrop on tracks of different sizes connected by their end
+     * @return the number of teardrops kept or created
      */
     int addTeardropsOnTracks( BOARD_COMMIT* aCommitter );
 
@@ -220,9 +255,15 @@ private:
                           std::vector<VECTOR2I>& aPoints, PCB_TRACK* aTrack) const;
 
     /**
-     * Set priority of created teardrops. smaller have bigger priority
+     * Set priority of kept and created teardrops. smaller have bigger priority
+     * @return the number of kept teardrops whose priority was modified
      */
-    void setTeardropPriorities();
+    int setTeardropPriorities( BOARD_COMMIT* aCommitter );
+
+    /**
+     * Fill the created teardrops (using the thread pool)
+     */
+    void fillCreatedTeardrops();
 
     /**
      * @return true if a point on a track can be found as anchor point of a teardrop
@@ -249,6 +290,10 @@ private:
     BOARD*  m_board;
     TEARDROP_PARAMETERS_LIST* m_prmsList; // the teardrop parameters list, from the board design settings
     std::vector<ZONE*> m_createdTdList; // list of new created teardrops
+    std::vector<ZONE*> m_keptTdList;    // list of existing teardrops kept unchanged
+
+    // Existing teardrops not (yet) matched by a rebuilt teardrop, keyed by teardropKey()
+    std::multimap<std::vector<int>, ZONE*> m_previousTdList;
 };
 
 
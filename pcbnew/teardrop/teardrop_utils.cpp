@@ -158,6 +158,94 @@ void TEARDROP_MANAGER::collectTeardrops( std::vector< ZONE* >& aList ) const
 }
 
 
+void TEARDROP_MANAGER::buildViaPadIndex( const std::vector< VIAPAD >& aList,
+                                         VIAPAD_RTREE& aIndex ) const
+{
+    aIndex.RemoveAll();
+
+    for( size_t ii = 0; ii < aList.size(); ii++ )
+    {
+        const VIAPAD& viapad = aList[ii];
+        int radius;
+
+        // Use the radius used by HitTest() to reject points, so the R-tree never
+        // misses a pad or via that HitTest() would find
+        if( viapad.m_IsPad )
+            radius = static_cast<PAD*>( viapad.m_Parent )->GetBoundingRadius();
+        else
+            radius = static_cast<PCB_VIA*>( viapad.m_Parent )->GetWidth() / 2;
+
+        const VECTOR2I& pos = viapad.m_Parent->GetPosition();
+        const int min[2] = { pos.x - radius - 1, pos.y - radius - 1 };
+        const int max[2] = { pos.x + radius + 1, pos.y + radius + 1 };
+
+        aIndex.Insert( min, max, ii );
+    }
+}
+
+
+void TEARDROP_MANAGER::queryViaPadIndex( const VIAPAD_RTREE& aIndex, const VECTOR2I& aPoint,
+                                         std::vector<size_t>& aResults ) const
+{
+    const int min[2] = { aPoint.x, aPoint.y };
+    const int max[2] = { aPoint.x, aPoint.y };
+
+    auto visitor =
+            [&]( const size_t& aIndex ) -> bool
+            {
+                aResults.push_back( aIndex );
+                return true;
+            };
+
+    aIndex.Search( min, max, visitor );
+}
+
+
+std::vector<int> TEARDROP_MANAGER::teardropKey( TEARDROP_VARIANT aTeardropVariant,
+                                                const std::vector<VECTOR2I>& aPoints,
+                                                PCB_TRACK* aTrack )
+{
+    std::vector<int> key;
+
+    key.reserve( 3 + aPoints.size() * 2 );
+    key.push_back( aTeardropVariant == TD_TYPE_PADVIA ? (int) TEARDROP_TYPE::TD_VIAPAD
+                                                      : (int) TEARDROP_TYPE::TD_TRACKEND );
+    key.push_back( aTrack->GetLayer() );
+    key.push_back( aTrack->GetNetCode() );
+
+    for( const VECTOR2I& pt : aPoints )
+    {
+        key.push_back( pt.x );
+        key.push_back( pt.y );
+    }
+
+    return key;
+}
+
+
+std::vector<int> TEARDROP_MANAGER::teardropKey( ZONE* aTeardrop )
+{
+    std::vector<int> key;
+
+    key.push_back( (int) aTeardrop->GetTeardropAreaType() );
+    key.push_back( aTeardrop->GetFirstLayer() );
+    key.push_back( aTeardrop->GetNetCode() );
+
+    if( aTeardrop->Outline()->OutlineCount() == 1 )
+    {
+        const SHAPE_LINE_CHAIN& outline = aTeardrop->Outline()->COutline( 0 );
+
+        for( int ii = 0; ii < outline.PointCount(); ii++ )
+        {
+            key.push_back( outline.CPoint( ii ).x );
+            key.push_back( outline.CPoint( ii ).y );
+        }
+    }
+
+    return key;
+}
+
+
 bool TEARDROP_MANAGER::isViaAndTrackInSameZone( VIAPAD& aViapad, PCB_TRACK* aTrack ) const
 {
     for( ZONE* zone: m_board->Zones() )
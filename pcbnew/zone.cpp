@@ -1287,6 +1287,157 @@ double FP_ZONE::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
 }
 
 
+/// Number of levels of simplified fills kept by ZONE::GetDisplayFill()
+static constexpr int DISPLAY_FILL_LEVELS = 3;
+
+
+/**
+ * @return the distance to the exact fill of the simplified fills of \a aLevel, from 20um for
+ *         the first level up to 320um.
+ */
+static int displayFillMaxError( int aLevel )
+{
+    return pcbIUScale.mmToIU( 0.02 ) << ( 2 * ( aLevel - 1 ) );
+}
+
+
+/**
+ * Douglas-Peucker simplification of a closed contour.
+ *
+ * @return the contour keeping only the points needed for none of the removed ones to be
+ *         further than \a aMaxError from it.
+ */
+static SHAPE_LINE_CHAIN simplifyContour( const SHAPE_LINE_CHAIN& aContour, int aMaxError )
+{
+    const int                        count = aContour.PointCount();
+    const SEG::ecoord                maxErrorSq = SEG::Square( aMaxError );
+    std::vector<bool>                keep( count + 1, false );
+    std::vector<std::pair<int, int>> ranges;
+
+    // The contour is split in two at its first point and the point half way round.  Index
+    // count stands for the first point again.
+    keep[0] = keep[count / 2] = keep[count] = true;
+    ranges.emplace_back( 0, count / 2 );
+    ranges.emplace_back( count / 2, count );
+
+    while( !ranges.empty() )
+    {
+        auto [ first, last ] = ranges.back();
+        ranges.pop_back();
+
+        SEG         chord( aContour.CPoint( first ), aContour.CPoint( last % count ) );
+        SEG::ecoord farthestSq = maxErrorSq;
+        int         farthest = -1;
+
+        for( int ii = first + 1; ii < last; ++ii )
+        {
+            SEG::ecoord distSq = chord.SquaredDistance( aContour.CPoint( ii ) );
+
+            if( distSq > farthestSq )
+            {
+                farthestSq = distSq;
+                farthest = ii;
+            }
+        }
+
+        if( farthest >= 0 )
+        {
+            keep[farthest] = true;
+            ranges.emplace_back( first, farthest );
+            ranges.emplace_back( farthest, last );
+        }
+    }
+
+    SHAPE_LINE_CHAIN result;
+
+    for( int ii = 0; ii < count; ++ii )
+    {
+        if( keep[ii] )
+            result.Append( aContour.CPoint( ii ), true );
+    }
+
+    result.SetClosed( true );
+
+    return result;
+}
+
+
+int ZONE::GetDisplayFillLevel( int aMaxError )
+{
+    int level = 0;
+
+    while( level < DISPLAY_FILL_LEVELS && displayFillMaxError( level + 1 ) <= aMaxError )
+        ++level;
+
+    return level;
+}
+
+
+std::shared_ptr<SHAPE_POLY_SET> ZONE::GetDisplayFill( PCB_LAYER_ID aLayer, int aMaxError ) const
+{
+    const std::shared_ptr<SHAPE_POLY_SET>& fill = GetFilledPolysList( aLayer );
+    int                                    level = GetDisplayFillLevel( aMaxError );
+
+    // The hash of a fill can only be trusted if its triangulation is up to date
+    if( level == 0 || !fill->IsTriangulationUpToDate() )
+        return fill;
+
+    std::vector<DISPLAY_FILL>& displayFills = m_displayFills[aLayer];
+    MD5_HASH                   hash = fill->GetHash();
+
+    displayFills.resize( DISPLAY_FILL_LEVELS );
+
+    DISPLAY_FILL& displayFill = displayFills[level - 1];
+
+    if( displayFill.m_fill && displayFill.m_hash == hash )
+        return displayFill.m_fill;
+
+    std::shared_ptr<SHAPE_POLY_SET> simplified = std::make_shared<SHAPE_POLY_SET>();
+    int                             maxError = displayFillMaxError( level );
+
+    auto isSpeck =
+            [&]( const SHAPE_LINE_CHAIN& aContour )
+            {
+                BOX2I bbox = aContour.BBox();
+
+                return aContour.PointCount() < 3
+                        || ( bbox.GetWidth() < maxError && bbox.GetHeight() < maxError );
+            };
+
+    for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+    {
+        // Islands smaller than the error would not be more than a speck on screen
+        if( isSpeck( fill->COutline( ii ) ) )
+            continue;
+
+        SHAPE_LINE_CHAIN outline = simplifyContour( fill->COutline( ii ), maxError );
+
+        if( outline.PointCount() < 3 )
+            continue;
+
+        int outlineIdx = simplified->AddOutline( outline );
+
+        for( int jj = 0; jj < fill->HoleCount( ii ); ++jj )
+        {
+            if( isSpeck( fill->CHole( ii, jj ) ) )
+                continue;
+
+            SHAPE_LINE_CHAIN hole = simplifyContour( fill->CHole( ii, jj ), maxError );
+
+            if( hole.PointCount() >= 3 )
+                simplified->AddHole( hole, outlineIdx );
+        }
+    }
+
+    simplified->CacheTriangulation();
+
+    displayFill.m_hash = hash;
+    displayFill.m_fill = simplified;
+
+    return simplified;
+}
+
+
 std::shared_ptr<SHAPE> ZONE::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHING aFlash ) const
 {
     if( m_FilledPolysList.find( aLayer ) == m_FilledPolysList.end() )
@@ -610,6 +610,24 @@ public:
         return m_FilledPolysList.at( aLayer ).get();
     }
 
+    /**
+     * Return the filled polygons of \a aLayer simplified for display when zoomed out.
+     *
+     * The simplified fills are built on first use for a few levels of simplification, and
+     * rebuilt when the fill changes.  They are only meant to be drawn: plotting, DRC and
+     * everything else must use GetFilledPolysList().
+     *
+     * @param aMaxError is the largest acceptable distance to the exact fill, in IU.
+     * @return the exact fill if it cannot be simplified within \a aMaxError.
+     */
+    std::shared_ptr<SHAPE_POLY_SET> GetDisplayFill( PCB_LAYER_ID aLayer, int aMaxError ) const;
+
+    /**
+     * @return the level of simplification used by GetDisplayFill() for \a aMaxError, 0 for
+     *         the exact fill.
+     */
+    static int GetDisplayFillLevel( int aMaxError );
+
     /**
      * Create a list of triangles that "fill" the solid areas used for instance to draw
      * these solid areas on OpenGL.
@@ -887,6 +905,16 @@ protected:
     /// A hash value used in zone filling calculations to see if the filled areas are up to date
     std::map<PCB_LAYER_ID, MD5_HASH>       m_filledPolysHash;
 
+    /// A fill simplified for display, and the hash of the fill it was made from
+    struct DISPLAY_FILL
+    {
+        MD5_HASH                        m_hash;
+        std::shared_ptr<SHAPE_POLY_SET> m_fill;
+    };
+
+    /// Simplified fills for each layer and level, see GetDisplayFill()
+    mutable std::map<PCB_LAYER_ID, std::vector<DISPLAY_FILL>> m_displayFills;
+
     ZONE_BORDER_DISPLAY_STYLE m_borderStyle;       // border display style, see enum above
     int                       m_borderHatchPitch;  // for DIAGONAL_EDGE, distance between 2 lines
     std::vector<SEG>          m_borderHatchLines;  // hatch lines
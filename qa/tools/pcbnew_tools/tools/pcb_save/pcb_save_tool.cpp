@@ -0,0 +1,164 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+
+#include <board.h>
+#include <plugins/kicad/pcb_plugin.h>
+#include <richio.h>
+
+
+using SAVE_DURATION = std::chrono::microseconds;
+
+
+/**
+ * Load a board and save it back out a number of times, reporting the time taken.
+ *
+ * @param aFilename the board file to load.
+ * @param aIterations how many times to save the board.
+ * @param aVerbose print the timing of each save.
+ * @return true if the board was loaded and saved successfully.
+ */
+bool benchmarkSave( const wxString& aFilename, int aIterations, bool aVerbose )
+{
+    PCB_PLUGIN             plugin;
+    std::unique_ptr<BOARD> board;
+
+    try
+    {
+        PROF_TIMER timer;
+        board.reset( plugin.Load( aFilename, nullptr ) );
+
+        if( aVerbose )
+            std::cout << "Load took: " << timer.SinceStart<SAVE_DURATION>().count() << "us"
+                      << std::endl;
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cerr << ioe.What() << std::endl;
+        return false;
+    }
+
+    if( !board )
+        return false;
+
+    wxString      outFile = wxFileName::CreateTempFileName( wxT( "pcb_save" ) );
+    SAVE_DURATION total{};
+    SAVE_DURATION best = SAVE_DURATION::max();
+
+    try
+    {
+        for( int i = 0; i < aIterations; ++i )
+        {
+            PROF_TIMER timer;
+            plugin.Save( outFile, board.get() );
+
+            SAVE_DURATION duration = timer.SinceStart<SAVE_DURATION>();
+
+            total += duration;
+            best = std::min( best, duration );
+
+            if( aVerbose )
+                std::cout << "Save " << i << " took: " << duration.count() << "us" << std::endl;
+        }
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cerr << ioe.What() << std::endl;
+        wxRemoveFile( outFile );
+        return false;
+    }
+
+    wxULongLong size = wxFileName::GetSize( outFile );
+    wxRemoveFile( outFile );
+
+    std::cout << aFilename.ToStdString() << ": " << aIterations << " saves, "
+              << size.ToString().ToStdString() << " bytes, best " << best.count() << "us, mean "
+              << total.count() / std::max( aIterations, 1 ) << "us" << std::endl;
+
+    return true;
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "v", "verbose", _( "print timing of each save" ).mb_str() },
+    { wxCMD_LINE_OPTION, "n", "iterations", _( "number of saves per board (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input file" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum SAVE_RET_CODES
+{
+    SAVE_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int pcb_save_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program loads the given PCB files and times saving them "
+                               "back out in the KiCad s-expression format." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    long       iterations = 5;
+    bool       ok = true;
+
+    cl_parser.Found( "iterations", &iterations );
+
+    for( unsigned i = 0; i < cl_parser.GetParamCount(); i++ )
+        ok = benchmarkSave( cl_parser.GetParam( i ), (int) iterations, verbose ) && ok;
+
+    if( !ok )
+        return SAVE_RET_CODES::SAVE_FAILED;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "pcb_save",
+                                                       "Benchmark saving a KiCad PCB file",
+                                                       pcb_save_main_func } );
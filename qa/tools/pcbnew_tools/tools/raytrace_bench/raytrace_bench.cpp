@@ -0,0 +1,223 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <board.h>
+#include <pcb_track.h>
+
+#include <3d-viewer/3d_rendering/track_ball.h>
+#include <3d-viewer/3d_rendering/raytracing/accelerators/bvh_pbrt.h>
+#include <3d-viewer/3d_rendering/raytracing/accelerators/container_3d.h>
+#include <3d-viewer/3d_rendering/raytracing/raypacket.h>
+#include <3d-viewer/3d_rendering/raytracing/shapes2D/round_segment_2d.h>
+#include <3d-viewer/3d_rendering/raytracing/shapes3D/cylinder_3d.h>
+#include <3d-viewer/3d_rendering/raytracing/shapes3D/round_segment_3d.h>
+#include <3d-viewer/3d_rendering/raytracing/shapes3D/triangle_3d.h>
+
+
+using TRACE_DURATION = std::chrono::microseconds;
+
+
+/**
+ * Fill \a aContainer with a grid of board tiles, vias and tracks, spanning -4..4 as the
+ * board does in the 3D viewer.
+ */
+static void buildScene( CONTAINER_3D& aContainer, const BOARD_ITEM& aItem, int aGridSize )
+{
+    const float cell = 8.0f / aGridSize;
+    const float zTop = 0.05f;
+
+    for( int y = 0; y < aGridSize; ++y )
+    {
+        for( int x = 0; x < aGridSize; ++x )
+        {
+            const float x0 = -4.0f + x * cell;
+            const float y0 = -4.0f + y * cell;
+            const float x1 = x0 + cell;
+            const float y1 = y0 + cell;
+
+            aContainer.Add( new TRIANGLE( SFVEC3F( x0, y0, 0.0f ), SFVEC3F( x1, y0, 0.0f ),
+                                          SFVEC3F( x1, y1, 0.0f ) ) );
+            aContainer.Add( new TRIANGLE( SFVEC3F( x0, y0, 0.0f ), SFVEC3F( x1, y1, 0.0f ),
+                                          SFVEC3F( x0, y1, 0.0f ) ) );
+
+            aContainer.Add( new CYLINDER( SFVEC2F( x0 + cell * 0.25f, y0 + cell * 0.25f ),
+                                          -zTop, zTop, cell * 0.1f ) );
+
+            ROUND_SEGMENT_2D track( SFVEC2F( x0 + cell * 0.4f, y0 + cell * 0.5f ),
+                                    SFVEC2F( x1 - cell * 0.1f, y0 + cell * 0.8f ), cell * 0.1f,
+                                    aItem );
+
+            aContainer.Add( new ROUND_SEGMENT( track, 0.0f, zTop ) );
+        }
+    }
+}
+
+
+/**
+ * Trace the packets covering the camera window, reporting the time taken.
+ *
+ * @return the number of rays that hit the scene.
+ */
+static long traceWindow( const ACCELERATOR_3D& aAccelerator, const CAMERA& aCamera,
+                         const wxSize& aSize, TRACE_DURATION& aDuration )
+{
+    HITINFO_PACKET hitPacket[RAYPACKET_RAYS_PER_PACKET];
+    long           hits = 0;
+    PROF_TIMER     timer;
+
+    for( int y = 0; y < aSize.y; y += RAYPACKET_DIM )
+    {
+        for( int x = 0; x < aSize.x; x += RAYPACKET_DIM )
+        {
+            const RAYPACKET packet( aCamera, SFVEC2I( x, y ) );
+
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                hitPacket[i].m_HitInfo.m_tHit = std::numeric_limits<float>::infinity();
+                hitPacket[i].m_HitInfo.m_acc_node_info = 0;
+                hitPacket[i].m_hitresult = false;
+            }
+
+            aAccelerator.Intersect( packet, hitPacket );
+
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+                hits += hitPacket[i].m_hitresult ? 1 : 0;
+        }
+    }
+
+    aDuration = timer.SinceStart<TRACE_DURATION>();
+
+    return hits;
+}
+
+
+static void benchmarkTrace( int aGridSize, int aIterations, bool aVerbose )
+{
+    BOARD        board;
+    PCB_TRACK    track( &board );
+    CONTAINER_3D container;
+
+    buildScene( container, track, aGridSize );
+
+    BVH_PBRT   bvh( container );
+    TRACK_BALL camera( 2 * 8.0f );
+    wxSize     size( 1024, 768 );
+
+    // Look at the board at an angle so the rays also hit the sides of the objects
+    camera.RotateX( -0.5f );
+    camera.SetCurWindowSize( size );
+
+    const long rays = (long) size.x * size.y;
+
+    std::cout << container.GetList().size() << " objects, " << rays << " rays per frame"
+              << std::endl;
+
+    for( RAYPACKET_SIMD simd : { RAYPACKET_SIMD::NONE, RAYPACKET_SIMD::SSE2,
+                                 RAYPACKET_SIMD::AVX2 } )
+    {
+        if( RAYPACKET_SetSimd( simd ) != simd )
+        {
+            std::cout << RAYPACKET_SimdName( simd ) << ": not available" << std::endl;
+            continue;
+        }
+
+        TRACE_DURATION best = TRACE_DURATION::max();
+        long           hits = 0;
+
+        for( int i = 0; i < aIterations; ++i )
+        {
+            TRACE_DURATION duration;
+
+            hits = traceWindow( bvh, camera, size, duration );
+            best = std::min( best, duration );
+
+            if( aVerbose )
+                std::cout << "Frame " << i << " took: " << duration.count() << "us" << std::endl;
+        }
+
+        const double seconds = std::max<double>( best.count(), 1 ) * 1e-6;
+
+        std::cout << RAYPACKET_SimdName( simd ) << ": best " << best.count() << "us, "
+                  << (long) ( rays / seconds ) << " rays/s, " << hits << " hits" << std::endl;
+    }
+
+    RAYPACKET_SetSimd( RAYPACKET_GetBestSimd() );
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "v", "verbose", _( "print timing of each frame" ).mb_str() },
+    { wxCMD_LINE_OPTION, "n", "iterations", _( "number of frames per level (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "g", "grid", _( "scene grid size (default 64)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_NONE }
+};
+
+
+int raytrace_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program traces a synthetic board scene with the ray "
+                               "packet kernels of each instruction set and times it." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long iterations = 5;
+    long gridSize = 64;
+
+    cl_parser.Found( "iterations", &iterations );
+    cl_parser.Found( "grid", &gridSize );
+
+    if( iterations < 1 || gridSize < 1 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    benchmarkTrace( (int) gridSize, (int) iterations, cl_parser.Found( "verbose" ) );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "raytrace_bench",
+                                                       "Benchmark the 3D raytracer packet kernels",
+                                                       raytrace_bench_main_func } );
@@ -27,6 +27,8 @@
 
 #include <pcbnew_utils/board_test_utils.h>
 
+#include <profile.h>
+
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
@@ -91,6 +93,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
     createRouter();
 
     m_router->LoadSettings( aLog->GetRoutingSettings() );
+    m_router->SetMode( aLog->GetMode() );
+    m_eventStats.clear();
 
     int eventIdx = 0;
     int totalEvents = aLog->Events().size();
@@ -105,6 +109,9 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
         eventIdx++;
 
+        const PNS::STATS statsBefore = PNS::Stats();
+        PROF_TIMER       timer;
+
         switch( evt.type )
         {
         case LOGGER::EVT_START_ROUTE:
@@ -177,6 +184,10 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
         default: break;
         }
 
+        timer.Stop();
+        m_eventStats.push_back( { evt.type, timer.msecs() * 1000.0,
+                                  PNS::Stats() - statsBefore } );
+
         PNS::NODE* node = nullptr;
 
 #if 0
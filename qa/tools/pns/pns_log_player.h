@@ -29,6 +29,7 @@
 #include <router/pns_routing_settings.h>
 #include <router/pns_kicad_iface.h>
 #include <router/pns_router.h>
+#include <router/pns_stats.h>
 
 
 class PNS_TEST_DEBUG_DECORATOR;
@@ -79,6 +80,14 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    /// Time taken and work done by the router to process one event of the log
+    struct EVENT_STATS
+    {
+        PNS::LOGGER::EVENT_TYPE m_type;
+        double                  m_timeUs;
+        PNS::STATS              m_counters;
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -94,6 +103,8 @@ public:
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
+    const std::vector<EVENT_STATS>& GetEventStats() const { return m_eventStats; }
+
 private:
     void createRouter();
 
@@ -104,6 +115,7 @@ private:
     std::unique_ptr<PNS::ROUTER>          m_router;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    std::vector<EVENT_STATS>              m_eventStats;
 };
 
 #endif
@@ -0,0 +1,410 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2022 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Router performance regression suite.
+ *
+ * Replays the recorded routing sessions listed in pns_regressions/tests.lst and compares the
+ * work done by the router with the reference stored next to each log, in a "pns.perf" file.
+ * The collision query, branch and optimizer counters are deterministic, so they must not grow
+ * by more than --counter-tolerance.  The event latencies depend on the machine, so they are
+ * only reported, unless --time-tolerance is given to check them as well.
+ *
+ * A session without a reference fails.  Run with "-- --update-baseline" to (re)write the
+ * references from the current code.
+ */
+
+#define BOOST_TEST_NO_MAIN
+
+#include <algorithm>
+#include <map>
+
+#include <wx/textfile.h>
+#include <wx/tokenzr.h>
+
+#include <pcbnew_utils/board_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+#include <boost/test/included/unit_test.hpp>
+
+using namespace boost::unit_test;
+
+
+/// Summary of a replayed session, as stored in the reference files.
+struct PNS_PERF_RESULT
+{
+    double   m_p50Us = 0.0;
+    double   m_p95Us = 0.0;
+    double   m_maxUs = 0.0;
+    uint64_t m_collisionQueries = 0;
+    uint64_t m_branches = 0;
+    uint64_t m_optimizerIterations = 0;
+    uint64_t m_clearanceQueries = 0;
+    uint64_t m_clearanceHits = 0;
+
+    bool Load( const wxString& aFileName );
+    bool Save( const wxString& aFileName ) const;
+};
+
+
+struct PNS_PERF_OPTIONS
+{
+    bool   m_updateBaseline = false;
+    double m_counterTolerance = 0.05;    ///< allowed relative growth of the counters
+    bool   m_checkTimes = false;         ///< fail on latency regressions too
+    double m_timeTolerance = 1.0;        ///< allowed relative growth of the latencies
+    int    m_repeat = 3;                 ///< replays per session, the fastest one is kept
+};
+
+
+static PNS_PERF_OPTIONS s_options;
+
+
+static const char* eventName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE: return "route-start";
+    case PNS::LOGGER::EVT_START_DRAG:  return "drag-start";
+    case PNS::LOGGER::EVT_FIX:         return "fix";
+    case PNS::LOGGER::EVT_MOVE:        return "move";
+    case PNS::LOGGER::EVT_ABORT:       return "abort";
+    case PNS::LOGGER::EVT_TOGGLE_VIA:  return "toggle-via";
+    default:                           return "unknown";
+    }
+}
+
+
+/**
+ * @return the \a aFraction percentile of \a aValues, which must be sorted.
+ */
+static double percentile( const std::vector<double>& aValues, double aFraction )
+{
+    if( aValues.empty() )
+        return 0.0;
+
+    size_t idx = (size_t) ( aFraction * ( aValues.size() - 1 ) + 0.5 );
+
+    return aValues[ std::min( idx, aValues.size() - 1 ) ];
+}
+
+
+bool PNS_PERF_RESULT::Load( const wxString& aFileName )
+{
+    wxTextFile fp( aFileName );
+
+    if( !wxFileExists( aFileName ) || !fp.Open() )
+        return false;
+
+    for( size_t i = 0; i < fp.GetLineCount(); i++ )
+    {
+        wxStringTokenizer tokens( fp.GetLine( i ) );
+        wxString          key = tokens.GetNextToken();
+        wxString          value = tokens.GetNextToken();
+
+        if( key == wxT( "p50_us" ) )
+            value.ToCDouble( &m_p50Us );
+        else if( key == wxT( "p95_us" ) )
+            value.ToCDouble( &m_p95Us );
+        else if( key == wxT( "max_us" ) )
+            value.ToCDouble( &m_maxUs );
+        else if( key == wxT( "collision_queries" ) )
+            m_collisionQueries = wxAtol( value );
+        else if( key == wxT( "branches" ) )
+            m_branches = wxAtol( value );
+        else if( key == wxT( "optimizer_iterations" ) )
+            m_optimizerIterations = wxAtol( value );
+    }
+
+    return true;
+}
+
+
+bool PNS_PERF_RESULT::Save( const wxString& aFileName ) const
+{
+    wxTextFile fp( aFileName );
+
+    if( !( wxFileExists( aFileName ) ? fp.Open() : fp.Create() ) )
+        return false;
+
+    fp.Clear();
+    fp.AddLine( wxString::FromCDouble( m_p50Us, 1 ).Prepend( wxT( "p50_us " ) ) );
+    fp.AddLine( wxString::FromCDouble( m_p95Us, 1 ).Prepend( wxT( "p95_us " ) ) );
+    fp.AddLine( wxString::FromCDouble( m_maxUs, 1 ).Prepend( wxT( "max_us " ) ) );
+    fp.AddLine( wxString::Format( wxT( "collision_queries %llu" ),
+                                  (unsigned long long) m_collisionQueries ) );
+    fp.AddLine( wxString::Format( wxT( "branches %llu" ), (unsigned long long) m_branches ) );
+    fp.AddLine( wxString::Format( wxT( "optimizer_iterations %llu" ),
+                                  (unsigned long long) m_optimizerIterations ) );
+
+    return fp.Write();
+}
+
+
+struct PNS_PERF_CASE
+{
+    PNS_PERF_CASE( const std::string& aName, const std::string& aPath ) :
+            m_name( aName ),
+            m_dataPath( aPath )
+    {}
+
+    std::string m_name;
+    std::string m_dataPath;    ///< path of the session files, without extension
+};
+
+
+class PNS_PERF_FIXTURE
+{
+public:
+    static void RunTest( PNS_PERF_CASE* aTestData )
+    {
+        PNS_LOG_FILE logFile;
+
+        if( !m_log )
+            m_log = new KI_TEST::CONSOLE_LOG;
+
+        if( !m_reporter )
+            m_reporter = new KI_TEST::CONSOLE_MSG_REPORTER( m_log );
+
+        if( !logFile.Load( wxString( aTestData->m_dataPath ), m_reporter ) )
+        {
+            BOOST_TEST_FAIL( "failed to load session '" + aTestData->m_name + "'" );
+            return;
+        }
+
+        std::vector<PNS_LOG_PLAYER::EVENT_STATS> stats;
+
+        // Keep the fastest replay of each event to filter out the noise of the machine. The
+        // counters are the same for each replay.
+        for( int i = 0; i < s_options.m_repeat; i++ )
+        {
+            PNS_LOG_PLAYER player;
+
+            player.ReplayLog( &logFile, 0 );
+
+            const std::vector<PNS_LOG_PLAYER::EVENT_STATS>& replay = player.GetEventStats();
+
+            if( stats.empty() )
+            {
+                stats = replay;
+                continue;
+            }
+
+            for( size_t n = 0; n < std::min( stats.size(), replay.size() ); n++ )
+                stats[n].m_timeUs = std::min( stats[n].m_timeUs, replay[n].m_timeUs );
+        }
+
+        PNS_PERF_RESULT result = summarize( stats );
+        wxString        baselineFile = wxString( aTestData->m_dataPath ) + wxT( ".perf" );
+
+        if( s_options.m_updateBaseline )
+        {
+            if( !result.Save( baselineFile ) )
+                BOOST_TEST_FAIL( "failed to write " + baselineFile.ToStdString() );
+
+            return;
+        }
+
+        PNS_PERF_RESULT baseline;
+
+        if( !baseline.Load( baselineFile ) )
+        {
+            BOOST_TEST_FAIL( "no reference for '" + aTestData->m_name
+                             + "', run with -- --update-baseline to create it" );
+            return;
+        }
+
+        checkCounter( "collision queries", result.m_collisionQueries,
+                      baseline.m_collisionQueries );
+        checkCounter( "branches", result.m_branches, baseline.m_branches );
+        checkCounter( "optimizer iterations", result.m_optimizerIterations,
+                      baseline.m_optimizerIterations );
+        BOOST_TEST_MESSAGE( wxString::Format( "  reference p50 %.1fus, p95 %.1fus",
+                                              baseline.m_p50Us, baseline.m_p95Us )
+                                    .ToStdString() );
+
+        if( s_options.m_checkTimes )
+        {
+            checkTime( "p50 latency", result.m_p50Us, baseline.m_p50Us );
+            checkTime( "p95 latency", result.m_p95Us, baseline.m_p95Us );
+        }
+    }
+
+    static KI_TEST::CONSOLE_LOG*          m_log;
+    static KI_TEST::CONSOLE_MSG_REPORTER* m_reporter;
+
+private:
+    static PNS_PERF_RESULT summarize( const std::vector<PNS_LOG_PLAYER::EVENT_STATS>& aStats )
+    {
+        PNS_PERF_RESULT                            result;
+        std::vector<double>                        times;
+        std::map<std::string, std::vector<double>> timesByType;
+
+        for( const PNS_LOG_PLAYER::EVENT_STATS& evt : aStats )
+        {
+            times.push_back( evt.m_timeUs );
+            timesByType[ eventName( evt.m_type ) ].push_back( evt.m_timeUs );
+
+            result.m_collisionQueries += evt.m_counters.m_collisionQueries;
+            result.m_branches += evt.m_counters.m_branches;
+            result.m_optimizerIterations += evt.m_counters.m_optimizerIterations;
+            result.m_clearanceQueries += evt.m_counters.m_clearanceQueries;
+            result.m_clearanceHits += evt.m_counters.m_clearanceItemHits
+                                      + evt.m_counters.m_clearanceRuleHits;
+        }
+
+        std::sort( times.begin(), times.end() );
+
+        result.m_p50Us = percentile( times, 0.5 );
+        result.m_p95Us = percentile( times, 0.95 );
+        result.m_maxUs = times.empty() ? 0.0 : times.back();
+
+        for( std::pair<const std::string, std::vector<double>>& entry : timesByType )
+        {
+            std::sort( entry.second.begin(), entry.second.end() );
+
+            BOOST_TEST_MESSAGE( wxString::Format( "  %-12s %5d events, p50 %8.1fus, p95 %8.1fus, "
+                                                  "p99 %8.1fus",
+                                                  entry.first.c_str(),
+                                                  (int) entry.second.size(),
+                                                  percentile( entry.second, 0.5 ),
+                                                  percentile( entry.second, 0.95 ),
+                                                  percentile( entry.second, 0.99 ) )
+                                        .ToStdString() );
+        }
+
+        BOOST_TEST_MESSAGE( wxString::Format( "  %llu collision queries, %llu branches, "
+                                              "%llu optimizer iterations",
+                                              (unsigned long long) result.m_collisionQueries,
+                                              (unsigned long long) result.m_branches,
+                                              (unsigned long long) result.m_optimizerIterations )
+                                    .ToStdString() );
+
+        BOOST_TEST_MESSAGE( wxString::Format( "  %llu clearance queries, %.1f%% cache hits",
+                                              (unsigned long long) result.m_clearanceQueries,
+                                              100.0 * result.m_clearanceHits
+                                                      / std::max<uint64_t>( 1,
+                                                              result.m_clearanceQueries ) )
+                                    .ToStdString() );
+
+        return result;
+    }
+
+    static void checkCounter( const std::string& aName, uint64_t aValue, uint64_t aBaseline )
+    {
+        BOOST_CHECK_MESSAGE( aValue <= aBaseline * ( 1.0 + s_options.m_counterTolerance ),
+                             aName << " regressed: " << aValue << " vs " << aBaseline );
+    }
+
+    static void checkTime( const std::string& aName, double aValue, double aBaseline )
+    {
+        BOOST_CHECK_MESSAGE( aValue <= aBaseline * ( 1.0 + s_options.m_timeTolerance ),
+                             aName << " regressed: " << aValue << "us vs " << aBaseline << "us" );
+    }
+};
+
+KI_TEST::CONSOLE_LOG*          PNS_PERF_FIXTURE::m_log = nullptr;
+KI_TEST::CONSOLE_MSG_REPORTER* PNS_PERF_FIXTURE::m_reporter = nullptr;
+
+
+static std::vector<PNS_PERF_CASE*> createTestCases()
+{
+    std::string absPath = KI_TEST::GetPcbnewTestDataDir() + std::string( "/pns_regressions/" );
+    std::vector<PNS_PERF_CASE*> testCases;
+
+    wxFileName fnameList( absPath + "tests.lst" );
+    wxTextFile fp( fnameList.GetFullPath() );
+
+    if( !fp.Open() )
+    {
+        wxString str =
+                wxString::Format( "Failed to load test list from '%s'.", fnameList.GetFullPath() );
+        BOOST_TEST_ERROR( str.c_str().AsChar() );
+        return testCases;
+    }
+
+    for( size_t i = 0; i < fp.GetLineCount(); i++ )
+    {
+        wxString line = fp.GetLine( i );
+
+        line.Trim().Trim( false );
+
+        if( line.IsEmpty() )
+            continue;
+
+        wxString fn( absPath );
+        fn = fn.Append( line );
+        fn = fn.Append( wxT( "/pns" ) );
+
+        testCases.push_back( new PNS_PERF_CASE( line.ToStdString(), fn.ToStdString() ) );
+    }
+
+    fp.Close();
+
+    return testCases;
+}
+
+
+static void parseOptions( int argc, char* argv[] )
+{
+    for( int i = 1; i < argc; i++ )
+    {
+        wxString arg( argv[i] );
+        wxString value;
+
+        if( arg == wxT( "--update-baseline" ) )
+            s_options.m_updateBaseline = true;
+        else if( arg.StartsWith( wxT( "--counter-tolerance=" ), &value ) )
+            value.ToCDouble( &s_options.m_counterTolerance );
+        else if( arg.StartsWith( wxT( "--time-tolerance=" ), &value ) )
+            s_options.m_checkTimes = value.ToCDouble( &s_options.m_timeTolerance );
+        else if( arg.StartsWith( wxT( "--repeat=" ), &value ) )
+            s_options.m_repeat = std::max( 1, wxAtoi( value ) );
+    }
+}
+
+
+static test_suite* init_pns_perf_suite( int argc, char* argv[] )
+{
+    test_suite* perfTestSuite = BOOST_TEST_SUITE( "pns_perf" );
+
+    parseOptions( argc, argv );
+
+    for( PNS_PERF_CASE* c : createTestCases() )
+    {
+        perfTestSuite->add( BOOST_TEST_CASE_NAME( std::bind( &PNS_PERF_FIXTURE::RunTest, c ),
+                                                  c->m_name ) );
+    }
+
+    framework::master_test_suite().add( perfTestSuite );
+    return 0;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    return unit_test_main( init_pns_perf_suite, argc, argv );
+}
@@ -304,4 +304,45 @@ BOOST_AUTO_TEST_CASE( ReadProperties )
     }
 }
 
+
+/**
+ * Test consecutive records of a stream, which share their keys
+ */
+BOOST_AUTO_TEST_CASE( ReadPropertiesRecords )
+{
+    const std::string records[] = { "|Name=A|%UTF8%Text=\xc2\xa6|LAYER=TOP",
+                                    "|NAME=B|Layer=BOTTOM" };
+
+    std::string stream;
+
+    for( const std::string& record : records )
+    {
+        // Length, including the null byte ending the record
+        stream.push_back( static_cast<char>( record.size() + 1 ) );
+        stream.append( 3, '\0' );
+        stream.append( record );
+        stream.push_back( '\0' );
+    }
+
+    std::unique_ptr<char[]> content = std::make_unique<char[]>( stream.size() );
+    std::memcpy( content.get(), stream.data(), stream.size() );
+
+    ALTIUM_PARSER parser( content, stream.size() );
+
+    std::map<wxString, wxString> first = parser.ReadProperties();
+    std::map<wxString, wxString> second = parser.ReadProperties();
+
+    BOOST_CHECK_EQUAL( parser.HasParsingError(), false );
+    BOOST_CHECK_EQUAL( parser.GetRemainingBytes(), 0 );
+
+    BOOST_CHECK_EQUAL( ALTIUM_PARSER::ReadString( first, "NAME", "" ), "A" );
+    BOOST_CHECK_EQUAL( ALTIUM_PARSER::ReadString( first, "LAYER", "" ), "TOP" );
+    BOOST_CHECK_EQUAL( ALTIUM_PARSER::ReadString( first, "TEXT", "" ),
+                       wxString( "\xc2\xa6", wxConvUTF8 ) );
+
+    BOOST_CHECK_EQUAL( second.size(), 2u );
+    BOOST_CHECK_EQUAL( ALTIUM_PARSER::ReadString( second, "NAME", "" ), "B" );
+    BOOST_CHECK_EQUAL( ALTIUM_PARSER::ReadString( second, "LAYER", "" ), "BOTTOM" );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
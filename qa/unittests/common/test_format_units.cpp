@@ -27,8 +27,12 @@
 #include <eda_units.h>
 #include <locale_io.h>
 
+#include <fmt/core.h>
+
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <random>
 
 struct UnitFixture
 {
@@ -84,4 +88,56 @@ BOOST_AUTO_TEST_CASE( wxPointUnitFormat )
 }
 
 
+/**
+ * Reference implementation of the floating point formatting historically used for file output.
+ */
+static std::string referenceFormat( const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    double      engUnits = aValue / aIuScale.IU_PER_MM;
+    std::string buf;
+
+    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+    {
+        buf = fmt::format( "{:.10f}", engUnits );
+
+        while( !buf.empty() && buf[buf.size() - 1] == '0' )
+            buf.pop_back();
+    }
+    else
+    {
+        buf = fmt::format( "{:.10g}", engUnits );
+    }
+
+    return buf;
+}
+
+
+/**
+ * Check the integer based formatter gives exactly the same output as the old formatting
+ */
+BOOST_AUTO_TEST_CASE( FormatMatchesReference )
+{
+    std::mt19937 rng( 42 );
+
+    for( const EDA_IU_SCALE* iuScale : { &pcbIUScale, &schIUScale, &gerbIUScale, &drawSheetIUScale } )
+    {
+        std::vector<int> values = { 0, 1, -1, 10, -10, 100, 999, 1000, 1001, 99999, 100000,
+                                    std::numeric_limits<int>::min(),
+                                    std::numeric_limits<int>::max() };
+
+        for( int i = 0; i < 10000; ++i )
+            values.push_back( static_cast<int>( rng() ) );
+
+        for( int value : values )
+        {
+            BOOST_TEST_CONTEXT( "Value: " << value << ", IU per mm: " << iuScale->IU_PER_MM )
+            {
+                BOOST_CHECK_EQUAL( EDA_UNIT_UTILS::FormatInternalUnits( *iuScale, value ),
+                                   referenceFormat( *iuScale, value ) );
+            }
+        }
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
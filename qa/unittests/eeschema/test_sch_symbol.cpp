@@ -31,6 +31,9 @@
 // Code under test
 #include <sch_symbol.h>
 
+#include <lib_pin.h>
+#include <sch_pin.h>
+
 #include <sch_edit_frame.h>
 
 class TEST_SCH_SYMBOL_FIXTURE
@@ -77,4 +80,32 @@ BOOST_AUTO_TEST_CASE( Orientation )
 }
 
 
+/**
+ * Check that copies of a symbol share its library symbol but have their own pins.
+ */
+BOOST_AUTO_TEST_CASE( SharedLibSymbol )
+{
+    std::shared_ptr<LIB_SYMBOL> libSymbol = std::make_shared<LIB_SYMBOL>( "part", nullptr );
+    LIB_PIN*                    libPin = new LIB_PIN( libSymbol.get() );
+
+    libPin->SetNumber( "1" );
+    libSymbol->AddDrawItem( libPin );
+
+    m_symbol.SetSharedLibSymbol( libSymbol );
+
+    SCH_SYMBOL copy( m_symbol );
+
+    BOOST_CHECK_EQUAL( copy.GetLibSymbolRef().get(), libSymbol.get() );
+    BOOST_CHECK_EQUAL( m_symbol.GetRawPins().size(), 1u );
+    BOOST_CHECK_EQUAL( copy.GetRawPins().size(), 1u );
+    BOOST_CHECK( copy.GetRawPins()[0].get() != m_symbol.GetRawPins()[0].get() );
+    BOOST_CHECK_EQUAL( copy.GetRawPins()[0]->GetLibPin(), libPin );
+
+    // Releasing the symbols keeps the library symbol alive for the other users
+    m_symbol.SetLibSymbol( nullptr );
+
+    BOOST_CHECK_EQUAL( libSymbol.use_count(), 2 );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
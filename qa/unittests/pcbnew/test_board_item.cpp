@@ -45,6 +45,7 @@
 #include <pcb_target.h>
 #include <netinfo.h>
 #include <pcb_group.h>
+#include <geometry/shape_circle.h>
 
 class TEST_BOARD_ITEM_FIXTURE
 {
@@ -374,4 +375,99 @@ BOOST_AUTO_TEST_CASE( FlipUpDown )
 }
 
 
+/**
+ * Check that the effective shapes of tracks and vias are reused until their geometry changes.
+ */
+BOOST_AUTO_TEST_CASE( TrackEffectiveShapeCache )
+{
+    PCB_TRACK track( &m_board );
+
+    track.SetStart( VECTOR2I( 0, 0 ) );
+    track.SetEnd( VECTOR2I( 1000, 0 ) );
+
+    std::shared_ptr<SHAPE> shape = track.GetEffectiveShape();
+
+    BOOST_CHECK_EQUAL( track.GetEffectiveShape().get(), shape.get() );
+
+    track.Move( VECTOR2I( 0, 500 ) );
+
+    std::shared_ptr<SHAPE> movedShape = track.GetEffectiveShape();
+
+    BOOST_CHECK_NE( movedShape.get(), shape.get() );
+    BOOST_CHECK_EQUAL( shape->Centre(), VECTOR2I( 500, 0 ) );
+    BOOST_CHECK_EQUAL( movedShape->Centre(), VECTOR2I( 500, 500 ) );
+
+    PCB_VIA via( &m_board );
+
+    via.SetWidth( 600 );
+    via.SetDrill( 300 );
+
+    std::shared_ptr<SHAPE> flashed = via.GetEffectiveShape( F_Cu, FLASHING::ALWAYS_FLASHED );
+    std::shared_ptr<SHAPE> drill = via.GetEffectiveShape( F_Cu, FLASHING::NEVER_FLASHED );
+
+    BOOST_CHECK_EQUAL( static_cast<SHAPE_CIRCLE*>( flashed.get() )->GetRadius(), 300 );
+    BOOST_CHECK_EQUAL( static_cast<SHAPE_CIRCLE*>( drill.get() )->GetRadius(), 150 );
+    BOOST_CHECK_EQUAL( via.GetEffectiveShape( F_Cu, FLASHING::NEVER_FLASHED ).get(),
+                       drill.get() );
+
+    via.SetDrill( 400 );
+
+    drill = via.GetEffectiveShape( F_Cu, FLASHING::NEVER_FLASHED );
+
+    BOOST_CHECK_EQUAL( static_cast<SHAPE_CIRCLE*>( drill.get() )->GetRadius(), 200 );
+    BOOST_CHECK_EQUAL( via.GetEffectiveShape( F_Cu, FLASHING::ALWAYS_FLASHED ).get(),
+                       flashed.get() );
+}
+
+
+/**
+ * Check that the simplified zone fills stay close to the fill and follow its changes.
+ */
+BOOST_AUTO_TEST_CASE( ZoneDisplayFill )
+{
+    ZONE             zone( &m_board );
+    SHAPE_LINE_CHAIN circle;
+    const int        radius = pcbIUScale.mmToIU( 10 );
+    const int        maxError = pcbIUScale.mmToIU( 0.1 );
+
+    for( int ii = 0; ii < 2000; ++ii )
+    {
+        double angle = 2 * M_PI * ii / 2000;
+        circle.Append( KiROUND( radius * cos( angle ) ), KiROUND( radius * sin( angle ) ) );
+    }
+
+    circle.SetClosed( true );
+
+    SHAPE_POLY_SET fill;
+    fill.AddOutline( circle );
+
+    zone.SetLayer( F_Cu );
+    zone.SetFilledPolysList( F_Cu, fill );
+    zone.CacheTriangulation( F_Cu );
+
+    const std::shared_ptr<SHAPE_POLY_SET>& exact = zone.GetFilledPolysList( F_Cu );
+
+    BOOST_CHECK_EQUAL( ZONE::GetDisplayFillLevel( 0 ), 0 );
+    BOOST_CHECK_EQUAL( ZONE::GetDisplayFillLevel( maxError ), 2 );
+    BOOST_CHECK_EQUAL( zone.GetDisplayFill( F_Cu, 0 ).get(), exact.get() );
+
+    std::shared_ptr<SHAPE_POLY_SET> simplified = zone.GetDisplayFill( F_Cu, maxError );
+
+    BOOST_REQUIRE_EQUAL( simplified->OutlineCount(), 1 );
+    BOOST_CHECK_LT( simplified->FullPointCount(), exact->FullPointCount() / 4 );
+    BOOST_CHECK_EQUAL( zone.GetDisplayFill( F_Cu, maxError ).get(), simplified.get() );
+
+    for( const VECTOR2I& pt : circle.CPoints() )
+        BOOST_CHECK_LE( simplified->COutline( 0 ).Distance( pt, true ), maxError );
+
+    zone.Move( VECTOR2I( radius, 0 ) );
+
+    std::shared_ptr<SHAPE_POLY_SET> moved = zone.GetDisplayFill( F_Cu, maxError );
+
+    BOOST_CHECK_NE( moved.get(), simplified.get() );
+    BOOST_CHECK_EQUAL( moved->BBox().GetCenter(), simplified->BBox().GetCenter()
+                                                          + VECTOR2I( radius, 0 ) );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()